@@ -0,0 +1,49 @@
+// analysis/CsvTable.h
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace analysis {
+
+// Numeric CSV loaded column-major, the way the MATLAB scripts use readtable().
+//
+// The whole file is read in one go and split into one slice per worker at
+// line boundaries. Each worker finds line ends with memchr (vectorised in the
+// C runtimes we build against) and parses fields in place with
+// std::from_chars, so there are no per-line strings or streams. Every value
+// is held as a double: ns timestamps stay exact up to 2^53 ns (~104 days).
+// Empty or non-numeric fields become NaN, like str2double.
+class CsvTable {
+public:
+    // Load path. threads = 0 uses std::thread::hardware_concurrency().
+    bool load(const std::string& path, unsigned threads = 0);
+
+    std::size_t rows() const { return rows_; }
+    const std::vector<std::string>& names() const { return names_; }
+
+    bool has(const char* name) const { return find(name) != nullptr; }
+
+    // Column by header name, or nullptr if the file doesn't have it
+    const std::vector<double>* find(const char* name) const;
+
+    // Column by header name. A missing column is reported and reads as all
+    // NaN, so a report on an older log still runs.
+    const std::vector<double>& col(const char* name) const;
+
+    // Keep only the rows where keep[i] is true
+    void filter(const std::vector<bool>& keep);
+
+    const std::string& path() const { return path_; }
+
+private:
+    std::string                      path_;
+    std::vector<std::string>         names_;
+    std::vector<std::vector<double>> cols_;
+    std::size_t                      rows_ = 0;
+
+    std::vector<double>              missing_; ///< all-NaN stand-in for absent columns
+};
+
+} // namespace analysis
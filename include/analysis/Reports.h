@@ -0,0 +1,52 @@
+// analysis/Reports.h
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "analysis/CsvTable.h"
+
+namespace analysis {
+
+// Native ports of the MATLAB validation scripts in Test Data/. Each report
+// prints what its script printed to `out`, writes the same summary files into
+// outDir, and returns false only if its inputs are unusable. Reports share no
+// state, so main_analyze.cpp runs them on separate threads.
+
+// End_to_End.m: matched-cycle latency and raw state-stream timing.
+// Writes device_timing_summary.csv, device_state_summary.csv and
+// latency_cdf.csv (percentile table of each latency, 0.1 % steps).
+bool timingReport(const CsvTable& timing, const CsvTable& state,
+                  const std::string& outDir, std::ostream& out);
+
+struct SafetyConfig {
+    double ignoreStartS     = 0.0;
+    double torqueCapNm      = 6.5;   ///< firmware torque cap
+    double slewLimitNmPerS  = 55.0;  ///< firmware torque slew limit
+    double minSlewDtS       = 1e-5;  ///< shorter sample gaps are skipped for slew
+    std::size_t slewBins    = 80;
+};
+
+// device_safety_validation_analysis.m: saturation, slew limiting, watchdog.
+// Writes results_combined_summary.txt and slew_histogram.csv.
+bool safetyReport(CsvTable host, CsvTable device, const SafetyConfig& cfg,
+                  const std::string& outDir, std::ostream& out);
+
+// CommAnalysis.m: serial_tests rate and RTT captures.
+// Writes rate_summary.csv, rtt_summary.csv, rate_dt_cdf.csv and rtt_cdf.csv.
+// Each file is named rate_<N>hz.csv or rtt_<N>ms.csv.
+bool commReport(const std::vector<std::string>& rateFiles, const std::vector<std::string>& rttFiles,
+                const std::string& outDir, std::ostream& out);
+
+struct SimConfig {
+    double ignoreStartS = 0.0;
+    double holdStartS   = 3.0;   ///< hold region for the force stability figures
+    double holdEndS     = 11.0;
+};
+
+// simulation_validation_analysis.m: penetration, force/penetration fit,
+// normal/tangential force split and hold-region stability. Console only.
+bool simReport(const CsvTable& sim, const SimConfig& cfg, std::ostream& out);
+
+} // namespace analysis
@@ -0,0 +1,110 @@
+// analysis/Stats.h
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace analysis {
+
+// Summary statistics with the conventions of the MATLAB scripts in Test Data/,
+// so numbers from `analyze` and from the scripts can be compared directly:
+//  - NaNs are skipped ('omitnan'); an empty input gives NaN
+//  - stddev is the sample (n - 1) standard deviation, as std() and serial_tests
+//  - percentiles follow prctile(): the i-th sorted value sits at 100 * (i - 0.5) / n,
+//    with linear interpolation between and clamping outside
+
+inline constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+inline double mean(const std::vector<double>& v) {
+    double s = 0.0;
+    std::size_t n = 0;
+    for (double x : v) {
+        if (std::isnan(x)) continue;
+        s += x;
+        ++n;
+    }
+    return n ? s / static_cast<double>(n) : kNaN;
+}
+
+inline double stddev(const std::vector<double>& v) {
+    const double m = mean(v);
+    double acc = 0.0;
+    std::size_t n = 0;
+    for (double x : v) {
+        if (std::isnan(x)) continue;
+        acc += (x - m) * (x - m);
+        ++n;
+    }
+    return n >= 2 ? std::sqrt(acc / static_cast<double>(n - 1)) : (n == 1 ? 0.0 : kNaN);
+}
+
+// Consecutive differences: out[i] = v[i + 1] - v[i]
+inline std::vector<double> diff(const std::vector<double>& v) {
+    std::vector<double> d;
+    if (v.size() < 2) return d;
+    d.resize(v.size() - 1);
+    for (std::size_t i = 0; i + 1 < v.size(); ++i)
+        d[i] = v[i + 1] - v[i];
+    return d;
+}
+
+// Sorted copy of the non-NaN values, for order statistics
+class Sorted {
+public:
+    Sorted() = default;
+
+    explicit Sorted(std::vector<double> v) : x_(std::move(v)) {
+        x_.erase(std::remove_if(x_.begin(), x_.end(), [](double d) { return std::isnan(d); }), x_.end());
+        std::sort(x_.begin(), x_.end());
+    }
+
+    // p in [0, 100]
+    double percentile(double p) const {
+        if (x_.empty()) return kNaN;
+        const double pos = p / 100.0 * static_cast<double>(x_.size()) - 0.5;
+        if (pos <= 0.0) return x_.front();
+        if (pos >= static_cast<double>(x_.size() - 1)) return x_.back();
+
+        const std::size_t i = static_cast<std::size_t>(pos);
+        const double frac = pos - static_cast<double>(i);
+        return x_[i] + (x_[i + 1] - x_[i]) * frac;
+    }
+
+    double median() const { return percentile(50.0); }
+    double min() const { return x_.empty() ? kNaN : x_.front(); }
+    double max() const { return x_.empty() ? kNaN : x_.back(); }
+
+    std::size_t size() const { return x_.size(); }
+    bool empty() const { return x_.empty(); }
+    const std::vector<double>& values() const { return x_; }
+
+private:
+    std::vector<double> x_;
+};
+
+// Equal-width histogram over [lo, hi]
+struct Histogram {
+    double lo = 0.0;
+    double width = 0.0;
+    std::vector<std::size_t> counts;
+};
+
+inline Histogram histogram(const Sorted& s, std::size_t bins) {
+    Histogram h;
+    if (s.empty() || bins == 0) return h;
+
+    h.lo = s.min();
+    const double span = s.max() - h.lo;
+    h.width = span > 0.0 ? span / static_cast<double>(bins) : 1.0;
+    h.counts.assign(bins, 0);
+    for (double x : s.values()) {
+        const std::size_t b = std::min(bins - 1, static_cast<std::size_t>((x - h.lo) / h.width));
+        ++h.counts[b];
+    }
+    return h;
+}
+
+} // namespace analysis
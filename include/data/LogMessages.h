@@ -65,6 +65,6 @@ struct SimulationValidationLogMsg {
     float normal_z = 0.0f;
 
     float penetration_depth_m = 0.0f; // ||device - proxy||
-    float signed_phi_m = 0.0f;        // SDF signed distance in world units
+    float signed_phi_m = 0.0f;        // SDF signed distance in world units; NaN beyond the contact search radius
     uint32_t contact_active = 0;      // 1 when in contact, else 0
 };
\ No newline at end of file
@@ -0,0 +1,36 @@
+// data/WorldSnapshotWire.h
+#pragma once
+#include "data/WorldSnapshot.h"
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
+// Fixed-size copy of WorldSnapshot for shared-memory transport (no heap pointers).
+// Worlds larger than kMaxWireObjects are truncated and flagged.
+constexpr uint32_t kMaxWireObjects = 256;
+
+struct WorldSnapshotWire {
+    uint64_t seq{0};
+    double   simTime{0.0};
+    uint32_t count{0};
+    uint32_t truncated{0};   // objects dropped because the world was too big
+    ObjectState objects[kMaxWireObjects];
+};
+
+static_assert(std::is_trivially_copyable<WorldSnapshotWire>::value,
+              "WorldSnapshotWire is copied byte-for-byte between processes");
+
+inline void toWire(const WorldSnapshot& s, WorldSnapshotWire& w) {
+    const std::size_t n = std::min<std::size_t>(s.objects.size(), kMaxWireObjects);
+    w.seq = s.seq;
+    w.simTime = s.simTime;
+    w.count = static_cast<uint32_t>(n);
+    w.truncated = static_cast<uint32_t>(s.objects.size() - n);
+    std::copy_n(s.objects.begin(), n, w.objects);
+}
+
+inline void fromWire(const WorldSnapshotWire& w, WorldSnapshot& s) {
+    s.seq = w.seq;
+    s.simTime = w.simTime;
+    s.objects.assign(w.objects, w.objects + std::min(w.count, kMaxWireObjects));
+}
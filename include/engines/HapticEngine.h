@@ -1,10 +1,14 @@
 // haptics/HapticEngine.h
 #pragma once
 #include "messaging/Channel.h"
+#include "messaging/SpscChannel.h"
+#include "messaging/MailboxChannel.h"
+#include "messaging/BroadcastChannel.h"
 #include "data/WorldSnapshot.h"
 #include "data/HapticMessages.h"
 #include "data/LogMessages.h"
 #include "geometry/GeometryDatabase.h"
+#include "engines/HapticScene.h"
 #include "messaging/SnapshotChannel.h"
 #include "hardware/DeviceAdapter.h"
 
@@ -33,30 +37,36 @@ class HapticEngine {
 public:
     HapticEngine(const GeometryDatabase& geomDb,
                 msg::SnapshotChannel<WorldSnapshot>& worldSnaps,
-                 msg::Channel<ToolStateMsg>& toolIn,
-                 msg::Channel<HapticSnapshotMsg>& hapticOut,
+                 msg::MailboxChannel<ToolStateMsg>& toolIn,
+                 msg::BroadcastChannel<HapticSnapshotMsg>& hapticOut,
                  msg::Channel<HapticWrenchCmd>& wrenchOut,
-                 msg::Channel<HapticWrenchCmd>& deviceCmdOut,
-                 msg::Channel<SimulationValidationLogMsg>& simLogOut);
+                 msg::MailboxChannel<HapticWrenchCmd>& deviceCmdOut,
+                 msg::SpscChannel<SimulationValidationLogMsg>& simLogOut);
 
     void run();        // 1 kHz loop
     void update(float dt);
 
+    // Objects farther than this from the tool are not queried (broad phase)
+    static constexpr double kContactSearchRadius = 0.02; // m
+
 private:
     msg::SnapshotChannel<WorldSnapshot>&      worldSnaps_;
-    msg::Channel<ToolStateMsg>&       toolIn_;
-    msg::Channel<HapticSnapshotMsg>&  hapticOut_; // To Render
-    msg::Channel<HapticWrenchCmd>&    wrenchOut_; // To Physics
-    msg::Channel<HapticWrenchCmd>&    deviceCmdOut_; // To DeviceAdapter
-    msg::Channel<SimulationValidationLogMsg>& simLogOut_;
+    msg::MailboxChannel<ToolStateMsg>&      toolIn_;
+    msg::BroadcastChannel<HapticSnapshotMsg>& hapticOut_; // To Render (fan-out)
+    msg::Channel<HapticWrenchCmd>&          wrenchOut_; // To Physics
+    msg::MailboxChannel<HapticWrenchCmd>&   deviceCmdOut_; // To DeviceAdapter
+    msg::SpscChannel<SimulationValidationLogMsg>& simLogOut_;
 
     const GeometryDatabase& geometryDb_;
 
     // cached latest inputs (so update() is deterministic)
     uint64_t worldSnapVersion_ = 0;
-    WorldSnapshot latestWorld_{};
+    uint64_t toolVersion_ = 0;
+    msg::SnapshotChannel<WorldSnapshot>::ReadHandle latestWorld_{}; // borrowed, read in place
     ToolStateMsg  latestTool_{};
 
+    HapticScene   scene_;  // prepared from latestWorld_ when its version changes
+
     Pose proxyPosePrev_{};
     Vec3 proxyVelFilt_{0.0, 0.0, 0.0};
     Vec3 toolVelFilt_{0.0, 0.0, 0.0};
@@ -0,0 +1,86 @@
+// engines/HapticScene.h
+#pragma once
+#include "data/WorldSnapshot.h"
+#include "geometry/GeometryDatabase.h"
+#include "geometry/Bvh.h"
+#include "geometry/sdf/PrimitiveBatch.h"
+#include "geometry/sdf/SDF.h"
+
+#include <cstdint>
+#include <vector>
+
+// The part of a WorldSnapshot the haptic loop touches, prepared once per
+// snapshot version (sim rate) instead of on every 1 kHz tick:
+//  - only objects that can be in contact (not Tool / Proxy, geometry has an SDF)
+//  - contiguous, with the world -> local transform already inverted and the
+//    SDF pointer resolved, so a tick never touches GeometryDatabase or quats
+//  - the search structures over them: primitive batch, BVH, unbounded list
+class HapticScene {
+public:
+    struct Object {
+        glm::dmat3 worldToLocal;  // R^T / s
+        Vec3       origin;        // T_ws.p
+        glm::dmat3 rotation;      // R, local -> world
+        double     scale;         // T_ws.s
+        const SDF* sdf;           // owned by GeometryDatabase
+        ObjectID   id;
+        Aabb       bounds;        // world space; unbounded for planes etc.
+
+        Vec3 toLocal(const Vec3& p_ws) const { return worldToLocal * (p_ws - origin); }
+        Vec3 toWorld(const Vec3& p_ls) const { return rotation * (scale * p_ls) + origin; }
+        Vec3 dirToWorld(const Vec3& v_ls) const { return rotation * v_ls; }
+    };
+
+    // Rebuild from a new snapshot. The BVH is only refit when the bounded
+    // objects are the same (and in the same order) as last time.
+    void prepare(const WorldSnapshot& world, const GeometryDatabase& geometry);
+
+    const std::vector<Object>& objects() const { return objects_; }
+    std::size_t size() const { return objects_.size(); }
+    bool empty() const { return objects_.empty(); }
+
+    // The candidate with the smallest world-space phi (the haptic engine's
+    // contact search). Exact whenever phi <= radius: anything skipped is
+    // farther. obj is null when there are no candidates.
+    struct Nearest {
+        const Object* obj = nullptr;
+        double        phi = 1e30;  // world units
+        Vec3          p_ls{0.0};   // p_ws in obj's local space
+        SDFQuery      q{};         // obj's local query at p_ls
+    };
+    Nearest nearest(const Vec3& p_ws, double radius) const;
+
+    // Calls fn(const Object&) for every object that may be nearest to p_ws
+    // within radius: the nearest batched primitive, objects whose bounds come
+    // within radius, and unbounded objects. An object may be visited twice.
+    template<typename Fn>
+    void forEachCandidate(const Vec3& p_ws, double radius, Fn&& fn) const {
+        if (!primitiveBatch_.empty()) {
+            const PrimitiveBatch::Hit hit = primitiveBatch_.nearest(p_ws);
+            if (hit.item != PrimitiveBatch::kNone)
+                fn(objects_[hit.item]);
+        }
+
+        for (uint32_t index : unboundedObjects_)
+            fn(objects_[index]);
+
+        contactBvh_.query(Aabb::around(p_ws, radius),
+                          [&](uint32_t item) { fn(objects_[bvhObjects_[item]]); });
+    }
+
+private:
+    void updateBvh();
+
+    std::vector<Object>   objects_;
+    std::vector<Pose>     poses_;            // per object, for the batch (prepare only)
+    std::vector<uint8_t>  batched_;          // per object, has an SDF::primitive (prepare only)
+
+    PrimitiveBatch        primitiveBatch_;   // spheres / cubes / planes, when there are many
+
+    Bvh                   contactBvh_;
+    std::vector<Aabb>     bvhBoxes_;         // world bounds, per BVH item
+    std::vector<uint32_t> bvhObjects_;       // BVH item -> index in objects_
+    std::vector<ObjectID> bvhIds_;           // object ids the tree was built for
+    std::vector<uint32_t> unboundedObjects_; // always queried
+    uint32_t              refitsSinceBuild_ = 0;
+};
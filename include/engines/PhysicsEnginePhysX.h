@@ -8,6 +8,7 @@
 
 // Messaging
 #include "messaging/Channel.h"
+#include "messaging/FixedBuffer.h"
 #include "data/Commands.h"          // ToolStateMsg, HapticWrenchCmd (your types)
 #include "data/HapticMessages.h"
 
@@ -87,6 +88,9 @@ private:
     // Map entity -> PhysX actor
     std::unordered_map<ObjectID, physx::PxRigidActor*> actors_;   // owned by scene; released on shutdown
 
+    // Reused every tick so draining wrenchIn_ never allocates
+    msg::FixedBuffer<HapticWrenchCmd, 64> wrenchBatch_;
+
     // Fixed-step accumulator
     double accumulator_ = 0.0;
     double fixedDt_     = 1.0 / 240.0; // 240 Hz
@@ -0,0 +1,61 @@
+// geometry/Aabb.h
+#pragma once
+#include "data/core/Math.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Axis-aligned box. Default-constructed boxes are empty (lo > hi);
+// unbounded() is for surfaces with no finite extent, such as planes.
+struct Aabb {
+    Vec3 lo{ std::numeric_limits<double>::infinity()};
+    Vec3 hi{-std::numeric_limits<double>::infinity()};
+
+    static Aabb unbounded() {
+        const double inf = std::numeric_limits<double>::infinity();
+        return {Vec3{-inf}, Vec3{inf}};
+    }
+
+    static Aabb around(const Vec3& c, double r) {
+        return {Vec3{c.x - r, c.y - r, c.z - r}, Vec3{c.x + r, c.y + r, c.z + r}};
+    }
+
+    bool isBounded() const {
+        return std::isfinite(lo.x) && std::isfinite(lo.y) && std::isfinite(lo.z) &&
+               std::isfinite(hi.x) && std::isfinite(hi.y) && std::isfinite(hi.z);
+    }
+
+    void grow(const Aabb& o) {
+        lo = {std::min(lo.x, o.lo.x), std::min(lo.y, o.lo.y), std::min(lo.z, o.lo.z)};
+        hi = {std::max(hi.x, o.hi.x), std::max(hi.y, o.hi.y), std::max(hi.z, o.hi.z)};
+    }
+
+    bool overlaps(const Aabb& o) const {
+        return lo.x <= o.hi.x && o.lo.x <= hi.x &&
+               lo.y <= o.hi.y && o.lo.y <= hi.y &&
+               lo.z <= o.hi.z && o.lo.z <= hi.z;
+    }
+
+    Vec3 center() const { return (lo + hi) * 0.5; }
+    Vec3 extent() const { return hi - lo; }
+};
+
+// World box enclosing a local box under p_ws = R * (s * p_ls) + t.
+// Conservative: the box of the rotated box, exact for axis-aligned rotations.
+inline Aabb transformAabb(const Aabb& local, const glm::dmat3& R, const Vec3& t, double s) {
+    if (!local.isBounded())
+        return local;
+
+    const Vec3 c = R * (s * local.center()) + t;
+    const Vec3 h = local.extent() * (0.5 * s);
+
+    Vec3 hw;
+    for (int i = 0; i < 3; ++i) // row i of R is (R[0][i], R[1][i], R[2][i])
+        hw[i] = std::abs(R[0][i]) * h.x + std::abs(R[1][i]) * h.y + std::abs(R[2][i]) * h.z;
+
+    return {c - hw, c + hw};
+}
+
+inline Aabb transformAabb(const Aabb& local, const Pose& T_ws) {
+    return transformAabb(local, glm::mat3_cast(T_ws.q), T_ws.p, T_ws.s);
+}
@@ -0,0 +1,60 @@
+// geometry/Bvh.h
+#pragma once
+#include "geometry/Aabb.h"
+#include <cstdint>
+#include <vector>
+
+// Bounding volume hierarchy over a list of boxes, one per item (items are
+// indices into the caller's array).
+//  - build(): median split on the longest axis, up to kLeafSize items per leaf
+//  - refit(): recompute the boxes bottom-up after items moved, keeping the tree;
+//             O(n) and allocation free, for when the item set is unchanged
+//  - query(): calls fn(item) for every item whose box overlaps the query box
+class Bvh {
+public:
+    static constexpr uint32_t kLeafSize = 4;
+
+    void build(const std::vector<Aabb>& boxes);
+    void refit(const std::vector<Aabb>& boxes);  // boxes.size() == size()
+    void clear();
+
+    std::size_t size() const { return items_.size(); }
+    bool empty() const { return items_.empty(); }
+
+    template<typename Fn>
+    void query(const Aabb& box, Fn&& fn) const {
+        if (nodes_.empty())
+            return;
+
+        uint32_t stack[64];
+        uint32_t top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const Node& n = nodes_[stack[--top]];
+            if (!n.box.overlaps(box))
+                continue;
+            if (n.count > 0) {
+                for (uint32_t i = n.first; i < n.first + n.count; ++i) {
+                    if (itemBoxes_[i].overlaps(box))
+                        fn(items_[i]);
+                }
+            } else {
+                stack[top++] = n.first;     // children are adjacent
+                stack[top++] = n.first + 1;
+            }
+        }
+    }
+
+private:
+    struct Node {
+        Aabb     box;
+        uint32_t first = 0;  // leaf: first item in items_; inner: left child (right = first + 1)
+        uint32_t count = 0;  // items in a leaf, 0 for inner nodes
+    };
+
+    void buildNode(uint32_t node, uint32_t begin, uint32_t end, const std::vector<Aabb>& boxes);
+
+    std::vector<Node>     nodes_;  // children always after their parent
+    std::vector<uint32_t> items_;
+    std::vector<Aabb>     itemBoxes_; // boxes of items_, in leaf order
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include "data/core/Ids.h"
+#include "geometry/Aabb.h"
 #include <memory>
 
 enum class SurfaceType : uint8_t {
@@ -22,6 +23,7 @@ struct GeometryEntry {
 
     // Haptics
     std::shared_ptr<const SDF> sdf;
+    Aabb localBounds = Aabb::unbounded(); // from sdf->localBounds(), set on registration
 
     // Physics
     PhysicsShapeHandle physicsShape{0};
@@ -1,20 +1,39 @@
 #pragma once
 #include "geometry/GeometryDatabase.h"
+#include "geometry/sdf/GridSDF.h"
 #include "render/RenderMeshRegistry.h"
 #include <optional>
+#include <string>
 #include <unordered_map>
 
 class GeometryFactory {
 public:
     explicit GeometryFactory(GeometryDatabase& db, RenderMeshRegistry& meshRegistry);
 
+    // Headless (no GL context): geometry gets SDFs but renderMesh stays 0.
+    // Ids still match a renderer process that calls get*() in the same order.
+    explicit GeometryFactory(GeometryDatabase& db);
+
     GeometryID getPlane();                 // infinite plane
     GeometryID getSphere();   // sphere of given radius
     GeometryID getCube(); // cube of given side length
 
+    // Triangle mesh from an .obj / .stl file. Haptics uses a GridSDF baked
+    // from it (cached in sdfCacheDir, see GridSDF::loadOrBake), or a BrickSDF
+    // paged from disk when the dense grid would exceed kMaxDenseSamples; a
+    // .bricksdf baked by sdf_bake is opened as is (touchable, not drawn).
+    // Physics has no TriMesh shape yet. Returns 0 if the file can't be
+    // loaded or baked.
+    GeometryID getMesh(const std::string& path, const GridSDFConfig& cfg = {});
+
+    // 256 MiB of floats
+    static constexpr std::size_t kMaxDenseSamples = std::size_t(1) << 26;
+
+    void setSdfCacheDir(const std::string& dir) { sdfCacheDir_ = dir; }
+
 private:
     GeometryDatabase& db_;
-    RenderMeshRegistry& meshRegistry_;
+    RenderMeshRegistry* meshRegistry_; // null when headless
 
     GeometryID nextId_{1};
 
@@ -22,8 +41,14 @@ private:
     std::optional<GeometryID> planeId_;
     std::optional<GeometryID>  sphereId_;
     std::optional<GeometryID> cubeId_;
+    std::unordered_map<std::string, GeometryID> meshIds_; // by path
+
+    std::string sdfCacheDir_ = "cache/sdf";
 
     GeometryID registerPlane();
     GeometryID registerSphere();
     GeometryID registerCube(); 
+    GeometryID registerMesh(const std::string& path, const GridSDFConfig& cfg);
+
+    RenderMeshHandle meshFor(MeshKind kind);
 };
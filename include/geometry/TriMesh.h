@@ -0,0 +1,25 @@
+// geometry/TriMesh.h
+#pragma once
+#include "data/core/Math.h"
+#include "geometry/Aabb.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Indexed triangle mesh in its own local units, as loaded from disk.
+// Haptics bakes it into a GridSDF (geometry/sdf/GridSDF.h), or a BrickSDF
+// (geometry/sdf/BrickSDF.h) when a dense grid would be too large.
+struct TriMesh {
+    std::vector<Vec3>     vertices;
+    std::vector<uint32_t> indices;   // 3 per triangle, counter-clockwise seen from outside
+
+    std::size_t triangleCount() const { return indices.size() / 3; }
+    Aabb bounds() const;
+
+    // FNV-1a over vertices and indices (keys the SDF caches)
+    uint64_t contentHash() const;
+};
+
+// Wavefront .obj (v / f; polygons are fan-triangulated) or .stl (binary or
+// ASCII; vertices welded on exact position), picked by extension.
+bool loadTriMesh(const std::string& path, TriMesh& out);
@@ -0,0 +1,169 @@
+// geometry/sdf/BrickSDF.h
+#pragma once
+#include "geometry/sdf/SDF.h"
+#include "geometry/TriMesh.h"
+#include "logging/MappedFile.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+struct BrickSDFConfig {
+    double   voxel = 0.0;     // sample spacing, mesh units; 0: longest side of the mesh bounds / 1024
+    uint32_t bandVoxels = 4;  // exact distances within this many voxels of the surface
+    uint32_t threads = 0;     // bake threads; 0: hardware_concurrency
+};
+
+struct BrickCacheConfig {
+    std::size_t residentBytes = std::size_t(64) << 20; // brick pool in RAM; 0: none, coarse values only
+    double      prefetchRadius = 0.0;  // mesh units around the last query; 0: 8 brick widths
+};
+
+// Signed distance to a closed triangle mesh too large for a dense GridSDF
+// (scans at sub-millimetre resolution, gigabytes of samples), stored sparse
+// and paged in from disk around the tool.
+//
+// Layout, VDB style:
+//  - leaf bricks of 8^3 voxels, 9^3 int16 samples each (the far faces are
+//    duplicated so interpolation never leaves a brick), only where the
+//    narrow band is; they stay in the file
+//  - internal nodes of 16^3 bricks with a child mask and an inside mask for
+//    the empty bricks, plus one coarse value per brick; all in RAM
+//  - a root hash from node coordinates to nodes, and to inside tiles for
+//    nodes that are entirely inside; anything else is outside
+//
+// Residency: bricks are only read from a fixed pool in RAM. queryLocal
+// records where it was asked; a prefetch thread reads the bricks within
+// prefetchRadius of that point into the pool (so the disk reads happen on
+// that thread), evicting the farthest when the pool is full. It reads with
+// MappedFile::read (pread / ReadFile), not through the mapping, and open()
+// drops the mapped index pages once they are copied (MappedFile::release), so
+// the resident set is the pool plus the nodes and coarse values on both
+// POSIX and Windows; the OS file cache holds recently read bricks outside it.
+// queryLocal never touches the file: a brick that is not in the pool yet is
+// answered from the coarse values (one per brick, interpolated between brick
+// centres) and counted in missedQueries().
+//
+// bake() writes the file offline (see the sdf_bake tool), node row by node
+// row with the sign carried along x from the border; openOrBake() keeps it in
+// <cacheDir>/<key>.bricksdf like GridSDF::loadOrBake.
+class BrickSDF : public SDF {
+public:
+    static bool bake(const TriMesh& mesh, const BrickSDFConfig& cfg, const std::string& path);
+
+    // Null if the file is missing or not a brick SDF
+    static std::shared_ptr<BrickSDF> open(const std::string& path, const BrickCacheConfig& cache = {});
+
+    static std::shared_ptr<BrickSDF> openOrBake(const TriMesh& mesh, const BrickSDFConfig& cfg,
+                                                const std::string& cacheDir,
+                                                const BrickCacheConfig& cache = {});
+
+    // Identifies mesh + config; the cache file name
+    static uint64_t cacheKey(const TriMesh& mesh, const BrickSDFConfig& cfg);
+    // <cacheDir>/<key>.bricksdf, where openOrBake looks
+    static std::string cachePath(const TriMesh& mesh, const BrickSDFConfig& cfg, const std::string& cacheDir);
+
+    ~BrickSDF() override;
+
+    SDFQuery queryLocal(const Vec3& p_ls) const override;
+    Aabb localBounds() const override { return meshBounds_; }
+
+    // Ask for the bricks around p_ls ahead of the first query there
+    void prefetchAround(const Vec3& p_ls) const;
+
+    uint64_t key() const { return key_; }
+    double voxel() const { return h_; }
+    double band() const { return band_; }
+    std::size_t nodeCount() const { return nodes_.size(); }
+    std::size_t brickCount() const { return brickCount_; }
+    std::size_t poolBricks() const { return slots_.size(); }
+    std::size_t residentBricks() const { return resident_.load(std::memory_order_relaxed); }
+    uint64_t missedQueries() const { return misses_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr uint32_t kNoBrick = 0xFFFFFFFFu;
+    static constexpr uint32_t kNoSlot = 0xFFFFFFFFu;
+    static constexpr uint32_t kInsideTile = 0xFFFFFFFFu;  // root_ value for a node that is all inside
+
+    struct Node {
+        uint64_t childMask[64];   // brick stored, per child (x fastest)
+        uint64_t insideMask[64];  // empty child is inside
+        uint32_t firstBrick;      // a node's bricks are consecutive, in child order
+        uint16_t prefix[64];      // children set in childMask[0 .. w)
+    };
+
+    struct Slot {
+        uint32_t brick;           // kNoBrick when free
+        uint32_t coord[3];        // brick coordinates
+    };
+
+    struct Wanted {
+        double d2;                // from the prefetch point
+        Slot   slot;
+    };
+
+    BrickSDF() = default;
+
+    // Brick index at brick coordinates, or kNoBrick with *inside set for empty space
+    uint32_t findBrick(uint32_t bx, uint32_t by, uint32_t bz, bool* inside) const;
+    double coarseAt(int64_t bx, int64_t by, int64_t bz) const;
+    SDFQuery coarseQuery(const Vec3& u) const;
+    double brickDistance2(const uint32_t coord[3], const Vec3& p_ls) const;
+
+    void prefetchLoop();
+    bool loadAround(const Vec3& p_ls, uint64_t pass);  // false: the pool is too small, or a read failed
+    void evict(const Vec3& p_ls, uint64_t pass, std::size_t needed);
+
+    // Geometry
+    Vec3        origin_{0.0};          // position of sample (0, 0, 0)
+    double      h_ = 1.0;
+    double      invH_ = 1.0;
+    double      band_ = 0.0;
+    double      quantum_ = 0.0;        // band / 32767, one int16 step
+    uint32_t    bricksAcross_[3] = {0, 0, 0};
+    Aabb        meshBounds_;
+    uint64_t    key_ = 0;
+
+    // Resident index
+    std::unordered_map<uint64_t, uint32_t> root_;   // node coords -> node index / kInsideTile
+    std::vector<Node>     nodes_;
+    std::vector<float>    coarse_;                  // centre sample per brick
+    std::size_t           brickCount_ = 0;
+
+    // Bricks on disk
+    logging::MappedFile   file_;
+    std::size_t           bricksOffset_ = 0;
+
+    // Brick pool. slotOf_ is published by the prefetch thread and read by
+    // queries; a slot is only reused once no query that may have seen it is
+    // still running (readers_).
+    std::vector<int16_t>                     pool_;
+    std::unique_ptr<std::atomic<uint32_t>[]> slotOf_;    // per brick
+    mutable std::atomic<uint32_t>            readers_{0};
+    std::atomic<std::size_t>                 resident_{0};
+    mutable std::atomic<uint64_t>            misses_{0};
+
+    // Prefetch thread only
+    std::vector<Slot>     slots_;
+    std::vector<uint32_t> freeSlots_;
+    std::vector<uint64_t> wantedIn_;                 // per brick, last pass that wanted it
+    std::vector<Wanted>   wanted_;
+    std::vector<std::pair<double, uint32_t>> victims_;  // (d2, slot)
+    double                prefetchRadius_ = 0.0;
+
+    // Where to prefetch; one point per BrickSDF, so objects sharing this
+    // geometry take turns
+    mutable std::atomic<double>   hint_[3];
+    mutable std::atomic<uint64_t> hintSeq_{0};
+    std::thread                   prefetcher_;
+    std::mutex                    mutex_;
+    std::condition_variable       wake_;
+    bool                          stop_ = false;
+};
@@ -0,0 +1,71 @@
+// geometry/sdf/GridSDF.h
+#pragma once
+#include "geometry/sdf/SDF.h"
+#include "geometry/TriMesh.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct GridSDFConfig {
+    double   voxel = 0.0;     // grid spacing, mesh units; 0: longest side of the mesh bounds / 128
+    uint32_t bandVoxels = 4;  // exact distances within this many voxels of the surface
+    uint32_t threads = 0;     // bake threads; 0: hardware_concurrency
+};
+
+// Signed distance to a closed triangle mesh, sampled on a regular grid.
+//
+// Baking (bake / loadOrBake, startup only):
+//  - exact point-triangle distance for grid points in a narrow band around
+//    the surface, sign from the angle-weighted pseudonormal of the closest
+//    feature; the grid is split into z slabs across threads
+//  - everything outside the band is +band or -band, sign from a flood fill
+//    that starts at the grid border (holes in the mesh let it leak inside)
+//  - loadOrBake keeps the result in <cacheDir>/<key>.sdfgrid, keyed by the
+//    mesh content hash and the config, so a mesh is only baked once
+//
+// queryLocal is constant time: trilinear interpolation of the 8 surrounding
+// samples, with the gradient of that interpolant. Contacts deeper than the
+// band get a flat field (zero gradient), so pick bandVoxels * voxel above the
+// deepest expected penetration.
+class GridSDF : public SDF {
+public:
+    static std::shared_ptr<GridSDF> bake(const TriMesh& mesh, const GridSDFConfig& cfg = {});
+    static std::shared_ptr<GridSDF> loadOrBake(const TriMesh& mesh, const GridSDFConfig& cfg,
+                                               const std::string& cacheDir);
+
+    bool save(const std::string& path) const;
+    // Null if the file is missing, corrupt, or was baked for another key
+    static std::shared_ptr<GridSDF> load(const std::string& path, uint64_t expectedKey);
+
+    // Identifies mesh + config; the cache file name
+    static uint64_t cacheKey(const TriMesh& mesh, const GridSDFConfig& cfg);
+
+    // Samples bake() would allocate for mesh (0 if it has no extent)
+    static std::size_t sampleCount(const TriMesh& mesh, const GridSDFConfig& cfg);
+
+    SDFQuery queryLocal(const Vec3& p_ls) const override;
+    Aabb localBounds() const override { return meshBounds_; }
+
+    double voxel() const { return h_; }
+    double band() const { return band_; }
+    uint32_t nx() const { return n_[0]; }
+    uint32_t ny() const { return n_[1]; }
+    uint32_t nz() const { return n_[2]; }
+
+private:
+    GridSDF() = default;
+
+    float at(uint32_t i, uint32_t j, uint32_t k) const {
+        return phi_[(std::size_t(k) * n_[1] + j) * n_[0] + i];
+    }
+
+    Vec3        origin_{0.0};      // position of sample (0, 0, 0)
+    double      h_ = 1.0;          // voxel size
+    double      invH_ = 1.0;
+    double      band_ = 0.0;       // |phi| is clamped to this
+    uint32_t    n_[3] = {0, 0, 0}; // samples per axis
+    Aabb        meshBounds_;
+    uint64_t    key_ = 0;
+    std::vector<float> phi_;       // x fastest, then y, then z
+};
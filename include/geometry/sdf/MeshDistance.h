@@ -0,0 +1,69 @@
+// geometry/sdf/MeshDistance.h
+#pragma once
+#include "data/core/Math.h"
+#include "geometry/TriMesh.h"
+#include "geometry/sdf/SDF.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Shared by the mesh SDFs (GridSDF, BrickSDF): point to triangle distance for
+// the bakers, cache key hashing and the sample interpolation for queries.
+
+// Point to triangle distance.
+// The sign comes from the angle-weighted pseudonormal of the closest face,
+// edge or vertex (Baerentzen & Aanaes), which is exact for closed meshes.
+struct MeshTriangle {
+    Vec3 a, b, c;
+    Vec3 normal[7];  // pseudonormal per closest feature: vertices a, b, c; edges ab, bc, ca; face
+};
+
+// The mesh's non-degenerate triangles, with their pseudonormals
+std::vector<MeshTriangle> prepareMeshTriangles(const TriMesh& mesh);
+
+// Squared distance from p to t. outside is false when p lies behind the
+// closest feature, i.e. inside the mesh as far as this triangle can tell.
+double distanceSquared(const MeshTriangle& t, const Vec3& p, bool& outside);
+
+// FNV-1a over bytes, continuing from h (kFnv1aBasis to start)
+inline constexpr uint64_t kFnv1aBasis = 0xcbf29ce484222325ull;
+
+inline uint64_t fnv1a(uint64_t h, const void* data, std::size_t bytes) {
+    const auto* p = static_cast<const uint8_t*>(data);
+    for (std::size_t i = 0; i < bytes; ++i) {
+        h ^= p[i];
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+// Trilinear interpolation of a cell's corner samples c[x + 2y + 4z] at t in
+// [0, 1]^3. *grad is the exact gradient of the interpolant, per unit of t.
+inline double trilinear(const double c[8], const double t[3], Vec3* grad) {
+    const double tx = t[0], ty = t[1], tz = t[2];
+    const double sx = 1.0 - tx, sy = 1.0 - ty, sz = 1.0 - tz;
+    *grad = Vec3{
+        (sy * sz * (c[1] - c[0]) + ty * sz * (c[3] - c[2]) + sy * tz * (c[5] - c[4]) + ty * tz * (c[7] - c[6])),
+        (sx * sz * (c[2] - c[0]) + tx * sz * (c[3] - c[1]) + sx * tz * (c[6] - c[4]) + tx * tz * (c[7] - c[5])),
+        (sx * sy * (c[4] - c[0]) + tx * sy * (c[5] - c[1]) + sx * ty * (c[6] - c[2]) + tx * ty * (c[7] - c[3]))
+    };
+    return sz * (sy * (sx * c[0] + tx * c[1]) + ty * (sx * c[2] + tx * c[3])) +
+           tz * (sy * (sx * c[4] + tx * c[5]) + ty * (sx * c[6] + tx * c[7]));
+}
+
+// Completes a grid query at p_ls: beyond the grid (off = p_ls minus its
+// clamped position, nonzero) add the distance to it, pointing away from it;
+// then inside and the projection along the gradient.
+inline void finishGridQuery(SDFQuery& q, const Vec3& p_ls, const Vec3& off) {
+    const double off2 = glm::dot(off, off);
+    if (off2 > 0.0) {
+        const double d = std::sqrt(off2);
+        q.phi += d;
+        q.grad = off / d;
+    }
+
+    q.inside = q.phi < 0.0;
+    const double g2 = glm::dot(q.grad, q.grad);
+    q.proj = g2 > 1e-20 ? p_ls - q.grad * (q.phi / std::sqrt(g2)) : p_ls;
+}
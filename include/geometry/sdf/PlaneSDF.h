@@ -7,6 +7,7 @@ public:
     PlaneSDF(const Vec3& n_local, double b_local);
 
     SDFQuery queryLocal(const Vec3& x_ls) const override;
+    bool primitive(SDFPrimitive& out) const override;
 
 private:
     Vec3   n_;
@@ -0,0 +1,64 @@
+// geometry/sdf/PrimitiveBatch.h
+#pragma once
+#include "data/core/Math.h"
+#include "geometry/sdf/SDF.h"
+#include <cstdint>
+#include <vector>
+
+// Data-oriented evaluation of many analytic primitives (spheres, boxes,
+// planes) at one point. Primitives are stored in world space as float SoA
+// arrays grouped by shape, and swept 8 (AVX2) or 4 (SSE2) at a time with no
+// virtual calls or branches. Returns the nearest primitive; the caller
+// re-queries that one object through its SDF for the exact (double) phi,
+// gradient and projection.
+//
+//   batch.clear();
+//   for (...) batch.add(*sdf, obj.T_ws, objectIndex);
+//   batch.finish();
+//   PrimitiveBatch::Hit h = batch.nearest(toolPos);
+class PrimitiveBatch {
+public:
+    struct Hit {
+        float    phi;   // world-space signed distance (float precision)
+        uint32_t item;  // caller's index passed to add(), or kNone
+    };
+    static constexpr uint32_t kNone = 0xFFFFFFFFu;
+
+    void clear();
+
+    // False if sdf has no analytic description (SDF::primitive)
+    bool add(const SDF& sdf, const Pose& T_ws, uint32_t item);
+
+    // Pads the groups to the vector width; call after the last add()
+    void finish();
+
+    // Kernel instantiations; nearest() uses the one picked at startup
+    enum class Isa { Scalar, Sse2, Avx2 };
+
+    Hit nearest(const Vec3& p_ws) const;
+
+    // With a given kernel, for checking them against each other (haptic_check).
+    // Only call with an Isa this CPU supports.
+    Hit nearest(const Vec3& p_ws, Isa isa) const;
+    static bool supports(Isa isa);
+
+    std::size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+
+    // Instruction set picked at startup: "avx2", "sse2" or "scalar"
+    static const char* isa();
+
+private:
+    struct Group {
+        std::vector<float>    f[13];  // per-shape fields, see PrimitiveKernels.h
+        std::vector<uint32_t> item;
+        std::size_t size() const { return item.size(); }
+    };
+
+    void pad(Group& g, const float* padValues, uint32_t fields);
+
+    Group spheres_; // cx, cy, cz, r
+    Group boxes_;   // cx, cy, cz, R^T (9), h
+    Group planes_;  // nx, ny, nz, d
+    std::size_t count_ = 0;
+};
@@ -0,0 +1,112 @@
+// geometry/sdf/PrimitiveKernels.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Internal to PrimitiveBatch: the SoA layout and the nearest-primitive kernel,
+// written once against a small vector-ops type V and instantiated per
+// instruction set (PrimitiveBatch.cpp: scalar, SSE2; PrimitiveBatchAvx2.cpp: AVX2).
+// Keep this header free of std:: inline code: the AVX2 TU is compiled with
+// AVX2 enabled, and a shared inline symbol could end up on a non-AVX2 path.
+
+namespace sdfbatch {
+
+// Lanes every group is padded to (AVX2 width); pad entries evaluate to +inf
+inline constexpr uint32_t kLanes = 8;
+
+// World-space primitives, one array per field. Counts include padding.
+struct SoA {
+    // Spheres: |p - c| - r
+    const float* sx; const float* sy; const float* sz; const float* sr;
+    uint32_t spheres;
+
+    // Boxes: box distance of R^T (p - c) with half extent h
+    const float* bx; const float* by; const float* bz;
+    const float* rt[9]; // R^T row-major
+    const float* bh;
+    uint32_t boxes;
+
+    // Planes: dot(n, p) - d
+    const float* nx; const float* ny; const float* nz; const float* nd;
+    uint32_t planes;
+};
+
+// Index runs over spheres, then boxes, then planes (padded counts)
+struct Nearest {
+    float    phi;
+    uint32_t index;
+};
+
+template<typename V>
+inline void nearestKernel(const SoA& s, float px, float py, float pz, Nearest& out) {
+    using R = typename V::reg;
+    constexpr uint32_t W = V::kWidth;
+
+    const R Px = V::set1(px), Py = V::set1(py), Pz = V::set1(pz);
+    const R zero = V::set1(0.0f);
+    const R step = V::set1(float(W));
+
+    R best = V::set1(3.0e38f);
+    R bestIdx = V::set1(0.0f);
+    R idx = V::iota();
+
+    auto keep = [&](R phi) {
+        const auto m = V::lt(phi, best);
+        best = V::select(m, phi, best);
+        bestIdx = V::select(m, idx, bestIdx);
+        idx = V::add(idx, step);
+    };
+
+    for (uint32_t i = 0; i < s.spheres; i += W) {
+        const R dx = V::sub(Px, V::load(s.sx + i));
+        const R dy = V::sub(Py, V::load(s.sy + i));
+        const R dz = V::sub(Pz, V::load(s.sz + i));
+        const R d2 = V::add(V::add(V::mul(dx, dx), V::mul(dy, dy)), V::mul(dz, dz));
+        keep(V::sub(V::sqrt(d2), V::load(s.sr + i)));
+    }
+
+    for (uint32_t i = 0; i < s.boxes; i += W) {
+        const R dx = V::sub(Px, V::load(s.bx + i));
+        const R dy = V::sub(Py, V::load(s.by + i));
+        const R dz = V::sub(Pz, V::load(s.bz + i));
+        const R h = V::load(s.bh + i);
+
+        const R qx = V::add(V::add(V::mul(V::load(s.rt[0] + i), dx), V::mul(V::load(s.rt[1] + i), dy)),
+                            V::mul(V::load(s.rt[2] + i), dz));
+        const R qy = V::add(V::add(V::mul(V::load(s.rt[3] + i), dx), V::mul(V::load(s.rt[4] + i), dy)),
+                            V::mul(V::load(s.rt[5] + i), dz));
+        const R qz = V::add(V::add(V::mul(V::load(s.rt[6] + i), dx), V::mul(V::load(s.rt[7] + i), dy)),
+                            V::mul(V::load(s.rt[8] + i), dz));
+
+        const R ax = V::sub(V::abs(qx), h);
+        const R ay = V::sub(V::abs(qy), h);
+        const R az = V::sub(V::abs(qz), h);
+        const R ox = V::max(ax, zero), oy = V::max(ay, zero), oz = V::max(az, zero);
+
+        const R outside = V::sqrt(V::add(V::add(V::mul(ox, ox), V::mul(oy, oy)), V::mul(oz, oz)));
+        const R inside = V::min(V::max(V::max(ax, ay), az), zero);
+        keep(V::add(outside, inside));
+    }
+
+    for (uint32_t i = 0; i < s.planes; i += W) {
+        const R d = V::add(V::add(V::mul(V::load(s.nx + i), Px), V::mul(V::load(s.ny + i), Py)),
+                           V::mul(V::load(s.nz + i), Pz));
+        keep(V::sub(d, V::load(s.nd + i)));
+    }
+
+    float phis[W];
+    float idxs[W];
+    V::store(phis, best);
+    V::store(idxs, bestIdx);
+    for (uint32_t l = 0; l < W; ++l) {
+        if (phis[l] < out.phi) {
+            out.phi = phis[l];
+            out.index = static_cast<uint32_t>(idxs[l]);
+        }
+    }
+}
+
+// AVX2 instantiation (PrimitiveBatchAvx2.cpp); only call when the CPU has AVX2
+void nearestAvx2(const SoA& s, float px, float py, float pz, Nearest& out);
+
+} // namespace sdfbatch
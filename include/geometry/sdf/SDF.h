@@ -1,6 +1,19 @@
 // geometry/SDF.h
 #pragma once
 #include "data/core/Math.h"
+#include "geometry/Aabb.h"
+#include <cstdint>
+
+// Local-space description of an analytic SDF, for batched evaluation
+// (geometry/sdf/PrimitiveBatch.h)
+struct SDFPrimitive {
+    enum class Kind : uint8_t { Sphere, Box, Plane };
+    Kind   kind = Kind::Sphere;
+    Vec3   center{0.0};      // Sphere, Box
+    double size = 0.0;       // Sphere: radius, Box: half extent (cube)
+    Vec3   normal{0, 1, 0};  // Plane: phi = dot(normal, p) - offset
+    double offset = 0.0;
+};
 
 struct SDFQuery {
     double phi;    // implicit value / signed distance if SDF
@@ -15,6 +28,13 @@ public:
 
     virtual SDFQuery queryLocal(const Vec3& p_ls) const = 0;
 
+    // Conservative local-space box around the zero level set, for broad-phase
+    // culling. Unbounded surfaces (planes) keep the default.
+    virtual Aabb localBounds() const { return Aabb::unbounded(); }
+
+    // Fill out and return true if this SDF is one of the SDFPrimitive shapes
+    virtual bool primitive(SDFPrimitive& /*out*/) const { return false; }
+
     // Optional but very useful
     virtual Vec3 projectLocal(const Vec3& p_ls) const {
         SDFQuery q = queryLocal(p_ls);
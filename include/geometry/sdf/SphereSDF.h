@@ -8,6 +8,13 @@ public:
     SphereSDF(const Vec3& center_ls, double radius);
 
     SDFQuery queryLocal(const Vec3& p_ls) const override;
+    Aabb localBounds() const override { return Aabb::around(c_, r_); }
+    bool primitive(SDFPrimitive& out) const override {
+        out.kind = SDFPrimitive::Kind::Sphere;
+        out.center = c_;
+        out.size = r_;
+        return true;
+    }
 
 private:
     Vec3   c_;   // center (local space)
@@ -46,4 +46,13 @@ public:
 
         return q;
     }
+
+    Aabb localBounds() const override { return Aabb::around(Vec3{0.0}, 0.5); }
+
+    bool primitive(SDFPrimitive& out) const override {
+        out.kind = SDFPrimitive::Kind::Box;
+        out.center = Vec3{0.0};
+        out.size = 0.5;
+        return true;
+    }
 };
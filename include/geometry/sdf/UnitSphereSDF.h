@@ -18,4 +18,13 @@ public:
         }
         return q;
     }
+
+    Aabb localBounds() const override { return Aabb::around(Vec3{0.0}, 1.0); }
+
+    bool primitive(SDFPrimitive& out) const override {
+        out.kind = SDFPrimitive::Kind::Sphere;
+        out.center = Vec3{0.0};
+        out.size = 1.0;
+        return true;
+    }
 };
@@ -1,9 +1,12 @@
 #pragma once
 #include "hardware/SerialLink.h"
 
-#include "messaging/Channel.h"
+#include "messaging/SpscChannel.h"
+#include "messaging/MailboxChannel.h"
+#include "messaging/FixedBuffer.h"
 #include "data/HapticMessages.h"
 #include "hardware/Packets.h"
+#include "hardware/LoopLatency.h"
 #include "data/HapticMessages.h" // for ToolStateMsg and HapticWrenchCmd
 #include "data/LogMessages.h" // for DeviceTimingLogMsg
 
@@ -18,20 +21,23 @@
 class DeviceAdapter {
 public:
     DeviceAdapter(
-        msg::Channel<ToolStateMsg>& deviceIn,
-        msg::Channel<HapticWrenchCmd>& deviceCmdOut,
-        msg::Channel<DeviceTimingLogMsg>& timingLogOut,
-        msg::Channel<DeviceStateLogMsg>& stateLogOut
+        msg::MailboxChannel<ToolStateMsg>& deviceIn,
+        msg::MailboxChannel<HapticWrenchCmd>& deviceCmdOut,
+        msg::SpscChannel<DeviceTimingLogMsg>& timingLogOut,
+        msg::SpscChannel<DeviceStateLogMsg>& stateLogOut
     );
 
     bool connect(const std::string& port, int baud = 460800);
     void update(double timeNow);
 
+    // Optional: feed closed-loop latency histograms (read by the UI)
+    void setLatencyStats(LoopLatency* stats) { latency_ = stats; }
+
 private:
-    msg::Channel<ToolStateMsg>& deviceIn_;
-    msg::Channel<HapticWrenchCmd>& deviceCmdOut_;
-    msg::Channel<DeviceTimingLogMsg>& timingLogOut_;
-    msg::Channel<DeviceStateLogMsg>& stateLogOut_;
+    msg::MailboxChannel<ToolStateMsg>& deviceIn_;
+    msg::MailboxChannel<HapticWrenchCmd>& deviceCmdOut_;
+    msg::SpscChannel<DeviceTimingLogMsg>& timingLogOut_;
+    msg::SpscChannel<DeviceStateLogMsg>& stateLogOut_;
     SerialLink link_;
 
     std::vector<uint8_t> incomingBuffer_;
@@ -48,8 +54,14 @@ private:
     // Internal caching of latest data
     ToolStateMsg currentIn_;
     HapticWrenchCmd lastOut_;
+    uint64_t cmdVersion_ = 0;
+
+    // Per-update state log batch, published to stateLogOut_ in one go
+    msg::FixedBuffer<DeviceStateLogMsg, 32> stateBatch_;
 
     uint64_t lastChunkReadNs_ = 0;
+    uint64_t lastStateChunkNs_ = 0;   // chunk that delivered the previous state batch
+    LoopLatency* latency_ = nullptr;
     uint32_t nextCmdSeq_ = 1;
     uint32_t latestStateSeq_ = 0;
     uint32_t latestStateMcuUs_ = 0;
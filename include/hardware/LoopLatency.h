@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "metrics/HdrHistogram.h"
+
+// Live latency histograms for the device control loop, fed by DeviceAdapter
+// from the same timestamps that go into DeviceTimingLogMsg (matched cycles
+// only) and shown in the renderer's "Loop latency" panel. Offline analysis
+// still uses the logs; this is for spotting regressions during a run.
+enum class LoopStage : uint8_t {
+    RxToToolPublish,      // t_rx_parse_ns       -> t_tool_publish_ns
+    ToolPublishToWrench,  // t_tool_publish_ns   -> t_wrench_consume_ns
+    WrenchToTxStart,      // t_wrench_consume_ns -> t_tx_start_ns
+    TxWrite,              // t_tx_start_ns       -> t_tx_done_ns
+    RxToTxDone,           // t_rx_parse_ns       -> t_tx_done_ns (end to end)
+    StateInterArrival,    // between serial reads that delivered state packets
+    Count
+};
+
+inline constexpr std::size_t kLoopStageCount = static_cast<std::size_t>(LoopStage::Count);
+
+inline const char* toString(LoopStage s) {
+    switch (s) {
+        case LoopStage::RxToToolPublish:     return "rx parse -> tool publish";
+        case LoopStage::ToolPublishToWrench: return "tool publish -> wrench consume";
+        case LoopStage::WrenchToTxStart:     return "wrench consume -> tx start";
+        case LoopStage::TxWrite:             return "tx start -> tx done";
+        case LoopStage::RxToTxDone:          return "rx parse -> tx done";
+        case LoopStage::StateInterArrival:   return "state inter-arrival";
+        case LoopStage::Count:               break;
+    }
+    return "?";
+}
+
+class LoopLatency {
+public:
+    // Interval in ns; ignored if either end is missing or out of order
+    void record(LoopStage s, uint64_t fromNs, uint64_t toNs) {
+        if (fromNs == 0 || toNs < fromNs) return;
+        hist_[static_cast<std::size_t>(s)].record(toNs - fromNs);
+    }
+
+    metrics::HdrHistogram::Summary summary(LoopStage s) const {
+        return hist_[static_cast<std::size_t>(s)].summary();
+    }
+
+    // Any thread (UI "Reset" button)
+    void reset() {
+        for (auto& h : hist_)
+            h.reset();
+    }
+
+private:
+    metrics::HdrHistogram hist_[kLoopStageCount];
+};
@@ -0,0 +1,190 @@
+// logging/ColumnarLog.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Columns.h"
+
+namespace logging {
+
+// Packed archive format for finished logs (log_export --pack).
+//
+// Rows are grouped into blocks; inside a block every field is stored as its
+// own column, encoded with the column's codec and then LZ-compressed:
+//   - ns timestamps and sequence numbers are nearly constant steps, so their
+//     deltas fit in one or two varint bytes
+//   - slowly changing floats share sign / exponent / high mantissa bits with
+//     the previous row, so XOR + byte planes leaves long zero runs
+//
+// File layout (little-endian, same build on both ends):
+//   ColumnarFileHeader
+//   ColumnarColumnEntry x columnCount
+//   { ColumnarBlockHeader, { ColumnarChunkHeader, bytes[storedBytes] } x columnCount } ...
+//
+// Live capture stays in SegmentLog (crash-safe, no encoding on the hot path).
+
+inline constexpr char        kColumnarMagic[8]  = {'C', 'O', 'L', 'L', 'O', 'G', '1', '\0'};
+inline constexpr uint32_t    kColumnarVersion   = 1;
+inline constexpr std::size_t kColumnarBlockRows = 65536;
+
+struct ColumnarFileHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t columnCount;
+    uint32_t blockRows;
+    char     recordType[48];
+};
+
+struct ColumnarColumnEntry {
+    char     name[32];
+    uint32_t offset;
+    uint8_t  type;      // ColumnType
+    uint8_t  codec;     // ColumnCodec
+    uint16_t reserved;
+};
+
+struct ColumnarBlockHeader {
+    uint32_t rows;
+    uint32_t columnCount;
+};
+
+struct ColumnarChunkHeader {
+    uint32_t encodedBytes;  // after the codec, before compression
+    uint32_t storedBytes;   // == encodedBytes: stored uncompressed
+};
+
+std::string columnarPath(const std::string& directory, const std::string& baseName);
+
+// ------------------------------------------------------------
+// Writer: buffers rows and writes one encoded block per blockRows
+// ------------------------------------------------------------
+class ColumnarWriter {
+public:
+    ColumnarWriter() = default;
+    ~ColumnarWriter();
+
+    ColumnarWriter(const ColumnarWriter&) = delete;
+    ColumnarWriter& operator=(const ColumnarWriter&) = delete;
+
+    bool open(const std::string& path, const char* recordType, uint32_t recordSize,
+              const ColumnDesc* cols, std::size_t colCount,
+              std::size_t blockRows = kColumnarBlockRows);
+
+    bool append(const void* records, std::size_t count);
+
+    // Write the partial last block and close the file
+    bool close();
+
+    bool isOpen() const { return file_ != nullptr; }
+    uint64_t rowsWritten() const { return rows_; }
+    uint64_t bytesWritten() const { return bytes_; }
+
+private:
+    bool writeBlock();
+
+    std::FILE*        file_ = nullptr;
+    const ColumnDesc* cols_ = nullptr;
+    std::size_t       colCount_   = 0;
+    uint32_t          recordSize_ = 0;
+    std::size_t       blockRows_  = 0;
+
+    std::vector<uint8_t> pending_;   // whole records waiting for a block
+    std::size_t          pendingRows_ = 0;
+    std::vector<uint8_t> column_;    // scratch: one column, plain
+    std::vector<uint8_t> encoded_;   // scratch: after the codec
+    std::vector<uint8_t> packed_;    // scratch: after compression
+
+    uint64_t rows_  = 0;
+    uint64_t bytes_ = 0;
+    bool     ok_    = true;
+};
+
+// ------------------------------------------------------------
+// Reader: decodes one block at a time back into whole records
+// ------------------------------------------------------------
+class ColumnarReader {
+public:
+    ColumnarReader() = default;
+    ~ColumnarReader();
+
+    ColumnarReader(const ColumnarReader&) = delete;
+    ColumnarReader& operator=(const ColumnarReader&) = delete;
+
+    // Fails if the file is missing, of another record type, or its columns
+    // don't match cols (record layout changed since it was packed)
+    bool open(const std::string& path, const char* recordType, uint32_t recordSize,
+              const ColumnDesc* cols, std::size_t colCount);
+
+    // Decode the next block into records (resized to rows * recordSize).
+    // Returns the row count, 0 at the end of the file or on corrupt data.
+    std::size_t readBlock(std::vector<uint8_t>& records);
+
+    std::size_t blockRows() const { return blockRows_; }
+
+private:
+    std::FILE*        file_ = nullptr;
+    const ColumnDesc* cols_ = nullptr;
+    std::size_t       colCount_   = 0;
+    uint32_t          recordSize_ = 0;
+    std::size_t       blockRows_  = 0;
+
+    std::vector<uint8_t> stored_;
+    std::vector<uint8_t> encoded_;
+    std::vector<uint8_t> column_;
+};
+
+// ------------------------------------------------------------
+// Typed wrappers
+// ------------------------------------------------------------
+template<typename T>
+class ColumnarLog {
+    static_assert(std::is_trivially_copyable<T>::value, "ColumnarLog<T> stores raw fields");
+
+public:
+    template<std::size_t N>
+    bool open(const std::string& path, const char* recordType, const ColumnDesc (&cols)[N]) {
+        return writer_.open(path, recordType, static_cast<uint32_t>(sizeof(T)), cols, N);
+    }
+
+    bool append(const T* recs, std::size_t count) { return writer_.append(recs, count); }
+    bool close() { return writer_.close(); }
+
+    uint64_t rowsWritten() const { return writer_.rowsWritten(); }
+    uint64_t bytesWritten() const { return writer_.bytesWritten(); }
+
+private:
+    ColumnarWriter writer_;
+};
+
+template<typename T>
+class ColumnarLogReader {
+    static_assert(std::is_trivially_copyable<T>::value, "ColumnarLogReader<T> reads raw fields");
+
+public:
+    template<std::size_t N>
+    bool open(const std::string& path, const char* recordType, const ColumnDesc (&cols)[N]) {
+        return reader_.open(path, recordType, static_cast<uint32_t>(sizeof(T)), cols, N);
+    }
+
+    // Next block of records; out is resized to fit. Returns 0 at the end.
+    std::size_t readBlock(std::vector<T>& out) {
+        const std::size_t n = reader_.readBlock(bytes_);
+        out.resize(n);
+        if (n > 0)
+            std::memcpy(out.data(), bytes_.data(), n * sizeof(T));
+        return n;
+    }
+
+private:
+    ColumnarReader       reader_;
+    std::vector<uint8_t> bytes_;
+};
+
+} // namespace logging
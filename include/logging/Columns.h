@@ -0,0 +1,146 @@
+// logging/Columns.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace logging {
+
+// Column view of a fixed-size log record: one entry per field, in CSV order.
+// The single description of a record's fields: the CSV header, the to_chars
+// row writer, the CSV reader and the columnar log format are all driven by it.
+
+enum class ColumnType : uint8_t { U8, U32, U64, F32, F64 };
+
+// How a column is encoded inside a columnar block (before compression)
+enum class ColumnCodec : uint8_t {
+    Plain,    // raw values
+    Delta,    // integers: zigzag varint of the difference to the previous row
+    XorFloat  // floats: XOR with the previous row, bytes transposed into planes
+};
+
+struct ColumnDesc {
+    const char* name;
+    uint32_t    offset;   // offsetof(record, field)
+    ColumnType  type;
+    ColumnCodec codec;
+};
+
+// Column type of a field, from its C++ type
+template<typename F>
+constexpr ColumnType columnTypeOf() {
+    static_assert(std::is_same<F, uint8_t>::value || std::is_same<F, uint32_t>::value ||
+                  std::is_same<F, uint64_t>::value || std::is_same<F, float>::value ||
+                  std::is_same<F, double>::value,
+                  "Log fields must be uint8_t, uint32_t, uint64_t, float or double");
+    if constexpr (std::is_same<F, uint8_t>::value)  return ColumnType::U8;
+    else if constexpr (std::is_same<F, uint32_t>::value) return ColumnType::U32;
+    else if constexpr (std::is_same<F, uint64_t>::value) return ColumnType::U64;
+    else if constexpr (std::is_same<F, float>::value)    return ColumnType::F32;
+    else                                                 return ColumnType::F64;
+}
+
+// One table entry per field; name, offset and type come from the struct
+#define LOG_COLUMN(Struct, field, codec) \
+    ::logging::ColumnDesc{ #field, static_cast<uint32_t>(offsetof(Struct, field)), \
+                           ::logging::columnTypeOf<decltype(Struct::field)>(), \
+                           ::logging::ColumnCodec::codec }
+
+constexpr std::size_t columnSize(ColumnType t) {
+    switch (t) {
+        case ColumnType::U8:  return 1;
+        case ColumnType::U32: return 4;
+        case ColumnType::U64: return 8;
+        case ColumnType::F32: return 4;
+        case ColumnType::F64: return 8;
+    }
+    return 0;
+}
+
+constexpr std::size_t alignUp(std::size_t v, std::size_t a) {
+    return (v + a - 1) / a * a;
+}
+
+// Compile-time check of a column table against its record layout (use in
+// static_assert). Walks the columns in offset order: each must start where the
+// previous one ended plus its alignment padding, and the last must end the record.
+template<std::size_t N>
+constexpr bool columnsCoverRecord(const ColumnDesc (&cols)[N], std::size_t recordSize, std::size_t recordAlign) {
+    std::size_t cursor = 0;
+    for (std::size_t step = 0; step < N; ++step) {
+        std::size_t next = N;
+        for (std::size_t i = 0; i < N; ++i) {
+            if (cols[i].offset >= cursor && (next == N || cols[i].offset < cols[next].offset))
+                next = i;
+        }
+        if (next == N || cols[next].offset != alignUp(cursor, columnSize(cols[next].type)))
+            return false;
+        cursor = cols[next].offset + columnSize(cols[next].type);
+    }
+    return alignUp(cursor, recordAlign) == recordSize;
+}
+
+namespace detail {
+
+struct AnyField {
+    template<typename U>
+    constexpr operator U() const noexcept { return U{}; }
+};
+
+template<typename T, typename Seq, typename = void>
+struct BraceInitializable : std::false_type {};
+
+template<typename T, std::size_t... I>
+struct BraceInitializable<T, std::index_sequence<I...>,
+                          std::void_t<decltype(T{(void(I), AnyField{})...})>> : std::true_type {};
+
+} // namespace detail
+
+// Number of fields of an aggregate: the most initializers T{...} accepts
+template<typename T, std::size_t N = 0>
+constexpr std::size_t aggregateFieldCount() {
+    if constexpr (detail::BraceInitializable<T, std::make_index_sequence<N + 1>>::value)
+        return aggregateFieldCount<T, N + 1>();
+    else
+        return N;
+}
+
+// "a,b,c" (no newline)
+std::string csvHeader(const ColumnDesc* cols, std::size_t count);
+
+// Append count records (recordSize bytes apart) as CSV rows to out,
+// formatted with std::to_chars (shortest round-trip for floats)
+void appendCsvRows(const void* records, std::size_t count, std::size_t recordSize,
+                   const ColumnDesc* cols, std::size_t colCount, std::string& out);
+
+// Parses CSV rows back into records. Columns are matched by header name, so
+// files from older builds with fewer or reordered columns still load: fields
+// missing from the file keep the record's default, unknown columns are skipped.
+class CsvRowReader {
+public:
+    CsvRowReader(const ColumnDesc* cols, std::size_t colCount) : cols_(cols), colCount_(colCount) {}
+
+    // Returns false if no column of the header belongs to the record
+    bool setHeader(std::string_view header);
+
+    // Record fields with no column in the file
+    std::vector<std::string> missingColumns() const;
+
+    // Overwrites the mapped fields of record from one line
+    // (without the newline). Returns false on a field that doesn't parse.
+    bool parse(std::string_view line, void* record) const;
+
+private:
+    static constexpr int kSkip = -1;
+
+    const ColumnDesc* cols_;
+    std::size_t       colCount_;
+    std::vector<int>  fileToCol_; ///< per CSV column: index into cols_, or kSkip
+};
+
+} // namespace logging
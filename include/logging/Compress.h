@@ -0,0 +1,20 @@
+// logging/Compress.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace logging {
+
+// Small LZ77 byte compressor (LZ4-style sequences: token, literals, 16-bit
+// offset, match length). Greedy single-probe hash, no entropy stage: fast
+// enough to run per log block, and columnar data is already very repetitive.
+
+// Appends the compressed form of in[0..n) to out
+void lzCompress(const uint8_t* in, std::size_t n, std::vector<uint8_t>& out);
+
+// Decodes exactly rawSize bytes into out. Returns false on corrupt input.
+bool lzDecompress(const uint8_t* in, std::size_t n, uint8_t* out, std::size_t rawSize);
+
+} // namespace logging
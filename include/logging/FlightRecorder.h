@@ -0,0 +1,140 @@
+// logging/FlightRecorder.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "SegmentLog.h"
+
+namespace logging {
+
+// Flight-recorder log mode: records stay in a fixed in-memory ring per log
+// type and only the window around a trigger is written to the segment logs.
+//
+//   ... ring (discarded) ... [ pre | trigger | post ] ... ring (discarded) ...
+//
+//  - a trigger persists every member's last preNs of records, then appends
+//    everything arriving in the next postNs straight to the sinks; another
+//    trigger inside the window extends it
+//  - windows are in log-thread time (when a record was drained), which is
+//    within a wake of when it was published
+//  - single-threaded: everything is driven from the log thread
+//  - each trigger is listed in <dir>/flight_triggers.csv (time, reason)
+
+struct FlightRecorderConfig {
+    uint64_t    preNs       = 5'000'000'000ull;  // kept before a trigger
+    uint64_t    postNs      = 5'000'000'000ull;  // kept after the last trigger
+    std::size_t ringRecords = 1 << 15;           // per type; >= pre window at the peak rate
+};
+
+class FlightRecorderGroup;
+
+class FlightRecorderMember {
+public:
+    virtual ~FlightRecorderMember() = default;
+
+protected:
+    friend class FlightRecorderGroup;
+    // Persist buffered records stamped at or after fromNs, then empty the ring
+    virtual void flushPreTrigger(uint64_t fromNs) = 0;
+};
+
+class FlightRecorderGroup {
+public:
+    explicit FlightRecorderGroup(const FlightRecorderConfig& cfg = {});
+    ~FlightRecorderGroup();
+
+    FlightRecorderGroup(const FlightRecorderGroup&) = delete;
+    FlightRecorderGroup& operator=(const FlightRecorderGroup&) = delete;
+
+    // Optional trigger list; without it triggers are only counted
+    bool openTriggerLog(const std::string& directory);
+
+    void add(FlightRecorderMember& member) { members_.push_back(&member); }
+
+    // reason must outlive the call (string literal)
+    void trigger(const char* reason, uint64_t nowNs);
+
+    bool capturing(uint64_t nowNs) const { return nowNs < captureUntilNs_; }
+
+    const FlightRecorderConfig& config() const { return cfg_; }
+    uint64_t triggers() const { return triggers_; }
+    uint64_t windows() const { return windows_; }
+
+private:
+    FlightRecorderConfig               cfg_;
+    std::vector<FlightRecorderMember*> members_;
+    uint64_t                           captureUntilNs_ = 0;
+    uint64_t                           triggers_ = 0;
+    uint64_t                           windows_  = 0;
+    std::FILE*                         triggerLog_ = nullptr;
+};
+
+// One log type: ring buffer in front of its SegmentLog sink
+template<typename T>
+class FlightRecorder : public FlightRecorderMember {
+public:
+    FlightRecorder(FlightRecorderGroup& group, SegmentLog<T>& sink)
+        : group_(group), sink_(sink) {
+        group_.add(*this);
+    }
+
+    // Call after checking rec against the triggers, so a triggering record
+    // lands inside its own window
+    void push(const T& rec, uint64_t nowNs) {
+        if (group_.capturing(nowNs)) {
+            sink_.append(rec);
+            ++persisted_;
+            return;
+        }
+
+        if (ring_.empty())
+            ring_.resize(group_.config().ringRecords); // first use: nothing allocated unless enabled
+
+        ring_[head_] = Entry{nowNs, rec};
+        head_ = (head_ + 1) % ring_.size();
+        if (count_ < ring_.size())
+            ++count_;
+        else
+            ++discarded_;
+    }
+
+    uint64_t persisted() const { return persisted_; }
+    uint64_t discarded() const { return discarded_; }
+
+protected:
+    void flushPreTrigger(uint64_t fromNs) override {
+        if (count_ == 0)
+            return;
+
+        std::size_t i = (head_ + ring_.size() - count_) % ring_.size();
+        for (std::size_t n = 0; n < count_; ++n, i = (i + 1) % ring_.size()) {
+            if (ring_[i].tNs < fromNs) {
+                ++discarded_;
+                continue;
+            }
+            sink_.append(ring_[i].rec);
+            ++persisted_;
+        }
+        count_ = 0;
+    }
+
+private:
+    struct Entry {
+        uint64_t tNs;
+        T        rec;
+    };
+
+    FlightRecorderGroup& group_;
+    SegmentLog<T>&       sink_;
+    std::vector<Entry>   ring_;
+    std::size_t          head_  = 0;    // next slot to write
+    std::size_t          count_ = 0;
+    uint64_t             persisted_ = 0;
+    uint64_t             discarded_ = 0;
+};
+
+} // namespace logging
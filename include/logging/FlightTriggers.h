@@ -0,0 +1,68 @@
+// logging/FlightTriggers.h
+#pragma once
+
+#include <cstdint>
+
+#include "data/LogMessages.h"
+
+namespace logging {
+
+// Trigger predicates for the flight recorder, one check() per log type.
+// Each returns the reason (a string literal) or nullptr. Conditions fire on
+// their onset only, so a watchdog that stays active, or a long contact,
+// opens one window rather than extending it forever.
+
+struct FlightTriggerConfig {
+    uint64_t loopDeadlineNs = 1'000'000;  // rx parse -> tx done of a matched cycle
+    uint64_t stateGapNs     = 5'000'000;  // between parsed state packets
+};
+
+class FlightTriggers {
+public:
+    explicit FlightTriggers(const FlightTriggerConfig& cfg = {}) : cfg_(cfg) {}
+
+    const char* check(const DeviceStateLogMsg& x) {
+        const char* why = nullptr;
+        if (x.watchdog_active && !watchdog_)
+            why = "watchdog";
+        else if (lastStateNs_ != 0 && x.t_rx_parse_ns > lastStateNs_ + cfg_.stateGapNs)
+            why = "state_gap";
+
+        watchdog_ = x.watchdog_active != 0;
+        lastStateNs_ = x.t_rx_parse_ns;
+        return why;
+    }
+
+    const char* check(const DeviceTimingLogMsg& x) {
+        const bool sat = x.host_sat1 || x.host_sat2;
+        const bool late = x.t_tx_done_ns > x.t_rx_parse_ns + cfg_.loopDeadlineNs;
+
+        const char* why = nullptr;
+        if (sat && !saturated_)
+            why = "torque_saturation";
+        else if (late && !late_)
+            why = "deadline_miss";
+
+        saturated_ = sat;
+        late_ = late;
+        return why;
+    }
+
+    const char* check(const SimulationValidationLogMsg& x) {
+        const bool contact = x.contact_active != 0;
+        const char* why = (contact && !contact_) ? "contact_onset" : nullptr;
+        contact_ = contact;
+        return why;
+    }
+
+private:
+    FlightTriggerConfig cfg_;
+
+    bool     watchdog_    = false;
+    bool     saturated_   = false;
+    bool     late_        = false;
+    bool     contact_     = false;
+    uint64_t lastStateNs_ = 0;
+};
+
+} // namespace logging
@@ -0,0 +1,113 @@
+// logging/LogRecords.h
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+
+#include "Columns.h"
+#include "data/LogMessages.h"
+
+namespace logging {
+
+// Per-record-type names and column layout, shared by the app's log sink and
+// the log_export tool so both agree on file names, CSV columns and codecs.
+// Columns are listed in CSV order; a new field is one LOG_COLUMN line (its type
+// comes from the struct, and the static_asserts below catch a forgotten one).
+template<typename T>
+struct LogRecordTraits;
+
+template<>
+struct LogRecordTraits<DeviceTimingLogMsg> {
+    using M = DeviceTimingLogMsg;
+    static constexpr const char* typeName = "DeviceTimingLogMsg";
+    static constexpr const char* baseName = "device_timing";
+    static constexpr const char* csvFile  = "device_timing.csv";
+
+    static constexpr ColumnDesc columns[] = {
+        LOG_COLUMN(M, rx_state_seq,        Delta),
+        LOG_COLUMN(M, state_mcu_us,        Delta),
+        LOG_COLUMN(M, tx_cmd_seq,          Delta),
+        LOG_COLUMN(M, ref_state_seq,       Delta),
+        LOG_COLUMN(M, t_rx_parse_ns,       Delta),
+        LOG_COLUMN(M, t_tool_publish_ns,   Delta),
+        LOG_COLUMN(M, t_wrench_consume_ns, Delta),
+        LOG_COLUMN(M, t_tx_start_ns,       Delta),
+        LOG_COLUMN(M, t_tx_done_ns,        Delta),
+        LOG_COLUMN(M, q1,                  XorFloat),
+        LOG_COLUMN(M, q2,                  XorFloat),
+        LOG_COLUMN(M, fx,                  XorFloat),
+        LOG_COLUMN(M, fy,                  XorFloat),
+        LOG_COLUMN(M, tau1_raw,            XorFloat),
+        LOG_COLUMN(M, tau1,                XorFloat),
+        LOG_COLUMN(M, tau2_raw,            XorFloat),
+        LOG_COLUMN(M, tau2,                XorFloat),
+        LOG_COLUMN(M, host_sat1,           Plain),
+        LOG_COLUMN(M, host_sat2,           Plain),
+    };
+};
+
+template<>
+struct LogRecordTraits<DeviceStateLogMsg> {
+    using M = DeviceStateLogMsg;
+    static constexpr const char* typeName = "DeviceStateLogMsg";
+    static constexpr const char* baseName = "device_state";
+    static constexpr const char* csvFile  = "device_state_log.csv";
+
+    static constexpr ColumnDesc columns[] = {
+        LOG_COLUMN(M, t_chunk_read_ns, Delta),
+        LOG_COLUMN(M, t_rx_parse_ns,   Delta),
+        LOG_COLUMN(M, rx_state_seq,    Delta),
+        LOG_COLUMN(M, state_mcu_us,    Delta),
+        LOG_COLUMN(M, q1,              XorFloat),
+        LOG_COLUMN(M, q2,              XorFloat),
+        LOG_COLUMN(M, applied_tau1,    XorFloat),
+        LOG_COLUMN(M, applied_tau2,    XorFloat),
+        LOG_COLUMN(M, watchdog_active, Plain),
+        LOG_COLUMN(M, sat1,            Plain),
+        LOG_COLUMN(M, sat2,            Plain),
+    };
+};
+
+template<>
+struct LogRecordTraits<SimulationValidationLogMsg> {
+    using M = SimulationValidationLogMsg;
+    static constexpr const char* typeName = "SimulationValidationLogMsg";
+    static constexpr const char* baseName = "simulation_validation";
+    static constexpr const char* csvFile  = "simulation_validation_log.csv";
+
+    static constexpr ColumnDesc columns[] = {
+        LOG_COLUMN(M, t_sec,               XorFloat),
+        LOG_COLUMN(M, device_x,            XorFloat),
+        LOG_COLUMN(M, device_y,            XorFloat),
+        LOG_COLUMN(M, device_z,            XorFloat),
+        LOG_COLUMN(M, proxy_x,             XorFloat),
+        LOG_COLUMN(M, proxy_y,             XorFloat),
+        LOG_COLUMN(M, proxy_z,             XorFloat),
+        LOG_COLUMN(M, force_x,             XorFloat),
+        LOG_COLUMN(M, force_y,             XorFloat),
+        LOG_COLUMN(M, force_z,             XorFloat),
+        LOG_COLUMN(M, normal_x,            XorFloat),
+        LOG_COLUMN(M, normal_y,            XorFloat),
+        LOG_COLUMN(M, normal_z,            XorFloat),
+        LOG_COLUMN(M, penetration_depth_m, XorFloat),
+        LOG_COLUMN(M, signed_phi_m,        XorFloat),
+        LOG_COLUMN(M, contact_active,      Plain),
+    };
+};
+
+// One column per field, laid out exactly like the struct
+template<typename T>
+constexpr bool tableMatchesRecord() {
+    constexpr auto& cols = LogRecordTraits<T>::columns;
+    return std::size(cols) == aggregateFieldCount<T>() &&
+           columnsCoverRecord(cols, sizeof(T), alignof(T));
+}
+
+static_assert(tableMatchesRecord<DeviceTimingLogMsg>(),
+              "LogRecordTraits<DeviceTimingLogMsg>::columns out of sync with the struct");
+static_assert(tableMatchesRecord<DeviceStateLogMsg>(),
+              "LogRecordTraits<DeviceStateLogMsg>::columns out of sync with the struct");
+static_assert(tableMatchesRecord<SimulationValidationLogMsg>(),
+              "LogRecordTraits<SimulationValidationLogMsg>::columns out of sync with the struct");
+
+} // namespace logging
@@ -0,0 +1,66 @@
+// logging/MappedFile.h
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace logging {
+
+// Memory mapping of a regular file, read/write (create) or read-only (openRead).
+//  - POSIX: open + ftruncate + mmap(MAP_SHARED)
+//  - Windows: CreateFile + CreateFileMapping + MapViewOfFile
+// Stores into the mapping reach the page cache immediately, so they survive a
+// crash of this process; flush() pushes them to disk (needed for power loss).
+// Pages of a read-only mapping are loaded on first touch, so touching one can
+// block on disk.
+class MappedFile {
+public:
+    static constexpr std::size_t kKeepSize = static_cast<std::size_t>(-1);
+
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Create (or truncate) path, size it to `bytes` and map it
+    bool create(const std::string& path, std::size_t bytes);
+
+    // Map an existing file read-only, whole; writing through data() faults
+    bool openRead(const std::string& path);
+
+    // Drop this process's pages of [offset, offset + bytes) of a read-only
+    // mapping (whole pages around it) from its resident set; the next touch
+    // reads them back, from the OS file cache if it still has them.
+    //  - POSIX: madvise(MADV_DONTNEED)
+    //  - Windows: VirtualUnlock, which removes unlocked pages from the
+    //    working set (they move to the standby list)
+    // Pages the kernel mapped around a fault outside the range (Linux
+    // fault-around) stay; use read() to copy small pieces without that.
+    void release(std::size_t offset, std::size_t bytes);
+
+    // Copy [offset, offset + bytes) with a plain file read (pread / ReadFile)
+    // instead of through the mapping, so none of it joins the resident set;
+    // the OS file cache still serves repeats. Safe from any thread.
+    bool read(std::size_t offset, void* dst, std::size_t bytes) const;
+
+    // Start writing dirty pages back (async), or wait for them (sync)
+    void flush(bool sync = false);
+
+    // Unmap and close, optionally shrinking the file to finalSize bytes
+    void close(std::size_t finalSize = kKeepSize);
+
+    bool isOpen() const { return data_ != nullptr; }
+    void* data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+private:
+    void*       data_    = nullptr;
+    std::size_t size_    = 0;
+    int         fd_      = -1;       ///< POSIX only
+    void*       file_    = nullptr;  ///< Windows HANDLE; unused on POSIX
+    void*       mapping_ = nullptr;  ///< Windows HANDLE; unused on POSIX
+    std::string path_;
+};
+
+} // namespace logging
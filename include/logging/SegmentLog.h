@@ -0,0 +1,169 @@
+// logging/SegmentLog.h
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+
+#include "MappedFile.h"
+
+namespace logging {
+
+// Append-only binary log of fixed-size records, streamed into memory-mapped
+// segment files <dir>/<base>.<NNNN>.seg and rotated by size.
+//
+//  - appends are a memcpy into the mapping plus one release store of the
+//    header's committed count: no syscalls, no heap, constant memory
+//  - a crash loses nothing that was committed: the pages are already in the
+//    OS page cache, and readers trust only `committed`, not the file size
+//  - a cleanly closed segment is marked sealed and trimmed to its contents
+
+inline constexpr char        kSegmentMagic[8]    = {'S', 'E', 'G', 'L', 'O', 'G', '1', '\0'};
+inline constexpr uint32_t    kSegmentVersion     = 1;
+inline constexpr std::size_t kSegmentHeaderBytes = 4096; // records start page-aligned
+
+struct SegmentHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint64_t capacity;                // records that fit in this segment
+    uint32_t segmentIndex;
+    uint32_t sealed;                  // 1 once closed cleanly
+    char     recordType[48];          // e.g. "DeviceTimingLogMsg", checked by readers
+    std::atomic<uint64_t> committed;  // records fully written
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "SegmentHeader::committed is read back from disk as a plain uint64_t");
+static_assert(sizeof(SegmentHeader) <= kSegmentHeaderBytes, "SegmentHeader must fit its page");
+
+struct SegmentLogConfig {
+    std::string directory = ".";
+    std::string baseName;                       // file prefix, e.g. "device_timing"
+    std::size_t segmentBytes = 64u << 20;       // rotate after ~64 MB
+};
+
+std::string segmentPath(const std::string& directory, const std::string& baseName, uint32_t index);
+
+// ------------------------------------------------------------
+// Untyped writer / reader (src/logging/SegmentLog.cpp)
+// ------------------------------------------------------------
+class SegmentWriter {
+public:
+    SegmentWriter() = default;
+    ~SegmentWriter();
+
+    SegmentWriter(const SegmentWriter&) = delete;
+    SegmentWriter& operator=(const SegmentWriter&) = delete;
+
+    bool open(const SegmentLogConfig& cfg, const char* recordType, uint32_t recordSize);
+
+    // Single writer thread only. Returns false if a new segment couldn't be created.
+    bool append(const void* records, std::size_t count);
+
+    // Ask the OS to write dirty pages back (power-loss safety); cheap, async
+    void flush();
+
+    // Seal and trim the current segment
+    void close();
+
+    bool isOpen() const { return hdr_ != nullptr; }
+    uint64_t recordsWritten() const { return total_; }
+    uint32_t segmentIndex() const { return index_; }
+
+private:
+    bool openSegment();
+    void sealSegment();
+
+    SegmentLogConfig cfg_;
+    std::string      recordType_;
+    uint32_t         recordSize_ = 0;
+
+    MappedFile     file_;
+    SegmentHeader* hdr_      = nullptr;
+    uint8_t*       records_  = nullptr;
+    uint64_t       capacity_ = 0;
+    uint64_t       count_    = 0;   // records in the current segment
+    uint64_t       total_    = 0;
+    uint32_t       index_    = 0;
+};
+
+class SegmentReader {
+public:
+    SegmentReader() = default;
+    ~SegmentReader();
+
+    SegmentReader(const SegmentReader&) = delete;
+    SegmentReader& operator=(const SegmentReader&) = delete;
+
+    // Position at the first segment. Fails if it is missing or of another type.
+    bool open(const std::string& directory, const std::string& baseName,
+              const char* recordType, uint32_t recordSize);
+
+    // Copy up to maxRecords committed records into out, moving through the
+    // segments in order. Returns 0 at the end of the log.
+    std::size_t read(void* out, std::size_t maxRecords);
+
+    // Number of segments that ended without being sealed (crash / kill)
+    uint32_t unsealedSegments() const { return unsealed_; }
+
+private:
+    bool openSegment(uint32_t index);
+
+    std::string directory_;
+    std::string baseName_;
+    std::string recordType_;
+    uint32_t    recordSize_ = 0;
+
+    std::FILE* file_      = nullptr;
+    uint32_t   index_     = 0;
+    uint64_t   remaining_ = 0;      // committed records left in this segment
+    uint32_t   unsealed_  = 0;
+};
+
+// ------------------------------------------------------------
+// Typed wrappers
+// ------------------------------------------------------------
+template<typename T>
+class SegmentLog {
+    static_assert(std::is_trivially_copyable<T>::value, "SegmentLog<T> stores raw bytes");
+
+public:
+    bool open(const SegmentLogConfig& cfg, const char* recordType) {
+        return writer_.open(cfg, recordType, static_cast<uint32_t>(sizeof(T)));
+    }
+
+    bool append(const T& rec) { return writer_.append(&rec, 1); }
+    bool append(const T* recs, std::size_t count) { return writer_.append(recs, count); }
+
+    void flush() { writer_.flush(); }
+    void close() { writer_.close(); }
+
+    bool isOpen() const { return writer_.isOpen(); }
+    uint64_t recordsWritten() const { return writer_.recordsWritten(); }
+
+private:
+    SegmentWriter writer_;
+};
+
+template<typename T>
+class SegmentLogReader {
+    static_assert(std::is_trivially_copyable<T>::value, "SegmentLogReader<T> reads raw bytes");
+
+public:
+    bool open(const std::string& directory, const std::string& baseName, const char* recordType) {
+        return reader_.open(directory, baseName, recordType, static_cast<uint32_t>(sizeof(T)));
+    }
+
+    std::size_t read(T* out, std::size_t maxRecords) { return reader_.read(out, maxRecords); }
+
+    uint32_t unsealedSegments() const { return reader_.unsealedSegments(); }
+
+private:
+    SegmentReader reader_;
+};
+
+} // namespace logging
@@ -0,0 +1,197 @@
+// messaging/BroadcastChannel.h
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+#include "ChannelBase.h"
+
+namespace msg {
+
+// Single-producer / multi-consumer broadcast ring (Disruptor-style fan-out).
+//  - the producer writes each message once; it never waits for subscribers
+//  - every Subscriber has its own read cursor, so consumers don't steal
+//    messages from each other
+//  - a subscriber that falls more than capacity() behind is overrun: it skips
+//    ahead to the oldest message still in the ring and counts what it lost
+//  - each slot is guarded by a seqlock stamp, which is why T must be
+//    trivially copyable (a torn copy is detected and discarded, never used)
+template<typename T>
+class BroadcastChannel final : public ChannelBase {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "BroadcastChannel<T> requires a trivially copyable T");
+
+public:
+    using value_type = T;
+    static constexpr ChannelKind kKind = ChannelKind::Broadcast;
+
+    ChannelKind kind() const override {
+        return kKind;
+    }
+
+    // Independent read cursor. One thread per Subscriber.
+    class Subscriber {
+    public:
+        Subscriber() = default;
+
+        // Next message in publish order. Returns false when caught up.
+        bool tryConsume(T& out) {
+            if (!ch_) return false;
+
+            for (;;) {
+                const ReadResult r = ch_->readAt(cursor_, out);
+                if (r == ReadResult::Ok) {
+                    ++cursor_;
+                    ch_->stats_.onConsume(1);
+                    return true;
+                }
+                if (r == ReadResult::Empty)
+                    return false;
+
+                skipToOldest();
+            }
+        }
+
+        // Newest message only; everything older is marked as read.
+        // Returns false if nothing was published since the last read.
+        bool tryLatest(T& out) {
+            if (!ch_) return false;
+
+            for (;;) {
+                const uint64_t head = ch_->head_.load(std::memory_order_acquire);
+                if (head == cursor_)
+                    return false;
+
+                if (ch_->readAt(head - 1, out) == ReadResult::Ok) {
+                    cursor_ = head;
+                    ch_->stats_.onConsume(1);
+                    return true;
+                }
+                // Writer lapped the slot while we copied it: retry with the new head
+            }
+        }
+
+        // Block until a message is pending or the timeout expires
+        bool waitFor(std::chrono::nanoseconds timeout) const {
+            if (!ch_) return false;
+            return waitUntil(ch_->signal(), [this] { return lag() > 0; }, timeout);
+        }
+
+        // Messages published but not yet read by this subscriber
+        uint64_t lag() const {
+            return ch_ ? ch_->head_.load(std::memory_order_acquire) - cursor_ : 0;
+        }
+
+        // Messages this subscriber lost because the producer lapped it
+        uint64_t overruns() const { return overruns_; }
+
+        explicit operator bool() const { return ch_ != nullptr; }
+
+    private:
+        friend class BroadcastChannel;
+        Subscriber(const BroadcastChannel* ch, uint64_t cursor) : ch_(ch), cursor_(cursor) {}
+
+        void skipToOldest() {
+            const uint64_t head = ch_->head_.load(std::memory_order_acquire);
+            const uint64_t cap  = ch_->capacity();
+            // The slot for `head` may be mid-write, so head - cap + 1 is the oldest safe one
+            const uint64_t oldest = head >= cap ? head - cap + 1 : 0;
+            if (oldest > cursor_) {
+                overruns_ += oldest - cursor_;
+                ch_->stats_.onDrop(oldest - cursor_);
+                cursor_ = oldest;
+            }
+        }
+
+        const BroadcastChannel* ch_ = nullptr;
+        uint64_t cursor_ = 0;
+        uint64_t overruns_ = 0;
+    };
+
+    // Capacity is rounded up to the next power of two
+    explicit BroadcastChannel(std::size_t capacity = 1024)
+        : mask_(roundUpPow2(capacity) - 1)
+        , slots_(new Slot[mask_ + 1])
+    {
+    }
+
+    BroadcastChannel(const BroadcastChannel&) = delete;
+    BroadcastChannel& operator=(const BroadcastChannel&) = delete;
+
+    // Producer thread only. Never blocks, never fails.
+    void publish(const T& msg) {
+        const uint64_t pos = head_.load(std::memory_order_relaxed);
+        Slot& s = slots_[pos & mask_];
+
+        s.stamp.store(pos * 2 + 1, std::memory_order_relaxed); // odd: being written
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&s.value, &msg, sizeof(T));
+        s.stamp.store(pos * 2 + 2, std::memory_order_release);  // even: message pos is ready
+
+        head_.store(pos + 1, std::memory_order_release);
+        tapPublished(&msg, 1);
+        stats_.onPublish(1, 0);
+        notifyPublished();
+    }
+
+    // New subscribers start at the next publish
+    Subscriber subscribe() const {
+        return Subscriber(this, head_.load(std::memory_order_acquire));
+    }
+
+    // Total messages published so far
+    uint64_t published() const {
+        return head_.load(std::memory_order_acquire);
+    }
+
+    std::size_t capacity() const { return mask_ + 1; }
+
+private:
+    enum class ReadResult { Ok, Empty, Overrun };
+
+    struct Slot {
+        std::atomic<uint64_t> stamp{0};
+        T value{};
+    };
+
+    static std::size_t roundUpPow2(std::size_t n) {
+        std::size_t p = 2;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    ReadResult readAt(uint64_t pos, T& out) const {
+        const Slot& s = slots_[pos & mask_];
+        const uint64_t want = pos * 2 + 2;
+
+        const uint64_t before = s.stamp.load(std::memory_order_acquire);
+        if (before < want) return ReadResult::Empty;   // not written yet (or mid-write)
+        if (before > want) return ReadResult::Overrun; // already reused for a later lap
+
+        // Copy to a temporary so a torn read never reaches the caller's value
+        T tmp;
+        std::memcpy(&tmp, &s.value, sizeof(T));
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (s.stamp.load(std::memory_order_relaxed) != want)
+            return ReadResult::Overrun; // overwritten while copying
+
+        out = tmp;
+        return ReadResult::Ok;
+    }
+
+private:
+    // Producer-owned, read by every subscriber
+    alignas(kCacheLineSize) std::atomic<uint64_t> head_{0};
+
+    // Read-only after construction
+    alignas(kCacheLineSize) const std::size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+};
+
+} // namespace msg
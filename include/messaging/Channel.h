@@ -3,51 +3,136 @@
 
 #include <queue>
 #include <mutex>
+#include <condition_variable>
 #include <vector>
 #include <utility>
+#include <chrono>
 
 #include "ChannelBase.h"
+#include "FixedBuffer.h"
 
 namespace msg {
 
 template<typename T>
 class Channel final : public ChannelBase {
 public:
+    using value_type = T;
+    static constexpr ChannelKind kKind = ChannelKind::Queue;
+
     ChannelKind kind() const override {
-        return ChannelKind::Queue;
+        return kKind;
     }
+
+    // Unbounded
     Channel() = default;
 
-    // Publish a message (copy)
-    void publish(const T& msg) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        queue_.push(msg);
+    // Bounded: at most `capacity` messages queued (0 = unbounded). Messages lost
+    // to the policy are counted in stats().dropped.
+    explicit Channel(std::size_t capacity,
+                     OverflowPolicy policy = OverflowPolicy::DropOldest,
+                     std::chrono::nanoseconds blockTimeout = std::chrono::milliseconds(1))
+        : capacity_(capacity), policy_(policy), blockTimeout_(blockTimeout) {}
+
+    // Publish a message (copy). Returns false if the overflow policy rejected it.
+    bool publish(const T& msg) {
+        return push(msg);
     }
 
     // Publish a message (move)
-    void publish(T&& msg) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        queue_.push(std::move(msg));
+    bool publish(T&& msg) {
+        return push(std::move(msg));
+    }
+
+    // Publish several messages under one lock. Returns the number published.
+    std::size_t publishBatch(const T* items, std::size_t count) {
+        if (count == 0) return 0;
+
+        const uint64_t t = ChannelStats::nowNs();
+        const auto deadline = std::chrono::steady_clock::now() + blockTimeout_;
+        std::size_t n = 0;
+        uint64_t evicted = 0;
+        std::size_t depthAfter;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            for (; n < count; ++n) {
+                if (!makeRoom(lock, deadline, evicted))
+                    break;
+                tapPublished(&items[n], 1);
+                queue_.push({items[n], t});
+            }
+            depthAfter = queue_.size();
+        }
+
+        if (evicted + (count - n) > 0)
+            stats_.onDrop(evicted + (count - n));
+        if (n > 0) {
+            stats_.onPublish(n, depthAfter);
+            notifyPublished();
+        }
+        return n;
+    }
+
+    template<std::size_t N>
+    std::size_t publishBatch(const FixedBuffer<T, N>& batch) {
+        return publishBatch(batch.data(), batch.size());
     }
 
     // Try to consume a single message (non-blocking)
     bool tryConsume(T& out) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (queue_.empty())
-            return false;
+        uint64_t stamp;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (queue_.empty())
+                return false;
 
-        out = std::move(queue_.front());
-        queue_.pop();
+            out = std::move(queue_.front().msg);
+            stamp = queue_.front().publishNs;
+            queue_.pop();
+        }
+        notifyConsumed();
+        stats_.onConsume(1);
+        stats_.onLatency(stamp, ChannelStats::nowNs());
         return true;
     }
 
     // Drain all messages into a vector (common for physics step)
     void drain(std::vector<T>& out) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        while (!queue_.empty()) {
-            out.push_back(std::move(queue_.front()));
-            queue_.pop();
+        consumeUpTo(static_cast<std::size_t>(-1), [&](T& m) { out.push_back(std::move(m)); });
+    }
+
+    // Move as many messages as fit into out under one lock. Returns the number moved.
+    template<std::size_t N>
+    std::size_t drainInto(FixedBuffer<T, N>& out) {
+        return consumeUpTo(out.remaining(), [&](T& m) { out.push_back(std::move(m)); });
+    }
+
+    // Hand up to maxCount messages to fn under one lock. fn runs with the
+    // lock held, so keep it short (copy out, don't do the work in it).
+    template<typename Fn>
+    std::size_t consumeUpTo(std::size_t maxCount, Fn&& fn) {
+        std::size_t n = 0;
+        ChannelStats::LatencyBatch lat;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const uint64_t now = ChannelStats::nowNs();
+            while (n < maxCount && !queue_.empty()) {
+                lat.add(queue_.front().publishNs, now);
+                fn(queue_.front().msg);
+                queue_.pop();
+                ++n;
+            }
+        }
+        if (n > 0) {
+            notifyConsumed();
+            stats_.onConsume(n);
+            stats_.onLatency(lat);
         }
+        return n;
+    }
+
+    // Block until a message is pending or the timeout expires (no polling)
+    bool waitFor(std::chrono::nanoseconds timeout) const {
+        return waitUntil(signal(), [this] { return size() > 0; }, timeout);
     }
 
     // For diagnostics / debugging only
@@ -56,9 +141,75 @@ public:
         return queue_.size();
     }
 
+    std::size_t capacity() const { return capacity_; } // 0 = unbounded
+    OverflowPolicy policy() const { return policy_; }
+
+protected:
+    std::size_t depth() const override { return size(); }
+
 private:
+    // Message plus its publish time, for queueing latency
+    struct Envelope {
+        T        msg;
+        uint64_t publishNs;
+    };
+
+    template<typename U>
+    bool push(U&& msg) {
+        const uint64_t t = ChannelStats::nowNs();
+        const auto deadline = std::chrono::steady_clock::now() + blockTimeout_;
+        uint64_t evicted = 0;
+        std::size_t depthAfter;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (!makeRoom(lock, deadline, evicted)) {
+                lock.unlock();
+                stats_.onDrop(1);
+                return false;
+            }
+            tapPublished(&msg, 1);
+            queue_.push({std::forward<U>(msg), t});
+            depthAfter = queue_.size();
+        }
+        if (evicted > 0)
+            stats_.onDrop(evicted);
+        stats_.onPublish(1, depthAfter);
+        notifyPublished();
+        return true;
+    }
+
+    // Lock held. Returns false if the incoming message has to be rejected.
+    bool makeRoom(std::unique_lock<std::mutex>& lock,
+                  std::chrono::steady_clock::time_point deadline,
+                  uint64_t& evicted) {
+        if (capacity_ == 0 || queue_.size() < capacity_)
+            return true;
+
+        switch (policy_) {
+            case OverflowPolicy::DropOldest:
+                queue_.pop();
+                ++evicted;
+                return true;
+            case OverflowPolicy::DropNewest:
+                return false;
+            case OverflowPolicy::Block:
+                return notFull_.wait_until(lock, deadline, [this] { return queue_.size() < capacity_; });
+        }
+        return false;
+    }
+
+    void notifyConsumed() {
+        if (policy_ == OverflowPolicy::Block && capacity_ > 0)
+            notFull_.notify_all();
+    }
+
     mutable std::mutex mutex_;
-    std::queue<T> queue_;
+    std::queue<Envelope> queue_;
+
+    std::size_t              capacity_     = 0;
+    OverflowPolicy           policy_       = OverflowPolicy::DropOldest;
+    std::chrono::nanoseconds blockTimeout_ = std::chrono::milliseconds(1);
+    std::condition_variable  notFull_;      // only used by OverflowPolicy::Block
 };
 
 } // namespace msg
@@ -1,17 +1,87 @@
 // messaging/ChannelBase.h
 #pragma once
 
+#include <cstddef>
+#include <type_traits>
+
+#include "ChannelStats.h"
+#include "WaitSignal.h"
+
 namespace msg {
 
 enum class ChannelKind {
     Queue,
-    Snapshot
+    Snapshot,
+    SpscRing,
+    Mailbox,
+    MpscRing,
+    Broadcast
+};
+
+// What a bounded Channel does when a publish finds it full.
+// The rings (SpscChannel / MpscChannel) always reject the new message.
+enum class OverflowPolicy {
+    DropOldest,   // evict the oldest queued message (keeps the freshest data)
+    DropNewest,   // reject the incoming message
+    Block         // wait for space up to the channel's block timeout, then reject
 };
 
+// Observer handed a raw copy of every published message (see messaging/Journal.h).
+// Runs on the publishing thread, so it must be short and must not block.
+using PublishTap = void (*)(void* ctx, const void* msg, std::size_t size);
+
 class ChannelBase {
 public:
     virtual ~ChannelBase() = default;
     virtual ChannelKind kind() const = 0;
+
+    // Bumped on every publish; consumers can sleep on it instead of polling
+    const WaitSignal& signal() const { return signal_; }
+
+    // Also bump a shared signal on publish (see Selector). Wire before threads start.
+    void attachSignal(WaitSignal* shared) { shared_ = shared; }
+
+    // Report every publish to fn. Only channels of trivially copyable T call it.
+    // Wire before threads start; one tap per channel.
+    void attachTap(PublishTap fn, void* ctx) { tap_ = fn; tapCtx_ = ctx; }
+
+    // Counters for diagnostics (all zero when MSG_CHANNEL_METRICS is 0)
+    ChannelStatsSnapshot stats() const {
+        ChannelStatsSnapshot s = stats_.snapshot();
+        s.depth = depth();
+        return s;
+    }
+
+protected:
+    // Messages currently waiting; latest-value channels have no backlog
+    virtual std::size_t depth() const { return 0; }
+
+    mutable ChannelStats stats_; // const read paths still count consumes
+
+    void notifyPublished() {
+        signal_.notify();
+        if (shared_)
+            shared_->notify();
+    }
+
+    // Called by publish paths once a message is accepted (one branch when no tap)
+    template<typename T>
+    void tapPublished(const T* items, std::size_t count) {
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            if (tap_) {
+                for (std::size_t i = 0; i < count; ++i)
+                    tap_(tapCtx_, &items[i], sizeof(T));
+            }
+        } else {
+            (void)items; (void)count;
+        }
+    }
+
+private:
+    WaitSignal  signal_;
+    WaitSignal* shared_ = nullptr;
+    PublishTap  tap_    = nullptr;
+    void*       tapCtx_ = nullptr;
 };
 
 } // namespace msg
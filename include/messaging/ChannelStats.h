@@ -0,0 +1,136 @@
+// messaging/ChannelStats.h
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// Build with -DMSG_CHANNEL_METRICS=0 to compile the counters out entirely
+#ifndef MSG_CHANNEL_METRICS
+#define MSG_CHANNEL_METRICS 1
+#endif
+
+namespace msg {
+
+// Keeps producer- and consumer-owned state on separate cache lines
+inline constexpr std::size_t kCacheLineSize = 64;
+
+// Plain copy of one channel's counters, safe to hand to the UI thread
+struct ChannelStatsSnapshot {
+    uint64_t published = 0;
+    uint64_t consumed  = 0;
+    uint64_t dropped   = 0;   // rejected on a full ring, or lost to a broadcast overrun
+
+    uint64_t depth     = 0;   // messages waiting right now (queue channels)
+    uint64_t peakDepth = 0;   // high-water mark since start
+
+    // Publish -> consume latency from the envelope timestamp
+    uint64_t latencySamples = 0;
+    double   meanLatencyUs  = 0.0;
+    double   maxLatencyUs   = 0.0;
+};
+
+// Relaxed atomic counters owned by every channel.
+//  - one relaxed RMW per publish / consume batch, no locks
+//  - publish-side and consume-side counters sit on separate cache lines, so
+//    stats don't undo the head / tail padding of the rings
+//  - latency uses a steady_clock stamp stored next to each message; batch
+//    consumers read the clock once per batch, not per message
+class ChannelStats {
+public:
+    // Local accumulator so a batch drain commits its latencies in one go
+    struct LatencyBatch {
+        uint64_t sumNs = 0;
+        uint64_t count = 0;
+        uint64_t maxNs = 0;
+
+        void add(uint64_t publishNs, uint64_t consumeNs) {
+#if MSG_CHANNEL_METRICS
+            if (publishNs == 0 || consumeNs < publishNs) return;
+            const uint64_t d = consumeNs - publishNs;
+            sumNs += d;
+            ++count;
+            if (d > maxNs) maxNs = d;
+#else
+            (void)publishNs; (void)consumeNs;
+#endif
+        }
+    };
+
+#if MSG_CHANNEL_METRICS
+    static uint64_t nowNs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    void onPublish(uint64_t n, std::size_t depthAfter) {
+        published_.fetch_add(n, std::memory_order_relaxed);
+        raise(peakDepth_, depthAfter);
+    }
+
+    void onDrop(uint64_t n = 1) {
+        dropped_.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    void onConsume(uint64_t n) {
+        consumed_.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    void onLatency(uint64_t publishNs, uint64_t consumeNs) {
+        LatencyBatch b;
+        b.add(publishNs, consumeNs);
+        onLatency(b);
+    }
+
+    void onLatency(const LatencyBatch& b) {
+        if (b.count == 0) return;
+        latencySumNs_.fetch_add(b.sumNs, std::memory_order_relaxed);
+        latencySamples_.fetch_add(b.count, std::memory_order_relaxed);
+        raise(latencyMaxNs_, b.maxNs);
+    }
+
+    ChannelStatsSnapshot snapshot() const {
+        ChannelStatsSnapshot s;
+        s.published = published_.load(std::memory_order_relaxed);
+        s.consumed  = consumed_.load(std::memory_order_relaxed);
+        s.dropped   = dropped_.load(std::memory_order_relaxed);
+        s.peakDepth = peakDepth_.load(std::memory_order_relaxed);
+
+        s.latencySamples = latencySamples_.load(std::memory_order_relaxed);
+        if (s.latencySamples > 0) {
+            s.meanLatencyUs = static_cast<double>(latencySumNs_.load(std::memory_order_relaxed))
+                            / static_cast<double>(s.latencySamples) / 1e3;
+        }
+        s.maxLatencyUs = static_cast<double>(latencyMaxNs_.load(std::memory_order_relaxed)) / 1e3;
+        return s;
+    }
+
+private:
+    static void raise(std::atomic<uint64_t>& peak, uint64_t v) {
+        uint64_t cur = peak.load(std::memory_order_relaxed);
+        while (v > cur && !peak.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {}
+    }
+
+    // Written by producers (dropped_ also by broadcast subscribers on overrun)
+    alignas(kCacheLineSize) std::atomic<uint64_t> published_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> peakDepth_{0};
+
+    // Written by the consumer; the class alignment pads this line out too
+    alignas(kCacheLineSize) std::atomic<uint64_t> consumed_{0};
+    std::atomic<uint64_t> latencySumNs_{0};
+    std::atomic<uint64_t> latencySamples_{0};
+    std::atomic<uint64_t> latencyMaxNs_{0};
+#else
+    static uint64_t nowNs() { return 0; }
+    void onPublish(uint64_t, std::size_t) {}
+    void onDrop(uint64_t = 1) {}
+    void onConsume(uint64_t) {}
+    void onLatency(uint64_t, uint64_t) {}
+    void onLatency(const LatencyBatch&) {}
+    ChannelStatsSnapshot snapshot() const { return {}; }
+#endif
+};
+
+} // namespace msg
@@ -0,0 +1,56 @@
+// messaging/FixedBuffer.h
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+namespace msg {
+
+// Inline, fixed-capacity batch buffer for publishBatch / drainInto.
+//  - storage lives inside the object (member or stack), never on the heap
+//  - push_back returns false instead of growing when full
+//  - clear() only resets the count; elements are overwritten on reuse
+template<typename T, std::size_t N>
+class FixedBuffer {
+    static_assert(N > 0, "FixedBuffer needs a non-zero capacity");
+
+public:
+    bool push_back(const T& v) {
+        if (size_ == N) return false;
+        items_[size_++] = v;
+        return true;
+    }
+
+    bool push_back(T&& v) {
+        if (size_ == N) return false;
+        items_[size_++] = std::move(v);
+        return true;
+    }
+
+    void clear() { size_ = 0; }
+
+    T*       data()       { return items_.data(); }
+    const T* data() const { return items_.data(); }
+
+    T*       begin()       { return items_.data(); }
+    T*       end()         { return items_.data() + size_; }
+    const T* begin() const { return items_.data(); }
+    const T* end()   const { return items_.data() + size_; }
+
+    T&       operator[](std::size_t i)       { return items_[i]; }
+    const T& operator[](std::size_t i) const { return items_[i]; }
+
+    std::size_t size() const { return size_; }
+    std::size_t remaining() const { return N - size_; }
+    bool empty() const { return size_ == 0; }
+    bool full()  const { return size_ == N; }
+
+    static constexpr std::size_t capacity() { return N; }
+
+private:
+    std::array<T, N> items_{};
+    std::size_t size_ = 0;
+};
+
+} // namespace msg
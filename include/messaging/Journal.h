@@ -0,0 +1,176 @@
+// messaging/Journal.h
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "MessageBus.h"
+#include "MpscChannel.h"
+
+namespace msg {
+
+// Binary journal of bus traffic for offline record / replay.
+//
+// File layout (little-endian, same build on both ends):
+//   JournalFileHeader
+//   JournalTopicEntry  x topicCount     (id, element size, name)
+//   { JournalRecordHeader, payload[size] } ...
+//
+// Messages are stored as raw bytes, so only trivially copyable message types
+// can be journaled (everything except world.snapshots today).
+
+inline constexpr char        kJournalMagic[8]   = {'B', 'U', 'S', 'J', 'R', 'N', 'L', '\0'};
+inline constexpr uint32_t    kJournalVersion    = 1;
+inline constexpr std::size_t kJournalMaxPayload = 256;
+
+struct JournalFileHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t topicCount;
+};
+
+struct JournalTopicEntry {
+    uint16_t id;
+    uint16_t elemSize;
+    char     name[60];
+};
+
+struct JournalRecordHeader {
+    uint64_t tNs;      // since recording started (steady clock)
+    uint16_t topic;
+    uint16_t size;
+    uint32_t reserved;
+};
+
+// One queued message on its way to the writer thread
+struct JournalRecord {
+    JournalRecordHeader header;
+    uint8_t payload[kJournalMaxPayload];
+};
+
+// ------------------------------------------------------------
+// Recorder: taps channels and streams them to disk from a writer thread.
+// The tap only copies into a lock-free queue, so publishers never touch the file.
+// ------------------------------------------------------------
+class JournalRecorder {
+public:
+    explicit JournalRecorder(std::size_t queueCapacity = 1 << 14);
+    ~JournalRecorder();
+
+    JournalRecorder(const JournalRecorder&) = delete;
+    JournalRecorder& operator=(const JournalRecorder&) = delete;
+
+    // Tap a topic. Wire before start() and before any thread publishes.
+    template<typename Topic>
+    void record(MessageBus& bus) {
+        using T = typename Topic::Channel::value_type;
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "Only trivially copyable messages can be journaled");
+        static_assert(sizeof(T) <= kJournalMaxPayload,
+                      "Message too large for the journal: raise kJournalMaxPayload");
+
+        JournalTopicEntry e{};
+        e.id = static_cast<uint16_t>(Topic::id);
+        e.elemSize = static_cast<uint16_t>(sizeof(T));
+        std::strncpy(e.name, Topic::name, sizeof(e.name) - 1);
+        topics_.push_back(e);
+
+        taps_.push_back(std::make_unique<TapContext>(TapContext{this, e.id}));
+        bus.get<Topic>().attachTap(&JournalRecorder::onTap, taps_.back().get());
+    }
+
+    // Open the file, write the header and start the writer thread
+    bool start(const std::string& path);
+
+    // Flush everything queued so far and close the file
+    void stop();
+
+    bool isRecording() const { return active_.load(std::memory_order_relaxed); }
+
+    uint64_t recorded() const { return written_.load(std::memory_order_relaxed); }
+    uint64_t dropped() const { return queue_.stats().dropped; } // writer fell behind
+
+private:
+    struct TapContext {
+        JournalRecorder* self;
+        uint16_t         topic;
+    };
+
+    static void onTap(void* ctx, const void* msg, std::size_t size);
+    void writerLoop();
+    std::size_t writeQueued();
+
+    std::vector<JournalTopicEntry>           topics_;
+    std::vector<std::unique_ptr<TapContext>> taps_;
+
+    MpscChannel<JournalRecord> queue_;
+    std::thread                writer_;
+    std::atomic<bool>          active_{false};
+    std::atomic<uint64_t>      written_{0};
+    uint64_t                   t0Ns_ = 0;
+    std::FILE*                 file_ = nullptr;
+};
+
+// ------------------------------------------------------------
+// Replayer: streams a journal back into bus channels.
+// ------------------------------------------------------------
+enum class ReplayTiming {
+    Original,        // reproduce the recorded gaps (scaled by speed)
+    AsFastAsPossible // publish back-to-back, for benchmarks / bisecting
+};
+
+class JournalReplayer {
+public:
+    JournalReplayer() = default;
+    ~JournalReplayer();
+
+    JournalReplayer(const JournalReplayer&) = delete;
+    JournalReplayer& operator=(const JournalReplayer&) = delete;
+
+    // Read the header and topic table
+    bool open(const std::string& path);
+
+    // Republish this topic's records into the bus. Returns false (and the topic
+    // is skipped) if the journal doesn't have it or its layout differs.
+    template<typename Topic>
+    bool route(MessageBus& bus) {
+        using T = typename Topic::Channel::value_type;
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "Only trivially copyable messages can be replayed");
+
+        if (!checkTopic(Topic::id, Topic::name, sizeof(T)))
+            return false;
+
+        auto& ch = bus.get<Topic>();
+        routes_[Topic::id] = [&ch](const uint8_t* payload) {
+            T m;
+            std::memcpy(&m, payload, sizeof(T));
+            ch.publish(m);
+        };
+        return true;
+    }
+
+    // Replay until the end of the journal or until running goes false.
+    // Returns the number of messages published.
+    std::size_t run(ReplayTiming timing, const std::atomic<bool>& running, double speed = 1.0);
+
+    const std::vector<JournalTopicEntry>& topics() const { return topics_; }
+
+private:
+    bool checkTopic(std::size_t id, const char* name, std::size_t size) const;
+
+    std::FILE* file_ = nullptr;
+    std::vector<JournalTopicEntry> topics_;
+    std::array<std::function<void(const uint8_t*)>, MessageBus::kMaxTopics> routes_{};
+};
+
+} // namespace msg
@@ -0,0 +1,121 @@
+// messaging/MailboxChannel.h
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+#include "ChannelBase.h"
+
+namespace msg {
+
+// Conflating "latest value" mailbox (triple buffer).
+//  - publish overwrites the pending value; it never blocks and never waits (wait-free)
+//  - tryRead returns only the newest value plus its version, intermediate values are dropped
+//  - one producer thread, one consumer thread (several readers on that thread are fine)
+template<typename T>
+class MailboxChannel final : public ChannelBase {
+public:
+    using value_type = T;
+    static constexpr ChannelKind kKind = ChannelKind::Mailbox;
+
+    ChannelKind kind() const override {
+        return kKind;
+    }
+
+    MailboxChannel() = default;
+
+    MailboxChannel(const MailboxChannel&) = delete;
+    MailboxChannel& operator=(const MailboxChannel&) = delete;
+
+    // Publish a message (copy) - producer thread only
+    void publish(const T& msg) {
+        slots_[back_].value = msg;
+        commit();
+    }
+
+    // Publish a message (move) - producer thread only
+    void publish(T&& msg) {
+        slots_[back_].value = std::move(msg);
+        commit();
+    }
+
+    // Copy the newest value into out if its version differs from lastVersion.
+    // Consumer thread only.
+    bool tryRead(T& out, uint64_t& lastVersion) {
+        acquireFront();
+
+        const Slot& s = slots_[front_];
+        if (s.version == lastVersion)
+            return false;
+
+        out = s.value;
+        lastVersion = s.version;
+
+        stats_.onConsume(1);
+        stats_.onLatency(s.publishNs, ChannelStats::nowNs());
+        return true;
+    }
+
+    // Block until a version newer than lastVersion is published or the timeout expires
+    bool waitForVersion(uint64_t lastVersion, std::chrono::nanoseconds timeout) const {
+        return waitUntil(signal(), [&] { return version() != lastVersion; }, timeout);
+    }
+
+    // Number of publishes so far (diagnostics / staleness checks)
+    uint64_t version() const {
+        return version_.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr uint8_t kIndexMask = 0x3;
+    static constexpr uint8_t kFresh     = 0x4; // middle slot holds an unread value
+
+    struct Slot {
+        T        value{};
+        uint64_t version = 0;
+        uint64_t publishNs = 0; // ChannelStats latency
+    };
+
+    void commit() {
+        const uint64_t v = version_.load(std::memory_order_relaxed) + 1;
+        slots_[back_].version = v;
+        slots_[back_].publishNs = ChannelStats::nowNs();
+        tapPublished(&slots_[back_].value, 1);
+
+        // Hand the written slot to the middle, take the old middle as the next back buffer
+        const uint8_t prev = middle_.exchange(
+            static_cast<uint8_t>(back_ | kFresh), std::memory_order_acq_rel);
+        back_ = prev & kIndexMask;
+
+        version_.store(v, std::memory_order_release);
+        stats_.onPublish(1, 0);
+        if (prev & kFresh)
+            stats_.onDrop(); // overwrote a value nobody read (conflated)
+        notifyPublished();
+    }
+
+    void acquireFront() {
+        if ((middle_.load(std::memory_order_relaxed) & kFresh) == 0)
+            return;
+
+        const uint8_t prev = middle_.exchange(front_, std::memory_order_acq_rel);
+        front_ = prev & kIndexMask;
+    }
+
+private:
+    Slot slots_[3];
+
+    // Producer-owned
+    alignas(kCacheLineSize) uint8_t back_ = 2;
+    std::atomic<uint64_t> version_{0};
+
+    // Shared hand-off index (+ fresh flag)
+    alignas(kCacheLineSize) std::atomic<uint8_t> middle_{1};
+
+    // Consumer-owned
+    alignas(kCacheLineSize) uint8_t front_ = 0;
+};
+
+} // namespace msg
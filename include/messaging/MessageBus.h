@@ -1,27 +1,84 @@
 #pragma once
 
+#include <array>
+#include <type_traits>
 #include <unordered_map>
 #include <memory>
 #include <string>
 #include <stdexcept>
+#include <utility>
+#include <vector>
+#include <algorithm>
 
 #include "Channel.h"
 #include "SnapshotChannel.h"
+#include "SpscChannel.h"
+#include "MailboxChannel.h"
+#include "MpscChannel.h"
+#include "BroadcastChannel.h"
 #include "ChannelBase.h"
 
 namespace msg {
 
+// One row of MessageBus::stats()
+struct ChannelStatsEntry {
+    std::string          name;
+    ChannelKind          kind;
+    ChannelStatsSnapshot stats;
+};
+
+inline const char* toString(ChannelKind k) {
+    switch (k) {
+        case ChannelKind::Queue:     return "queue";
+        case ChannelKind::Snapshot:  return "snapshot";
+        case ChannelKind::SpscRing:  return "spsc";
+        case ChannelKind::Mailbox:   return "mailbox";
+        case ChannelKind::MpscRing:  return "mpsc";
+        case ChannelKind::Broadcast: return "broadcast";
+    }
+    return "?";
+}
+
 class MessageBus {
 public:
+    // Upper bound on compile-time topic ids (see messaging/Topics.h)
+    static constexpr std::size_t kMaxTopics = 32;
+
     MessageBus() = default;
     ~MessageBus() = default;
 
+    MessageBus(const MessageBus&) = delete;
+    MessageBus& operator=(const MessageBus&) = delete;
+
+    // -----------------------------
+    // Typed topic lookup (compile-time registry)
+    // -----------------------------
+    // Topic is a tag type with:
+    //   using Channel = <channel type>;
+    //   static constexpr const char*  name;     // string key, still visible to channel()/etc.
+    //   static constexpr std::size_t  id;       // dense index < kMaxTopics
+    //   static constexpr std::size_t  capacity; // ring size / Channel bound, ignored otherwise
+    //   static constexpr OverflowPolicy policy; // Channel only
+    // After the first call this is an array index and a static_cast: no hashing, no RTTI.
+    template<typename Topic>
+    typename Topic::Channel& get() {
+        static_assert(Topic::id < kMaxTopics, "Topic id out of range: raise MessageBus::kMaxTopics");
+
+        ChannelBase*& slot = topics_[Topic::id];
+        if (!slot)
+            slot = &createTopic<Topic>();
+        return static_cast<typename Topic::Channel&>(*slot);
+    }
+
     // -----------------------------
     // Queue channel (commands)
     // -----------------------------
+    // capacity 0 = unbounded; otherwise policy decides what happens when full
     template<typename T>
-    Channel<T>& channel(const std::string& name) {
-        return getOrCreate<Channel<T>>(name, ChannelKind::Queue);
+    Channel<T>& channel(const std::string& name,
+                        std::size_t capacity = 0,
+                        OverflowPolicy policy = OverflowPolicy::DropOldest) {
+        return getOrCreate<Channel<T>>(name, ChannelKind::Queue, capacity, policy);
     }
 
     // -----------------------------
@@ -32,9 +89,78 @@ public:
         return getOrCreate<SnapshotChannel<T>>(name, ChannelKind::Snapshot);
     }
 
+    // -----------------------------
+    // Bounded SPSC ring (one writer thread, one reader thread)
+    // -----------------------------
+    template<typename T>
+    SpscChannel<T>& spsc(const std::string& name, std::size_t capacity = 1024) {
+        return getOrCreate<SpscChannel<T>>(name, ChannelKind::SpscRing, capacity);
+    }
+
+    // -----------------------------
+    // Latest-value mailbox (conflating, wait-free writer)
+    // -----------------------------
+    template<typename T>
+    MailboxChannel<T>& mailbox(const std::string& name) {
+        return getOrCreate<MailboxChannel<T>>(name, ChannelKind::Mailbox);
+    }
+
+    // -----------------------------
+    // Bounded MPSC ring (many writer threads, one reader thread)
+    // -----------------------------
+    template<typename T>
+    MpscChannel<T>& mpsc(const std::string& name, std::size_t capacity = 1024) {
+        return getOrCreate<MpscChannel<T>>(name, ChannelKind::MpscRing, capacity);
+    }
+
+    // -----------------------------
+    // Broadcast ring (one writer thread, independent subscriber cursors)
+    // -----------------------------
+    template<typename T>
+    BroadcastChannel<T>& broadcast(const std::string& name, std::size_t capacity = 1024) {
+        return getOrCreate<BroadcastChannel<T>>(name, ChannelKind::Broadcast, capacity);
+    }
+
+    // -----------------------------
+    // Diagnostics
+    // -----------------------------
+    // Counters for every registered channel, sorted by name. Reads only relaxed
+    // atomics, so any thread may call it once wiring in main() is finished.
+    std::vector<ChannelStatsEntry> stats() const {
+        std::vector<ChannelStatsEntry> out;
+        out.reserve(channels_.size());
+        for (const auto& [name, ch] : channels_)
+            out.push_back({name, ch->kind(), ch->stats()});
+
+        std::sort(out.begin(), out.end(),
+                  [](const ChannelStatsEntry& a, const ChannelStatsEntry& b) { return a.name < b.name; });
+        return out;
+    }
+
 private:
-    template<typename ChannelT>
-    ChannelT& getOrCreate(const std::string& name, ChannelKind expected) {
+    template<typename Topic>
+    typename Topic::Channel& createTopic() {
+        using ChannelT = typename Topic::Channel;
+
+        // Already created through the string API: that path checks the type
+        if (channels_.count(Topic::name))
+            return getOrCreate<ChannelT>(Topic::name, ChannelT::kKind);
+
+        std::unique_ptr<ChannelT> ch;
+        if constexpr (std::is_constructible<ChannelT, std::size_t, OverflowPolicy>::value)
+            ch = std::make_unique<ChannelT>(Topic::capacity, Topic::policy);
+        else if constexpr (std::is_constructible<ChannelT, std::size_t>::value)
+            ch = std::make_unique<ChannelT>(Topic::capacity);
+        else
+            ch = std::make_unique<ChannelT>();
+
+        ChannelT* raw = ch.get();
+        channels_[Topic::name] = std::move(ch);
+        return *raw;
+    }
+
+    template<typename ChannelT, typename... Args>
+    ChannelT& getOrCreate(const std::string& name, ChannelKind expected, Args&&... args) {
         auto it = channels_.find(name);
         if (it != channels_.end()) {
             if (it->second->kind() != expected)
@@ -47,7 +173,7 @@ private:
             return *typed;
         }
 
-        auto ch = std::make_unique<ChannelT>();
+        auto ch = std::make_unique<ChannelT>(std::forward<Args>(args)...);
         ChannelT* raw = ch.get();
         channels_[name] = std::move(ch);
         return *raw;
@@ -55,6 +181,7 @@ private:
 
 private:
     std::unordered_map<std::string, std::unique_ptr<ChannelBase>> channels_;
+    std::array<ChannelBase*, kMaxTopics> topics_{}; // non-owning, indexed by Topic::id
 };
 
 } // namespace msg
@@ -0,0 +1,245 @@
+// messaging/MpscChannel.h
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "ChannelBase.h"
+#include "FixedBuffer.h"
+
+namespace msg {
+
+// Bounded multi-producer / single-consumer ring channel.
+//  - any number of threads may publish concurrently (lock-free, one CAS per publish)
+//  - exactly one thread consumes; it drains in one batch without taking a lock
+//  - each cell carries a sequence number that tells producers and the consumer
+//    whether it is free, being written, or ready
+//  - publish returns false (message dropped) when the ring is full
+template<typename T>
+class MpscChannel final : public ChannelBase {
+public:
+    using value_type = T;
+    static constexpr ChannelKind kKind = ChannelKind::MpscRing;
+
+    ChannelKind kind() const override {
+        return kKind;
+    }
+
+    // Capacity is rounded up to the next power of two
+    explicit MpscChannel(std::size_t capacity = 1024)
+        : mask_(roundUpPow2(capacity) - 1)
+        , cells_(new Cell[mask_ + 1])
+    {
+        for (std::size_t i = 0; i <= mask_; ++i)
+            cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    MpscChannel(const MpscChannel&) = delete;
+    MpscChannel& operator=(const MpscChannel&) = delete;
+
+    // Publish a message (copy) - any thread
+    bool publish(const T& msg) {
+        return push(msg);
+    }
+
+    // Publish a message (move) - any thread
+    bool publish(T&& msg) {
+        return push(std::move(msg));
+    }
+
+    // Publish several messages with one CAS on the tail when the ring has room
+    // for all of them. Returns the number published - any thread
+    std::size_t publishBatch(const T* items, std::size_t count) {
+        if (count == 0) return 0;
+
+        std::size_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            // The consumer frees cells in order, so if the last cell of the
+            // range is free for this lap, every cell before it is too
+            const std::size_t last = pos + count - 1;
+            const std::size_t seq = cells_[last & mask_].seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(last);
+
+            if (diff < 0 || count > capacity()) {
+                // Not enough room for the whole batch: fall back to one at a time
+                std::size_t n = 0;
+                while (n < count && push(items[n])) ++n;
+                if (n < count)
+                    stats_.onDrop(count - n - 1); // push() already counted the first rejection
+                return n;
+            }
+            if (diff == 0 && tail_.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed))
+                break;
+            if (diff > 0)
+                pos = tail_.load(std::memory_order_relaxed); // raced with another producer
+        }
+
+        tapPublished(items, count);
+
+        const uint64_t t = ChannelStats::nowNs();
+        for (std::size_t i = 0; i < count; ++i) {
+            Cell& c = cells_[(pos + i) & mask_];
+            c.value = items[i];
+            c.publishNs = t;
+            c.seq.store(pos + i + 1, std::memory_order_release);
+        }
+        stats_.onPublish(count, depthAfter(pos + count));
+        notifyPublished();
+        return count;
+    }
+
+    template<std::size_t N>
+    std::size_t publishBatch(const FixedBuffer<T, N>& batch) {
+        return publishBatch(batch.data(), batch.size());
+    }
+
+    // Try to consume a single message (non-blocking) - consumer thread only
+    bool tryConsume(T& out) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        Cell& c = cells_[head & mask_];
+
+        if (c.seq.load(std::memory_order_acquire) != head + 1)
+            return false; // empty, or the producer that claimed it hasn't finished
+
+        out = std::move(c.value);
+        const uint64_t stamp = c.publishNs;
+        c.seq.store(head + mask_ + 1, std::memory_order_release);
+        head_.store(head + 1, std::memory_order_relaxed);
+
+        stats_.onConsume(1);
+        stats_.onLatency(stamp, ChannelStats::nowNs());
+        return true;
+    }
+
+    // Hand every ready message to fn in publish order, in place - consumer thread only.
+    // Returns the number of messages consumed.
+    template<typename Fn>
+    std::size_t consumeAll(Fn&& fn) {
+        return consumeUpTo(static_cast<std::size_t>(-1), std::forward<Fn>(fn));
+    }
+
+    // Same as consumeAll, but stops after maxCount messages
+    template<typename Fn>
+    std::size_t consumeUpTo(std::size_t maxCount, Fn&& fn) {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        const std::size_t start = head;
+        const uint64_t now = ChannelStats::nowNs();
+        ChannelStats::LatencyBatch lat;
+
+        while (head - start < maxCount) {
+            Cell& c = cells_[head & mask_];
+            if (c.seq.load(std::memory_order_acquire) != head + 1)
+                break;
+
+            lat.add(c.publishNs, now);
+            fn(c.value);
+            c.seq.store(head + mask_ + 1, std::memory_order_release);
+            ++head;
+        }
+
+        head_.store(head, std::memory_order_relaxed);
+
+        const std::size_t n = head - start;
+        if (n > 0) {
+            stats_.onConsume(n);
+            stats_.onLatency(lat);
+        }
+        return n;
+    }
+
+    // Drain all ready messages into a vector - consumer thread only
+    void drain(std::vector<T>& out) {
+        consumeAll([&](T& m) { out.push_back(std::move(m)); });
+    }
+
+    // Move as many ready messages as fit into out - consumer thread only
+    template<std::size_t N>
+    std::size_t drainInto(FixedBuffer<T, N>& out) {
+        return consumeUpTo(out.remaining(), [&](T& m) { out.push_back(std::move(m)); });
+    }
+
+    // Block until a message is pending or the timeout expires (no polling)
+    bool waitFor(std::chrono::nanoseconds timeout) const {
+        return waitUntil(signal(), [this] { return size() > 0; }, timeout);
+    }
+
+    // For diagnostics / debugging only (approximate while producers run)
+    std::size_t size() const {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+    std::size_t capacity() const { return mask_ + 1; }
+
+protected:
+    std::size_t depth() const override { return size(); }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> seq{0};
+        T value{};
+        uint64_t publishNs = 0; // ChannelStats latency
+    };
+
+    static std::size_t roundUpPow2(std::size_t n) {
+        std::size_t p = 2;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    // Consumer may already be past `end` if later producers finished first
+    std::size_t depthAfter(std::size_t end) const {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        return end > head ? end - head : 0;
+    }
+
+    template<typename U>
+    bool push(U&& msg) {
+        std::size_t pos = tail_.load(std::memory_order_relaxed);
+        Cell* c = nullptr;
+
+        for (;;) {
+            c = &cells_[pos & mask_];
+            const std::size_t seq = c->seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+            if (diff == 0) {
+                // Cell is free for this lap: claim it
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                stats_.onDrop();
+                return false; // full: consumer hasn't freed this cell yet
+            } else {
+                pos = tail_.load(std::memory_order_relaxed); // another producer got it
+            }
+        }
+
+        c->value = std::forward<U>(msg);
+        c->publishNs = ChannelStats::nowNs();
+        tapPublished(&c->value, 1);
+        c->seq.store(pos + 1, std::memory_order_release);
+        stats_.onPublish(1, depthAfter(pos + 1));
+        notifyPublished();
+        return true;
+    }
+
+private:
+    // Shared by producers
+    alignas(kCacheLineSize) std::atomic<std::size_t> tail_{0};
+
+    // Consumer-owned (atomic only so size() may peek)
+    alignas(kCacheLineSize) std::atomic<std::size_t> head_{0};
+
+    // Read-only after construction
+    alignas(kCacheLineSize) const std::size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+};
+
+} // namespace msg
@@ -0,0 +1,63 @@
+// messaging/Selector.h
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+#include "WaitSignal.h"
+
+namespace msg {
+
+// Wait on several queue channels at once (select/poll style).
+//  - add() attaches a shared signal to each channel, so a publish on any of
+//    them wakes the waiting thread
+//  - wait() returns the index of the first channel with pending messages,
+//    or -1 on timeout
+//  - a channel can only be attached to one Selector; wire before threads start
+class Selector {
+public:
+    Selector() = default;
+
+    Selector(const Selector&) = delete;
+    Selector& operator=(const Selector&) = delete;
+
+    // Works with any channel that has size(): Channel, SpscChannel, MpscChannel
+    template<typename ChannelT>
+    int add(ChannelT& ch) {
+        ch.attachSignal(&signal_);
+        entries_.push_back({ &ch, [](const void* p) {
+            return static_cast<const ChannelT*>(p)->size() > 0;
+        }});
+        return static_cast<int>(entries_.size()) - 1;
+    }
+
+    int wait(std::chrono::nanoseconds timeout) const {
+        int ready = -1;
+        waitUntil(signal_, [&] {
+            ready = firstReady();
+            return ready >= 0;
+        }, timeout);
+        return ready;
+    }
+
+    // Non-blocking poll
+    int firstReady() const {
+        for (std::size_t i = 0; i < entries_.size(); ++i) {
+            if (entries_[i].hasPending(entries_[i].channel))
+                return static_cast<int>(i);
+        }
+        return -1;
+    }
+
+private:
+    struct Entry {
+        const void* channel;
+        bool (*hasPending)(const void*);
+    };
+
+    WaitSignal signal_;
+    std::vector<Entry> entries_;
+};
+
+} // namespace msg
@@ -0,0 +1,41 @@
+// messaging/SharedMemory.h
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace msg {
+
+// Named shared-memory mapping visible to other processes on the same machine.
+//  - POSIX: shm_open + ftruncate + mmap (name becomes "/<name>")
+//  - Windows: CreateFileMapping / OpenFileMapping on the page file ("Local\<name>")
+// The creator owns the name and unlinks it on close (POSIX); openers only map it.
+class SharedMemoryRegion {
+public:
+    SharedMemoryRegion() = default;
+    ~SharedMemoryRegion();
+
+    SharedMemoryRegion(const SharedMemoryRegion&) = delete;
+    SharedMemoryRegion& operator=(const SharedMemoryRegion&) = delete;
+
+    // Create (or recreate) a zero-filled region of `bytes`
+    bool create(const std::string& name, std::size_t bytes);
+
+    // Map an existing region created by another process
+    bool open(const std::string& name, std::size_t bytes);
+
+    void close();
+
+    bool isOpen() const { return data_ != nullptr; }
+    void* data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+private:
+    void*       data_   = nullptr;
+    std::size_t size_   = 0;
+    void*       handle_ = nullptr; ///< Windows HANDLE; unused on POSIX
+    bool        owner_  = false;
+    std::string name_;
+};
+
+} // namespace msg
@@ -0,0 +1,106 @@
+// messaging/ShmBridge.h
+#pragma once
+
+#include <chrono>
+#include <string>
+
+#include "ShmRing.h"
+#include "Channel.h"
+#include "SnapshotChannel.h"
+#include "MpscChannel.h"
+#include "BroadcastChannel.h"
+#include "data/Commands.h"
+#include "data/HapticMessages.h"
+#include "data/WorldSnapshot.h"
+#include "data/WorldSnapshotWire.h"
+
+namespace msg {
+
+// Mirrors the renderer-facing topics between two processes over shared memory:
+//
+//   sim process (ShmExporter)                 renderer process (ShmImporter)
+//   world.snapshots   ── <prefix>.world ──▶   world.snapshots
+//   haptics.snapshots ── <prefix>.haptic ─▶   haptics.snapshots
+//   world.commands    ◀─ <prefix>.cmds ────   world.commands
+//   haptics.tool_in   ◀─ <prefix>.tool ────   haptics.tool_in
+//
+// Each side keeps its normal in-process channels; pump() copies between them
+// and the rings, so engines and the renderer don't know about the split.
+// Only the exporter creates regions: start the sim process first.
+
+inline constexpr const char* kShmDefaultPrefix = "hapticsim";
+
+// Ring sizes (both sides must agree)
+inline constexpr std::size_t kShmWorldSlots   = 4;      // latest-value, ~60 KB per slot
+inline constexpr std::size_t kShmHapticSlots  = 4096;   // ~4 s at 1 kHz
+inline constexpr std::size_t kShmCommandSlots = 1024;
+inline constexpr std::size_t kShmToolSlots    = 1024;
+
+class ShmExporter {
+public:
+    ShmExporter(SnapshotChannel<WorldSnapshot>& worldSnaps,
+                BroadcastChannel<HapticSnapshotMsg>& hapticSnaps,
+                MpscChannel<WorldCommand>& worldCmds,
+                Channel<ToolStateMsg>& toolIn);
+
+    bool create(const std::string& prefix = kShmDefaultPrefix);
+
+    // Forward one round in both directions. Returns true if anything moved.
+    bool pump();
+
+    // Sleep until a local haptic snapshot is pending (1 kHz, so this paces
+    // the pump) or the timeout expires. Renderer commands arrive through
+    // shared memory and can't wake us: keep the timeout short.
+    bool waitFor(std::chrono::nanoseconds timeout) const {
+        return hapticSub_.waitFor(timeout);
+    }
+
+private:
+    SnapshotChannel<WorldSnapshot>&      worldSnaps_;
+    MpscChannel<WorldCommand>&           worldCmds_;
+    Channel<ToolStateMsg>&               toolIn_;
+    BroadcastChannel<HapticSnapshotMsg>::Subscriber hapticSub_;
+
+    ShmBroadcastRing<WorldSnapshotWire>  worldRing_;
+    ShmBroadcastRing<HapticSnapshotMsg>  hapticRing_;
+    ShmSpscRing<WorldCommand>            cmdRing_;
+    ShmSpscRing<ToolStateMsg>            toolRing_;
+
+    uint64_t          worldVersion_ = 0;
+    WorldSnapshotWire wire_{};           // ~60 KB, kept off the stack
+};
+
+class ShmImporter {
+public:
+    ShmImporter(SnapshotChannel<WorldSnapshot>& worldSnaps,
+                BroadcastChannel<HapticSnapshotMsg>& hapticSnaps,
+                MpscChannel<WorldCommand>& worldCmds,
+                Channel<ToolStateMsg>& toolIn);
+
+    // Fails until the exporter process has created the regions
+    bool open(const std::string& prefix = kShmDefaultPrefix);
+
+    bool pump();
+
+    // Haptic snapshots lost because this process fell more than a ring behind
+    uint64_t hapticOverruns() const { return hapticReader_.overruns(); }
+
+private:
+    SnapshotChannel<WorldSnapshot>&      worldSnaps_;
+    BroadcastChannel<HapticSnapshotMsg>& hapticSnaps_;
+    MpscChannel<WorldCommand>&           worldCmds_;
+    Channel<ToolStateMsg>&               toolIn_;
+
+    ShmBroadcastRing<WorldSnapshotWire>  worldRing_;
+    ShmBroadcastRing<HapticSnapshotMsg>  hapticRing_;
+    ShmSpscRing<WorldCommand>            cmdRing_;
+    ShmSpscRing<ToolStateMsg>            toolRing_;
+
+    ShmBroadcastRing<WorldSnapshotWire>::Reader worldReader_;
+    ShmBroadcastRing<HapticSnapshotMsg>::Reader hapticReader_;
+
+    WorldSnapshotWire wire_{};
+    WorldSnapshot     snapshot_;         // reused so publish doesn't reallocate
+};
+
+} // namespace msg
@@ -0,0 +1,272 @@
+// messaging/ShmRing.h
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <type_traits>
+
+#include "ChannelBase.h"
+#include "SharedMemory.h"
+
+namespace msg {
+
+// Lock-free rings that live in a SharedMemoryRegion, for talking to another process.
+//  - T must be trivially copyable: it is copied byte-for-byte between address spaces
+//  - both processes must be built from the same source (layout is not versioned
+//    beyond elemSize / capacity checks)
+//  - the creating process owns the region; start it before the one that opens it
+
+namespace detail {
+
+inline constexpr uint32_t kShmRingMagic = 0x52424D53; // "SMBR"
+
+struct ShmRingHeader {
+    std::atomic<uint32_t> magic;    // set last by the creator (release)
+    uint32_t              elemSize;
+    uint64_t              capacity;
+
+    alignas(kCacheLineSize) std::atomic<uint64_t> head; // producer position
+    alignas(kCacheLineSize) std::atomic<uint64_t> tail; // SPSC consumer position
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "shared-memory rings need lock-free 64-bit atomics");
+
+inline std::size_t roundUpPow2(std::size_t n) {
+    std::size_t p = 2;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+} // namespace detail
+
+// ------------------------------------------------------------
+// Single producer, any number of reader processes / threads.
+// Same seqlock-per-slot scheme as BroadcastChannel: the producer never waits,
+// readers keep their own cursor and detect (and count) overruns.
+// ------------------------------------------------------------
+template<typename T>
+class ShmBroadcastRing {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "ShmBroadcastRing<T> requires a trivially copyable T");
+
+    struct Slot {
+        std::atomic<uint64_t> stamp;
+        T value;
+    };
+
+public:
+    class Reader {
+    public:
+        Reader() = default;
+
+        bool tryConsume(T& out) {
+            if (!ring_) return false;
+            for (;;) {
+                const int r = ring_->readAt(cursor_, out);
+                if (r == kOk) { ++cursor_; return true; }
+                if (r == kEmpty) return false;
+
+                const uint64_t head = ring_->hdr_->head.load(std::memory_order_acquire);
+                const uint64_t cap  = ring_->mask_ + 1;
+                const uint64_t oldest = head >= cap ? head - cap + 1 : 0;
+                if (oldest > cursor_) {
+                    overruns_ += oldest - cursor_;
+                    cursor_ = oldest;
+                }
+            }
+        }
+
+        bool tryLatest(T& out) {
+            if (!ring_) return false;
+            for (;;) {
+                const uint64_t head = ring_->hdr_->head.load(std::memory_order_acquire);
+                if (head == cursor_) return false;
+                if (ring_->readAt(head - 1, out) == kOk) {
+                    cursor_ = head;
+                    return true;
+                }
+            }
+        }
+
+        uint64_t overruns() const { return overruns_; }
+
+    private:
+        friend class ShmBroadcastRing;
+        Reader(const ShmBroadcastRing* ring, uint64_t cursor) : ring_(ring), cursor_(cursor) {}
+
+        const ShmBroadcastRing* ring_ = nullptr;
+        uint64_t cursor_ = 0;
+        uint64_t overruns_ = 0;
+    };
+
+    static std::size_t bytesFor(std::size_t capacity) {
+        return sizeof(detail::ShmRingHeader) + detail::roundUpPow2(capacity) * sizeof(Slot);
+    }
+
+    // Producer side
+    bool create(const std::string& name, std::size_t capacity) {
+        const std::size_t cap = detail::roundUpPow2(capacity);
+        if (!region_.create(name, bytesFor(cap)))
+            return false;
+
+        hdr_ = new (region_.data()) detail::ShmRingHeader{};
+        hdr_->elemSize = static_cast<uint32_t>(sizeof(T));
+        hdr_->capacity = cap;
+        slots_ = reinterpret_cast<Slot*>(hdr_ + 1);
+        mask_ = cap - 1;
+
+        // Region is zero-filled: every stamp starts at 0 (nothing written)
+        hdr_->magic.store(detail::kShmRingMagic, std::memory_order_release);
+        return true;
+    }
+
+    // Reader side. Fails if the producer hasn't created it yet or the layout differs.
+    bool open(const std::string& name, std::size_t capacity) {
+        const std::size_t cap = detail::roundUpPow2(capacity);
+        if (!region_.open(name, bytesFor(cap)))
+            return false;
+
+        auto* hdr = static_cast<detail::ShmRingHeader*>(region_.data());
+        if (hdr->magic.load(std::memory_order_acquire) != detail::kShmRingMagic ||
+            hdr->elemSize != sizeof(T) || hdr->capacity != cap) {
+            region_.close();
+            return false;
+        }
+
+        hdr_ = hdr;
+        slots_ = reinterpret_cast<Slot*>(hdr_ + 1);
+        mask_ = cap - 1;
+        return true;
+    }
+
+    bool isOpen() const { return hdr_ != nullptr; }
+
+    // Producer only
+    void publish(const T& msg) {
+        const uint64_t pos = hdr_->head.load(std::memory_order_relaxed);
+        Slot& s = slots_[pos & mask_];
+
+        s.stamp.store(pos * 2 + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&s.value, &msg, sizeof(T));
+        s.stamp.store(pos * 2 + 2, std::memory_order_release);
+
+        hdr_->head.store(pos + 1, std::memory_order_release);
+    }
+
+    // New readers start at the next publish
+    Reader reader() const {
+        return Reader(this, hdr_ ? hdr_->head.load(std::memory_order_acquire) : 0);
+    }
+
+private:
+    static constexpr int kOk = 0, kEmpty = 1, kOverrun = 2;
+
+    int readAt(uint64_t pos, T& out) const {
+        const Slot& s = slots_[pos & mask_];
+        const uint64_t want = pos * 2 + 2;
+
+        const uint64_t before = s.stamp.load(std::memory_order_acquire);
+        if (before < want) return kEmpty;
+        if (before > want) return kOverrun;
+
+        // T can be large (world snapshots): copy straight into out, the caller
+        // only trusts it when kOk comes back
+        std::memcpy(&out, &s.value, sizeof(T));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return s.stamp.load(std::memory_order_relaxed) == want ? kOk : kOverrun;
+    }
+
+    SharedMemoryRegion     region_;
+    detail::ShmRingHeader* hdr_   = nullptr;
+    Slot*                  slots_ = nullptr;
+    std::size_t            mask_  = 0;
+};
+
+// ------------------------------------------------------------
+// Single producer / single consumer queue between two processes
+// (e.g. renderer process -> world.commands). publish drops when full.
+// ------------------------------------------------------------
+template<typename T>
+class ShmSpscRing {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "ShmSpscRing<T> requires a trivially copyable T");
+
+public:
+    static std::size_t bytesFor(std::size_t capacity) {
+        return sizeof(detail::ShmRingHeader) + detail::roundUpPow2(capacity) * sizeof(T);
+    }
+
+    bool create(const std::string& name, std::size_t capacity) {
+        const std::size_t cap = detail::roundUpPow2(capacity);
+        if (!region_.create(name, bytesFor(cap)))
+            return false;
+
+        hdr_ = new (region_.data()) detail::ShmRingHeader{};
+        hdr_->elemSize = static_cast<uint32_t>(sizeof(T));
+        hdr_->capacity = cap;
+        slots_ = reinterpret_cast<T*>(hdr_ + 1);
+        mask_ = cap - 1;
+
+        hdr_->magic.store(detail::kShmRingMagic, std::memory_order_release);
+        return true;
+    }
+
+    bool open(const std::string& name, std::size_t capacity) {
+        const std::size_t cap = detail::roundUpPow2(capacity);
+        if (!region_.open(name, bytesFor(cap)))
+            return false;
+
+        auto* hdr = static_cast<detail::ShmRingHeader*>(region_.data());
+        if (hdr->magic.load(std::memory_order_acquire) != detail::kShmRingMagic ||
+            hdr->elemSize != sizeof(T) || hdr->capacity != cap) {
+            region_.close();
+            return false;
+        }
+
+        hdr_ = hdr;
+        slots_ = reinterpret_cast<T*>(hdr_ + 1);
+        mask_ = cap - 1;
+        return true;
+    }
+
+    bool isOpen() const { return hdr_ != nullptr; }
+
+    // Producer process only
+    bool publish(const T& msg) {
+        const uint64_t head = hdr_->head.load(std::memory_order_relaxed);
+        if (head - hdr_->tail.load(std::memory_order_acquire) > mask_)
+            return false; // full
+
+        std::memcpy(&slots_[head & mask_], &msg, sizeof(T));
+        hdr_->head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer process only. Hands up to maxCount messages to fn, frees them in one store.
+    template<typename Fn>
+    std::size_t consumeUpTo(std::size_t maxCount, Fn&& fn) {
+        const uint64_t tail = hdr_->tail.load(std::memory_order_relaxed);
+        uint64_t n = hdr_->head.load(std::memory_order_acquire) - tail;
+        if (n > maxCount) n = maxCount;
+
+        for (uint64_t i = 0; i < n; ++i)
+            fn(static_cast<const T&>(slots_[(tail + i) & mask_]));
+        if (n > 0)
+            hdr_->tail.store(tail + n, std::memory_order_release);
+        return static_cast<std::size_t>(n);
+    }
+
+private:
+    SharedMemoryRegion     region_;
+    detail::ShmRingHeader* hdr_   = nullptr;
+    T*                     slots_ = nullptr;
+    std::size_t            mask_  = 0;
+};
+
+} // namespace msg
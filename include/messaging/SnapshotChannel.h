@@ -1,36 +1,189 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#include "ChannelBase.h"
+
 namespace msg {
 
-template<typename T>
+// Single-producer / multi-consumer latest-value channel.
+//
+// The producer writes into a slot that is neither the current one nor pinned by
+// any reader, then publishes it. Readers pin a slot with a per-slot reference
+// count, so a slot is never overwritten while somebody is still reading it and
+// reads are always of one complete publish (no tearing).
+//
+// MaxReaders is the number of reader threads that may hold a handle at once.
+template<typename T, std::size_t MaxReaders = 4>
 class SnapshotChannel final : public ChannelBase {
+    // current slot + one slot per reader + one slot for the writer to fill
+    static constexpr uint32_t kSlots = static_cast<uint32_t>(MaxReaders) + 2;
+
 public:
+    using value_type = T;
+    static constexpr ChannelKind kKind = ChannelKind::Snapshot;
+
     ChannelKind kind() const override {
-        return ChannelKind::Snapshot;
+        return kKind;
     }
 
+    // Borrowed, zero-copy view of one published value.
+    // Keeps its slot pinned until destroyed, reset or reassigned.
+    class ReadHandle {
+    public:
+        ReadHandle() = default;
+        ~ReadHandle() { reset(); }
+
+        ReadHandle(const ReadHandle&) = delete;
+        ReadHandle& operator=(const ReadHandle&) = delete;
+
+        ReadHandle(ReadHandle&& o) noexcept
+            : ch_(o.ch_), slot_(o.slot_) {
+            o.ch_ = nullptr;
+        }
+
+        ReadHandle& operator=(ReadHandle&& o) noexcept {
+            if (this != &o) {
+                reset();
+                ch_ = o.ch_;
+                slot_ = o.slot_;
+                o.ch_ = nullptr;
+            }
+            return *this;
+        }
+
+        explicit operator bool() const { return ch_ != nullptr; }
+
+        const T& operator*() const  { return ch_->slots_[slot_].value; }
+        const T* operator->() const { return &ch_->slots_[slot_].value; }
+        const T* get() const        { return ch_ ? &ch_->slots_[slot_].value : nullptr; }
+
+        uint64_t version() const { return ch_ ? ch_->slots_[slot_].version : 0; }
+
+        void reset() {
+            if (ch_) {
+                ch_->refs_[slot_].fetch_sub(1, std::memory_order_release);
+                ch_ = nullptr;
+            }
+        }
+
+    private:
+        friend class SnapshotChannel;
+        ReadHandle(const SnapshotChannel* ch, uint32_t slot) : ch_(ch), slot_(slot) {}
+
+        const SnapshotChannel* ch_ = nullptr;
+        uint32_t slot_ = 0;
+    };
+
+    SnapshotChannel() = default;
+
+    SnapshotChannel(const SnapshotChannel&) = delete;
+    SnapshotChannel& operator=(const SnapshotChannel&) = delete;
+
+    // Producer thread only. Copy-assigns into a recycled slot, so containers
+    // inside T keep their capacity and steady-state publishes don't allocate.
     void publish(const T& msg) {
-        uint32_t writeIdx = 1 - readIdx_.load(std::memory_order_relaxed);
-        buffers_[writeIdx] = msg;
-        readIdx_.store(writeIdx, std::memory_order_release);
-        version_.fetch_add(1, std::memory_order_relaxed);
+        const uint32_t idx = acquireWriteSlot();
+        const uint64_t v = version_.load(std::memory_order_relaxed) + 1;
+
+        slots_[idx].value = msg;
+        slots_[idx].version = v;
+        slots_[idx].publishNs = ChannelStats::nowNs();
+        tapPublished(&slots_[idx].value, 1);
+
+        current_.store(idx, std::memory_order_seq_cst);
+        version_.store(v, std::memory_order_release);
+        stats_.onPublish(1, 0);
+        notifyPublished();
     }
 
-    bool tryRead(T& out, uint64_t& lastVersion) const {
+    // Pin the newest value. Returns an empty handle if nothing was published yet.
+    ReadHandle read() const {
+        if (version_.load(std::memory_order_acquire) == 0)
+            return {};
+
+        return ReadHandle(this, pinCurrent());
+    }
+
+    // Replace h with the newest value if its version differs from lastVersion.
+    // h keeps the old value (still pinned) when nothing new is available.
+    bool tryAcquire(ReadHandle& h, uint64_t& lastVersion) const {
         uint64_t v = version_.load(std::memory_order_acquire);
-        if (v == lastVersion)
+        if (v == lastVersion || v == 0)
             return false;
 
-        uint32_t idx = readIdx_.load(std::memory_order_acquire);
-        out = buffers_[idx];
-        lastVersion = v;
+        ReadHandle fresh(this, pinCurrent());
+        if (fresh.version() == lastVersion)
+            return false;
+
+        lastVersion = fresh.version();
+        stats_.onConsume(1);
+        stats_.onLatency(slots_[fresh.slot_].publishNs, ChannelStats::nowNs());
+        h = std::move(fresh);
         return true;
     }
 
+    // Copying read, kept for consumers that need their own copy.
+    bool tryRead(T& out, uint64_t& lastVersion) const {
+        ReadHandle h;
+        if (!tryAcquire(h, lastVersion))
+            return false;
+
+        out = *h;
+        return true;
+    }
+
+    // Block until a version newer than lastVersion is published or the timeout expires
+    bool waitForVersion(uint64_t lastVersion, std::chrono::nanoseconds timeout) const {
+        return waitUntil(signal(), [&] { return version() != lastVersion; }, timeout);
+    }
+
+    uint64_t version() const {
+        return version_.load(std::memory_order_acquire);
+    }
+
+private:
+    struct Slot {
+        T        value{};
+        uint64_t version = 0;
+        uint64_t publishNs = 0; // ChannelStats latency
+    };
+
+    uint32_t pinCurrent() const {
+        for (;;) {
+            const uint32_t idx = current_.load(std::memory_order_seq_cst);
+            refs_[idx].fetch_add(1, std::memory_order_seq_cst);
+
+            // Still current => the writer cannot pick it until we unpin
+            if (current_.load(std::memory_order_seq_cst) == idx)
+                return idx;
+
+            refs_[idx].fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    uint32_t acquireWriteSlot() {
+        const uint32_t cur = current_.load(std::memory_order_relaxed);
+        for (;;) {
+            for (uint32_t i = 0; i < kSlots; ++i) {
+                if (i != cur && refs_[i].load(std::memory_order_seq_cst) == 0)
+                    return i;
+            }
+            // Only reachable if more than MaxReaders threads hold handles
+            std::this_thread::yield();
+        }
+    }
+
 private:
-    T buffers_[2];
-    std::atomic<uint32_t> readIdx_{0};
+    Slot slots_[kSlots];
+    mutable std::atomic<uint32_t> refs_[kSlots]{};
+
+    alignas(kCacheLineSize) std::atomic<uint32_t> current_{0};
     std::atomic<uint64_t> version_{0};
 };
 
-}
\ No newline at end of file
+} // namespace msg
@@ -0,0 +1,195 @@
+// messaging/SpscChannel.h
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "ChannelBase.h"
+#include "FixedBuffer.h"
+
+namespace msg {
+
+// Bounded single-producer / single-consumer ring channel.
+//  - exactly one thread publishes, exactly one thread consumes
+//  - storage is allocated once up front, publish/consume never allocate
+//  - publish returns false (message dropped) when the ring is full
+template<typename T>
+class SpscChannel final : public ChannelBase {
+public:
+    using value_type = T;
+    static constexpr ChannelKind kKind = ChannelKind::SpscRing;
+
+    ChannelKind kind() const override {
+        return kKind;
+    }
+
+    // Capacity is rounded up to the next power of two
+    explicit SpscChannel(std::size_t capacity = 1024)
+        : mask_(roundUpPow2(capacity) - 1)
+        , slots_(new T[mask_ + 1])
+        , stamps_(new uint64_t[mask_ + 1]())
+    {}
+
+    SpscChannel(const SpscChannel&) = delete;
+    SpscChannel& operator=(const SpscChannel&) = delete;
+
+    // Publish a message (copy) - producer thread only
+    bool publish(const T& msg) {
+        return push(msg);
+    }
+
+    // Publish a message (move) - producer thread only
+    bool publish(T&& msg) {
+        return push(std::move(msg));
+    }
+
+    // Publish as many of items as fit with a single release of the tail.
+    // Returns the number published; the rest are dropped - producer thread only
+    std::size_t publishBatch(const T* items, std::size_t count) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        std::size_t space = capacity() - (tail - cachedHead_);
+        if (space < count) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            space = capacity() - (tail - cachedHead_);
+        }
+
+        const std::size_t n = count < space ? count : space;
+        if (n < count)
+            stats_.onDrop(count - n);
+        if (n == 0) return 0;
+
+        const uint64_t t = ChannelStats::nowNs();
+        for (std::size_t i = 0; i < n; ++i) {
+            slots_[(tail + i) & mask_] = items[i];
+            stamps_[(tail + i) & mask_] = t;
+        }
+        tapPublished(items, n);
+        tail_.store(tail + n, std::memory_order_release);
+        stats_.onPublish(n, tail + n - head_.load(std::memory_order_relaxed));
+        notifyPublished();
+        return n;
+    }
+
+    template<std::size_t N>
+    std::size_t publishBatch(const FixedBuffer<T, N>& batch) {
+        return publishBatch(batch.data(), batch.size());
+    }
+
+    // Try to consume a single message (non-blocking) - consumer thread only
+    bool tryConsume(T& out) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cachedTail_) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head == cachedTail_)
+                return false;
+        }
+
+        out = std::move(slots_[head & mask_]);
+        const uint64_t stamp = stamps_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+
+        stats_.onConsume(1);
+        stats_.onLatency(stamp, ChannelStats::nowNs());
+        return true;
+    }
+
+    // Drain all currently visible messages into a vector - consumer thread only
+    void drain(std::vector<T>& out) {
+        consumeUpTo(capacity(), [&](T& m) { out.push_back(std::move(m)); });
+    }
+
+    // Hand up to maxCount messages to fn in place, then free them with a
+    // single release of the head - consumer thread only
+    template<typename Fn>
+    std::size_t consumeUpTo(std::size_t maxCount, Fn&& fn) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        cachedTail_ = tail_.load(std::memory_order_acquire);
+
+        std::size_t n = cachedTail_ - head;
+        if (n > maxCount) n = maxCount;
+        if (n == 0) return 0;
+
+        const uint64_t now = ChannelStats::nowNs();
+        ChannelStats::LatencyBatch lat;
+        for (std::size_t i = 0; i < n; ++i) {
+            lat.add(stamps_[(head + i) & mask_], now);
+            fn(slots_[(head + i) & mask_]);
+        }
+        head_.store(head + n, std::memory_order_release);
+
+        stats_.onConsume(n);
+        stats_.onLatency(lat);
+        return n;
+    }
+
+    // Move as many messages as fit into out - consumer thread only
+    template<std::size_t N>
+    std::size_t drainInto(FixedBuffer<T, N>& out) {
+        return consumeUpTo(out.remaining(), [&](T& m) { out.push_back(std::move(m)); });
+    }
+
+    // Block until a message is pending or the timeout expires (no polling)
+    bool waitFor(std::chrono::nanoseconds timeout) const {
+        return waitUntil(signal(), [this] { return size() > 0; }, timeout);
+    }
+
+    // For diagnostics / debugging only (approximate while both sides run)
+    std::size_t size() const {
+        const std::size_t tail = tail_.load(std::memory_order_acquire);
+        const std::size_t head = head_.load(std::memory_order_acquire);
+        return tail - head;
+    }
+
+    std::size_t capacity() const { return mask_ + 1; }
+
+protected:
+    std::size_t depth() const override { return size(); }
+
+private:
+    static std::size_t roundUpPow2(std::size_t n) {
+        std::size_t p = 2;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    template<typename U>
+    bool push(U&& msg) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cachedHead_ > mask_) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail - cachedHead_ > mask_) {
+                stats_.onDrop();
+                return false; // full
+            }
+        }
+
+        slots_[tail & mask_] = std::forward<U>(msg);
+        stamps_[tail & mask_] = ChannelStats::nowNs();
+        tapPublished(&slots_[tail & mask_], 1);
+        tail_.store(tail + 1, std::memory_order_release);
+        stats_.onPublish(1, tail + 1 - head_.load(std::memory_order_relaxed));
+        notifyPublished();
+        return true;
+    }
+
+private:
+    // Producer-owned
+    alignas(kCacheLineSize) std::atomic<std::size_t> tail_{0};
+    std::size_t cachedHead_ = 0;
+
+    // Consumer-owned
+    alignas(kCacheLineSize) std::atomic<std::size_t> head_{0};
+    std::size_t cachedTail_ = 0;
+
+    // Shared, read-only after construction
+    alignas(kCacheLineSize) const std::size_t mask_;
+    std::unique_ptr<T[]> slots_;
+    std::unique_ptr<uint64_t[]> stamps_; // publish time per slot (ChannelStats latency)
+};
+
+} // namespace msg
@@ -0,0 +1,127 @@
+// messaging/Telemetry.h
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "MessageBus.h"
+#include "MpscChannel.h"
+#include "TelemetryWire.h"
+#include "UdpSocket.h"
+
+namespace msg {
+
+// Live telemetry: taps bus channels and streams (decimated) copies of their
+// messages to a UDP port, for plotting in external tools while a session runs.
+// Wire format: messaging/TelemetryWire.h.
+
+struct TelemetryConfig {
+    std::string host = "127.0.0.1";
+    uint16_t    port = kTelemetryDefaultPort;
+    std::size_t maxDatagramBytes = 1400;  ///< stays under a typical MTU
+    std::chrono::milliseconds flushInterval{10};
+};
+
+// One queued message on its way to the sender thread
+struct TelemetryRecord {
+    uint16_t stream;
+    uint16_t size;
+    uint8_t  payload[kTelemetryMaxPayload];
+};
+
+// ------------------------------------------------------------
+// Publisher: the tap only counts (decimation) and copies into a lock-free
+// queue, so producers never wait on the socket. A full queue drops the message.
+// ------------------------------------------------------------
+class TelemetryPublisher {
+public:
+    explicit TelemetryPublisher(std::size_t queueCapacity = 1 << 14);
+    ~TelemetryPublisher();
+
+    TelemetryPublisher(const TelemetryPublisher&) = delete;
+    TelemetryPublisher& operator=(const TelemetryPublisher&) = delete;
+
+    // Tap a topic, forwarding every `decimation`-th message.
+    // Wire before start() and before any thread publishes (one tap per channel,
+    // so a topic can't also be journaled).
+    template<typename Topic>
+    void stream(MessageBus& bus, uint32_t decimation = 1) {
+        using T = typename Topic::Channel::value_type;
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "Only trivially copyable messages can be streamed");
+        static_assert(sizeof(T) <= kTelemetryMaxPayload,
+                      "Message too large for telemetry: raise kTelemetryMaxPayload");
+
+        TelemetryStreamEntry e{};
+        e.id = static_cast<uint16_t>(Topic::id);
+        e.elemSize = static_cast<uint16_t>(sizeof(T));
+        e.decimation = decimation > 0 ? decimation : 1;
+        std::strncpy(e.name, Topic::name, sizeof(e.name) - 1);
+        streams_.push_back(e);
+
+        taps_.push_back(std::make_unique<TapContext>(this, e.id, e.decimation));
+        bus.get<Topic>().attachTap(&TelemetryPublisher::onTap, taps_.back().get());
+    }
+
+    // Open the socket and start the sender thread
+    bool start(const TelemetryConfig& cfg = {});
+
+    // Send what is queued and stop
+    void stop();
+
+    bool isRunning() const { return active_.load(std::memory_order_relaxed); }
+
+    uint64_t recordsSent() const { return recordsSent_.load(std::memory_order_relaxed); }
+    uint64_t datagramsSent() const { return datagramsSent_.load(std::memory_order_relaxed); }
+    uint64_t datagramsFailed() const { return datagramsFailed_.load(std::memory_order_relaxed); }
+    uint64_t dropped() const { return queue_.stats().dropped; } // sender fell behind
+
+private:
+    struct TapContext {
+        TapContext(TelemetryPublisher* s, uint16_t id, uint32_t d) : self(s), stream(id), decimation(d) {}
+        TelemetryPublisher*   self;
+        uint16_t              stream;
+        uint32_t              decimation;
+        std::atomic<uint32_t> seen{0};
+    };
+
+    // Partly filled datagram of one stream
+    struct Batch {
+        std::vector<uint8_t> buf;
+        uint16_t elemSize = 0;
+        uint16_t count = 0;
+        uint16_t capacity = 0;
+        uint32_t seq = 0;
+    };
+
+    static void onTap(void* ctx, const void* msg, std::size_t size);
+    void senderLoop();
+    std::size_t drainQueue();
+    void append(const TelemetryRecord& r);
+    void flush(uint16_t stream, Batch& b);
+    void flushAll();
+    void sendSchema();
+
+    std::vector<TelemetryStreamEntry>        streams_;
+    std::vector<std::unique_ptr<TapContext>> taps_;
+    std::vector<Batch>                       batches_; ///< indexed by topic id
+
+    TelemetryConfig            cfg_;
+    UdpSocket                  socket_;
+    MpscChannel<TelemetryRecord> queue_;
+    std::thread                sender_;
+    std::atomic<bool>          active_{false};
+    std::atomic<uint64_t>      recordsSent_{0};
+    std::atomic<uint64_t>      datagramsSent_{0};
+    std::atomic<uint64_t>      datagramsFailed_{0};
+    uint32_t                   schemaSeq_ = 0;
+};
+
+} // namespace msg
@@ -0,0 +1,42 @@
+// messaging/TelemetryWire.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace msg {
+
+// Datagram layout (little-endian, raw structs as in data/*.h):
+//   TelemetryDatagramHeader
+//   stream == kTelemetrySchemaStream: TelemetryStreamEntry x count
+//   otherwise:                        count x elemSize bytes of one stream's messages
+//
+// Each data datagram holds records of a single stream, packed up to
+// maxDatagramBytes and flushed at least every flushInterval. The schema
+// (stream ids, sizes and names) is re-sent every second so a receiver can
+// join at any time. seq counts datagrams per stream; gaps are losses.
+
+inline constexpr char        kTelemetryMagic[4]       = {'H', 'T', 'L', 'M'};
+inline constexpr uint16_t    kTelemetryVersion        = 1;
+inline constexpr uint16_t    kTelemetrySchemaStream   = 0xFFFF;
+inline constexpr std::size_t kTelemetryMaxPayload     = 256;
+inline constexpr uint16_t    kTelemetryDefaultPort    = 47800;
+
+struct TelemetryDatagramHeader {
+    char     magic[4];
+    uint16_t version;
+    uint16_t stream;    ///< topic id, or kTelemetrySchemaStream
+    uint32_t seq;       ///< per-stream datagram counter
+    uint16_t count;     ///< records (or schema entries) that follow
+    uint16_t elemSize;  ///< bytes per record
+    uint64_t sendNs;    ///< sender steady clock at send time
+};
+
+struct TelemetryStreamEntry {
+    uint16_t id;
+    uint16_t elemSize;
+    uint32_t decimation;  ///< 1 = every message, N = every Nth
+    char     name[56];
+};
+
+} // namespace msg
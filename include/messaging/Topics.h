@@ -0,0 +1,138 @@
+// messaging/Topics.h
+#pragma once
+
+#include <cstddef>
+
+#include "Channel.h"
+#include "SnapshotChannel.h"
+#include "SpscChannel.h"
+#include "MailboxChannel.h"
+#include "MpscChannel.h"
+#include "BroadcastChannel.h"
+#include "data/Commands.h"
+#include "data/WorldSnapshot.h"
+#include "data/HapticMessages.h"
+#include "data/LogMessages.h"
+
+namespace msg {
+
+// Compile-time topic: binds a channel type, a dense id and (for rings and
+// bounded queues) a capacity and overflow policy.
+// Derived tags add the string name. Look up with MessageBus::get<Tag>().
+template<typename ChannelT, std::size_t Id, std::size_t Capacity = 0,
+         OverflowPolicy Policy = OverflowPolicy::DropOldest>
+struct Topic {
+    using Channel = ChannelT;
+    static constexpr std::size_t id = Id;
+    static constexpr std::size_t capacity = Capacity;
+    static constexpr OverflowPolicy policy = Policy;
+};
+
+namespace topics {
+
+// ------------------------------------------------------------
+// World
+// ------------------------------------------------------------
+struct WorldCommands : Topic<MpscChannel<WorldCommand>, 0, 4096> {
+    static constexpr const char* name = "world.commands";
+};
+
+struct WorldSnapshots : Topic<SnapshotChannel<WorldSnapshot>, 1> {
+    static constexpr const char* name = "world.snapshots";
+};
+
+// ------------------------------------------------------------
+// Haptics
+// ------------------------------------------------------------
+// tool_in and wrenches are bounded (1024, evict oldest): a stalled consumer
+// can't grow them, and only the newest poses / wrenches matter
+struct HapticsToolIn : Topic<msg::Channel<ToolStateMsg>, 2, 1024> {
+    static constexpr const char* name = "haptics.tool_in";
+};
+
+// 1 kHz stream, ~4 s of history per subscriber
+struct HapticsSnapshots : Topic<BroadcastChannel<HapticSnapshotMsg>, 3, 4096> {
+    static constexpr const char* name = "haptics.snapshots";
+};
+
+struct HapticsWrenches : Topic<msg::Channel<HapticWrenchCmd>, 4, 1024> {
+    static constexpr const char* name = "haptics.wrenches";
+};
+
+// ------------------------------------------------------------
+// Device (latest-value only)
+// ------------------------------------------------------------
+struct DeviceToolIn : Topic<MailboxChannel<ToolStateMsg>, 5> {
+    static constexpr const char* name = "device.tool_in";
+};
+
+struct DeviceWrenchCmd : Topic<MailboxChannel<HapticWrenchCmd>, 6> {
+    static constexpr const char* name = "device.wrench_cmd";
+};
+
+// ------------------------------------------------------------
+// Logging (1 kHz single-writer / single-reader, ~65 s of slack, then drops newest)
+// ------------------------------------------------------------
+struct DeviceTimingLog : Topic<SpscChannel<DeviceTimingLogMsg>, 7, (1 << 16)> {
+    static constexpr const char* name = "logging.device_timing";
+};
+
+struct DeviceStateLog : Topic<SpscChannel<DeviceStateLogMsg>, 8, (1 << 16)> {
+    static constexpr const char* name = "logging.device_state";
+};
+
+struct SimValidationLog : Topic<SpscChannel<SimulationValidationLogMsg>, 9, (1 << 16)> {
+    static constexpr const char* name = "logging.sim_validation";
+};
+
+// ------------------------------------------------------------
+// Physics
+// ------------------------------------------------------------
+struct PhysicsHapticsWrenches : Topic<msg::Channel<HapticWrenchCmd>, 10, 1024> {
+    static constexpr const char* name = "physics.haptics_wrenches";
+};
+
+} // namespace topics
+
+// ------------------------------------------------------------
+// Registry checks: ids and names must be unique
+// ------------------------------------------------------------
+namespace detail {
+
+constexpr bool strEqual(const char* a, const char* b) {
+    while (*a != '\0' && *a == *b) { ++a; ++b; }
+    return *a == *b;
+}
+
+template<typename... Ts>
+constexpr bool topicsDistinct() {
+    constexpr std::size_t ids[] = { Ts::id... };
+    constexpr const char* names[] = { Ts::name... };
+    constexpr std::size_t n = sizeof...(Ts);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = i + 1; j < n; ++j) {
+            if (ids[i] == ids[j] || strEqual(names[i], names[j]))
+                return false;
+        }
+    }
+    return true;
+}
+
+} // namespace detail
+
+static_assert(detail::topicsDistinct<
+    topics::WorldCommands,
+    topics::WorldSnapshots,
+    topics::HapticsToolIn,
+    topics::HapticsSnapshots,
+    topics::HapticsWrenches,
+    topics::DeviceToolIn,
+    topics::DeviceWrenchCmd,
+    topics::DeviceTimingLog,
+    topics::DeviceStateLog,
+    topics::SimValidationLog,
+    topics::PhysicsHapticsWrenches
+>(), "Duplicate topic id or name in messaging/Topics.h");
+
+} // namespace msg
@@ -0,0 +1,41 @@
+// messaging/UdpSocket.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace msg {
+
+// Minimal IPv4 UDP socket (POSIX sockets / Winsock).
+// Sends are non-blocking: a full socket buffer drops the datagram instead of
+// stalling the caller.
+class UdpSocket {
+public:
+    UdpSocket() = default;
+    ~UdpSocket();
+
+    UdpSocket(const UdpSocket&) = delete;
+    UdpSocket& operator=(const UdpSocket&) = delete;
+
+    // Sender: fix the destination used by send()
+    bool connect(const std::string& host, uint16_t port);
+
+    // Receiver: listen on host:port
+    bool bind(const std::string& host, uint16_t port);
+
+    // Returns false if the datagram was not sent (buffer full, nobody listening, ...)
+    bool send(const void* data, std::size_t bytes);
+
+    // Wait up to timeoutMs for one datagram. Returns its size, 0 on timeout, -1 on error.
+    int receive(void* buf, std::size_t capacity, int timeoutMs);
+
+    void close();
+    bool isOpen() const { return sock_ != kInvalid; }
+
+private:
+    static constexpr intptr_t kInvalid = -1;
+    intptr_t sock_ = kInvalid; ///< int fd on POSIX, SOCKET on Windows
+};
+
+} // namespace msg
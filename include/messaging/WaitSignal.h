@@ -0,0 +1,61 @@
+// messaging/WaitSignal.h
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace msg {
+
+// Epoch counter that consumer threads can sleep on.
+//  - notify() bumps the epoch and only makes a syscall when someone is waiting
+//  - waitFor() blocks in the kernel (futex on Linux, WaitOnAddress on Windows)
+//    until the epoch moves past the value the caller last saw, or the timeout expires
+class WaitSignal {
+public:
+    WaitSignal() = default;
+
+    WaitSignal(const WaitSignal&) = delete;
+    WaitSignal& operator=(const WaitSignal&) = delete;
+
+    uint32_t epoch() const {
+        return epoch_.load(std::memory_order_seq_cst);
+    }
+
+    void notify() {
+        epoch_.fetch_add(1, std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_seq_cst) != 0)
+            wakeAll();
+    }
+
+    // Returns true if the epoch changed from `seen`, false on timeout
+    bool waitFor(uint32_t seen, std::chrono::nanoseconds timeout) const;
+
+private:
+    void wakeAll();
+
+    mutable std::atomic<uint32_t> epoch_{0};
+    mutable std::atomic<uint32_t> waiters_{0};
+};
+
+// Sleep on `signal` until ready() holds or the timeout expires.
+// ready() is re-checked after every wake, so spurious wakes are harmless.
+template<typename Pred>
+bool waitUntil(const WaitSignal& signal, Pred&& ready, std::chrono::nanoseconds timeout) {
+    using clock = std::chrono::steady_clock;
+    const auto deadline = clock::now() + timeout;
+
+    for (;;) {
+        const uint32_t seen = signal.epoch();
+        if (ready())
+            return true;
+
+        const auto now = clock::now();
+        if (now >= deadline)
+            return false;
+
+        signal.waitFor(seen, deadline - now);
+    }
+}
+
+} // namespace msg
@@ -0,0 +1,146 @@
+// metrics/HdrHistogram.h
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace metrics {
+
+// High-dynamic-range histogram of non-negative integers (nanoseconds here).
+//
+// Log-linear buckets: values below 2^(kSubBits+1) are counted exactly, above
+// that every power of two is split into 2^kSubBits linear sub-buckets, so any
+// recorded value is known to within 1 / 2^kSubBits (< 0.8 %) from 1 ns up to
+// kMaxValue (~68 s). Larger values are clamped into the top bucket; max()
+// stays exact.
+//
+//  - record() is a handful of integer ops plus relaxed atomic adds: safe to
+//    call from the 1 kHz loop, never blocks, no allocation
+//  - any thread may read (summary) or reset concurrently; a summary taken
+//    while recording is a consistent-enough view, not an atomic snapshot
+class HdrHistogram {
+public:
+    static constexpr unsigned    kSubBits     = 7;
+    static constexpr unsigned    kMaxBits     = 36;
+    static constexpr uint64_t    kMaxValue    = (uint64_t(1) << kMaxBits) - 1;
+    static constexpr uint64_t    kSubCount    = uint64_t(1) << kSubBits;
+    static constexpr std::size_t kBucketCount =
+        2 * kSubCount + (kMaxBits - kSubBits - 1) * kSubCount;
+
+    struct Summary {
+        uint64_t count = 0;
+        double   mean  = 0.0;
+        uint64_t p50   = 0;
+        uint64_t p99   = 0;
+        uint64_t p999  = 0;
+        uint64_t max   = 0;
+    };
+
+    void record(uint64_t v) {
+        counts_[indexOf(v)].fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(v, std::memory_order_relaxed);
+        uint64_t cur = max_.load(std::memory_order_relaxed);
+        while (v > cur && !max_.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {}
+    }
+
+    void reset() {
+        for (auto& c : counts_)
+            c.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+    // Smallest recorded value v such that at least q (0..1) of samples are <= v,
+    // reported as the top of its bucket
+    uint64_t valueAtQuantile(double q) const {
+        const double   qs[1] = {q};
+        uint64_t       out[1] = {0};
+        quantiles(qs, out, 1);
+        return out[0];
+    }
+
+    // One pass over the buckets for several quantiles (ascending order)
+    uint64_t quantiles(const double* q, uint64_t* out, std::size_t n) const {
+        uint64_t total = 0;
+        for (const auto& c : counts_)
+            total += c.load(std::memory_order_relaxed);
+
+        std::fill(out, out + n, 0);
+        if (total == 0)
+            return 0;
+
+        const uint64_t maxSeen = max_.load(std::memory_order_relaxed);
+        uint64_t seen = 0;
+        std::size_t k = 0;
+        for (std::size_t i = 0; i < kBucketCount && k < n; ++i) {
+            seen += counts_[i].load(std::memory_order_relaxed);
+            while (k < n && static_cast<double>(seen) >= q[k] * static_cast<double>(total)) {
+                out[k] = std::min(highestEquivalent(i), maxSeen);
+                ++k;
+            }
+        }
+        for (; k < n; ++k)
+            out[k] = maxSeen;
+        return total;
+    }
+
+    Summary summary() const {
+        static constexpr double qs[3] = {0.50, 0.99, 0.999};
+        uint64_t v[3];
+
+        Summary s;
+        s.count = quantiles(qs, v, 3);
+        s.p50  = v[0];
+        s.p99  = v[1];
+        s.p999 = v[2];
+        s.max  = max_.load(std::memory_order_relaxed);
+        if (s.count > 0)
+            s.mean = static_cast<double>(sum_.load(std::memory_order_relaxed)) / static_cast<double>(s.count);
+        return s;
+    }
+
+    // ---- bucket layout ----
+    static std::size_t indexOf(uint64_t v) {
+        if (v > kMaxValue) v = kMaxValue;
+        if (v < 2 * kSubCount)
+            return static_cast<std::size_t>(v);
+
+        const unsigned shift = msb(v) - kSubBits;       // >= 1
+        const uint64_t top = v >> shift;                // [kSubCount, 2 kSubCount)
+        return static_cast<std::size_t>(2 * kSubCount + (shift - 1) * kSubCount + (top - kSubCount));
+    }
+
+    static uint64_t highestEquivalent(std::size_t index) {
+        if (index < 2 * kSubCount)
+            return index;
+
+        const uint64_t rel   = index - 2 * kSubCount;
+        const unsigned shift = static_cast<unsigned>(rel / kSubCount) + 1;
+        const uint64_t top   = rel % kSubCount + kSubCount;
+        return ((top + 1) << shift) - 1;
+    }
+
+private:
+    static unsigned msb(uint64_t v) {
+#if defined(_MSC_VER)
+        unsigned long i;
+        _BitScanReverse64(&i, v);
+        return static_cast<unsigned>(i);
+#else
+        return 63u - static_cast<unsigned>(__builtin_clzll(v));
+#endif
+    }
+
+    std::array<std::atomic<uint64_t>, kBucketCount> counts_{};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+};
+
+} // namespace metrics
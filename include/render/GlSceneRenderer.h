@@ -23,7 +23,10 @@
 #include "messaging/Channel.h"
 #include "messaging/MessageBus.h"
 #include "messaging/SnapshotChannel.h"
+#include "messaging/BroadcastChannel.h"
+#include "messaging/MpscChannel.h"
 #include "data/Commands.h"
+#include "hardware/LoopLatency.h"
 
 class GlSceneRenderer : public ISceneRenderer {
     public:
@@ -32,9 +35,9 @@ class GlSceneRenderer : public ISceneRenderer {
             Window& window,
             const GeometryDatabase& geomDb,
             RenderMeshRegistry& meshRegistry,
-            msg::Channel<WorldCommand>& worldCmds,
+            msg::MpscChannel<WorldCommand>& worldCmds,
             msg::Channel<ToolStateMsg>& toolState,
-            msg::Channel<HapticSnapshotMsg>& hapticSnaps,
+            msg::BroadcastChannel<HapticSnapshotMsg>& hapticSnaps,
             msg::SnapshotChannel<WorldSnapshot>& worldSnaps
         );
         ~GlSceneRenderer() override;
@@ -49,6 +52,12 @@ class GlSceneRenderer : public ISceneRenderer {
         // void submit(const WorldSnapshot& world, const HapticSnapshot& haptic) override; // submit for rendering
         void render() override; // render submitted scene
 
+        // Optional: show per-channel counters from this bus in the "Channels" panel
+        void setChannelStatsSource(const msg::MessageBus* bus) { statsBus_ = bus; }
+
+        // Optional: show closed-loop latency percentiles in the "Loop latency" panel
+        void setLatencySource(LoopLatency* latency) { latency_ = latency; }
+
     private:
         Window& window_;
         Camera camera_;
@@ -62,16 +71,16 @@ class GlSceneRenderer : public ISceneRenderer {
         // ------------------------------------------------------------
         // Messaging inputs
         // ------------------------------------------------------------
-        msg::Channel<WorldCommand>&       worldCmds_;
+        msg::MpscChannel<WorldCommand>&   worldCmds_;
         msg::Channel<ToolStateMsg>&       toolState_;
-        msg::Channel<HapticSnapshotMsg>&  hapticSnaps_;
+        msg::BroadcastChannel<HapticSnapshotMsg>::Subscriber hapticSub_; // own cursor, shared with nobody
         msg::SnapshotChannel<WorldSnapshot>&      worldSnaps_;
 
         // ------------------------------------------------------------
         // Cached latest state (drained each frame)
         // ------------------------------------------------------------
         uint64_t worldSnapVersion_ = 0;
-        WorldSnapshot        latestWorld_{};
+        msg::SnapshotChannel<WorldSnapshot>::ReadHandle latestWorld_{}; // borrowed, read in place
         ToolStateMsg         latestTool_{};
         HapticSnapshotMsg    latestHaptics_{};
         // HapticSnapshot  haptic_{};
@@ -96,6 +105,18 @@ class GlSceneRenderer : public ISceneRenderer {
         UISceneStats      stats_;
         UIPanelConfig     cfg_;
 
+        // --- channel stats panel (refreshed a few times per second)
+        void refreshChannelStats();
+        const msg::MessageBus*       statsBus_ = nullptr;
+        std::vector<UIChannelStats>  channelStats_;
+        double                       channelStatsT_ = 0.0; // steady seconds at last refresh
+
+        // --- loop latency panel
+        void refreshLatencyStats();
+        LoopLatency*                 latency_ = nullptr;
+        std::vector<UILatencyStats>  latencyStats_;
+        double                       latencyStatsT_ = 0.0;
+
         void initUICommands();
 
         // --- per-frame state
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "render/gpu/MeshGPU.h"
+#include "geometry/TriMesh.h"
 #include <unordered_map>
 #include <cstdint>
 
@@ -20,6 +21,9 @@ public:
     // GeometryFactory-facing API
     RenderMeshHandle getOrCreate(MeshKind kind);
 
+    // Loaded meshes are not shared by kind: one handle per call
+    RenderMeshHandle createTriMesh(const TriMesh& mesh);
+
     // RenderingEngine-facing API
     const MeshGPU* get(RenderMeshHandle handle) const;
 
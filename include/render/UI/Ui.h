@@ -41,6 +41,32 @@ struct UISceneStats {
     float fps = 0.f;
 };
 
+// One message-bus channel row (filled from MessageBus::stats() by the renderer)
+struct UIChannelStats {
+    std::string name;
+    const char* kind = "";
+    uint64_t published = 0;
+    uint64_t consumed  = 0;
+    uint64_t dropped   = 0;
+    uint64_t depth     = 0;
+    uint64_t peakDepth = 0;
+    float publishRate  = 0.f; // msgs/s over the last refresh window
+    float consumeRate  = 0.f;
+    float meanLatencyUs = 0.f;
+    float maxLatencyUs  = 0.f;
+};
+
+// One closed-loop latency row (filled from LoopLatency by the renderer)
+struct UILatencyStats {
+    const char* stage = "";
+    uint64_t count = 0;
+    float meanUs = 0.f;
+    float p50Us  = 0.f;
+    float p99Us  = 0.f;
+    float p999Us = 0.f;
+    float maxUs  = 0.f;
+};
+
 // --- Commands the UI can emit (provided by caller) ---
 struct UICommands {
     // Body
@@ -73,6 +99,9 @@ struct UICommands {
     std::function<void(float)> setScrollZoomSpeed  = {};
     std::function<void(bool)>  setInvertY          = {};
     std::function<void(bool)>  setRmbToLook        = {};
+
+    // Loop latency panel
+    std::function<void()> resetLatencyStats = {};
 };
 
 // --- UI Panel configuration ---
@@ -103,6 +132,8 @@ public:
     void drawCameraPanel(const UICameraState& camState);
     void drawControllerPanel(const UIControllerState& ctrlState); 
     void drawDebugPanel(const UISceneStats& stats);
+    void drawChannelPanel(const std::vector<UIChannelStats>& channels);
+    void drawLatencyPanel(const std::vector<UILatencyStats>& stages);
 
 private:
     UICommands cmds_;
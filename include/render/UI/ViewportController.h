@@ -5,13 +5,14 @@
 #include "render/Camera.h"
 #include "data/HapticMessages.h"
 #include "messaging/Channel.h"
+#include "messaging/BroadcastChannel.h"
 
 class ViewportController {
 public:
     // RenderingEngine owns Window and Camera
     ViewportController(Window& w, Camera& c,             
             msg::Channel<ToolStateMsg>& toolState,
-            msg::Channel<HapticSnapshotMsg>& hapticSnaps);
+            msg::BroadcastChannel<HapticSnapshotMsg>& hapticSnaps);
 
     ViewportController(const ViewportController&) = delete;
     ViewportController& operator=(const ViewportController&) = delete;
@@ -66,7 +67,7 @@ private:
     bool  rmbToLook_        = true;
 
     msg::Channel<ToolStateMsg>&      toolState_;
-    msg::Channel<HapticSnapshotMsg>& hapticSnaps_;
+    msg::BroadcastChannel<HapticSnapshotMsg>::Subscriber hapticSub_;
 
     HapticSnapshotMsg latestHaptics_{};
     ToolStateMsg      latestTool_{};    
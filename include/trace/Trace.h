@@ -0,0 +1,129 @@
+// trace/Trace.h
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Hot-path tracing: scoped spans and counters recorded into a per-thread ring,
+// exported as Chrome trace JSON (chrome://tracing, ui.perfetto.dev).
+//
+//  - recording is one thread_local lookup, two steady_clock reads and a
+//    32-byte store into the calling thread's own ring: no locks, no allocation,
+//    no contention between threads. The ring is allocated by setThreadName,
+//    which every thread calls at startup (otherwise by its first event).
+//  - rings overwrite their oldest events, so a long run keeps the last
+//    kTraceRingEvents per thread
+//  - names must be string literals (only the pointer is stored)
+//  - while disabled (the default) a span is a single relaxed load;
+//    build with TRACE_ENABLED=0 to compile the macros out entirely
+
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED 1
+#endif
+
+namespace trace {
+
+inline constexpr std::size_t kTraceRingEvents = 1 << 16; // per thread, power of two
+
+enum class EventType : uint8_t { Span, Counter, Instant };
+
+struct Event {
+    const char* name;
+    uint64_t    startNs;    // steady clock
+    union {
+        uint64_t durNs;     // Span
+        double   value;     // Counter
+    };
+    EventType   type;
+};
+
+namespace detail {
+
+extern std::atomic<bool> g_enabled;
+
+inline uint64_t nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Append to the calling thread's ring (created and registered on first use)
+void record(const Event& e);
+
+} // namespace detail
+
+inline bool enabled() { return detail::g_enabled.load(std::memory_order_relaxed); }
+
+// Start / stop recording. Events from before enable() are not exported.
+void enable();
+void disable();
+
+// Label for the calling thread in the exported trace ("haptics", "device", ...).
+// Also allocates the thread's ring (kTraceRingEvents events), so call it
+// before the thread's loop starts.
+void setThreadName(const char* name);
+
+// Write every thread's ring as Chrome trace JSON. Safe while threads are
+// still recording: events overwritten during the copy are left out.
+bool writeChromeJson(const std::string& path);
+
+inline void counter(const char* name, double value) {
+    if (!enabled()) return;
+    Event e;
+    e.name = name;
+    e.startNs = detail::nowNs();
+    e.value = value;
+    e.type = EventType::Counter;
+    detail::record(e);
+}
+
+inline void instant(const char* name) {
+    if (!enabled()) return;
+    Event e;
+    e.name = name;
+    e.startNs = detail::nowNs();
+    e.durNs = 0;
+    e.type = EventType::Instant;
+    detail::record(e);
+}
+
+// RAII span: [construction, destruction)
+class Scope {
+public:
+    explicit Scope(const char* name)
+        : name_(name), startNs_(enabled() ? detail::nowNs() : 0) {}
+
+    ~Scope() {
+        if (startNs_ == 0) return; // tracing was off when the span opened
+        Event e;
+        e.name = name_;
+        e.startNs = startNs_;
+        e.durNs = detail::nowNs() - startNs_;
+        e.type = EventType::Span;
+        detail::record(e);
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    const char* name_;
+    uint64_t    startNs_;
+};
+
+} // namespace trace
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#if TRACE_ENABLED
+#define TRACE_SCOPE(name)           ::trace::Scope TRACE_CONCAT(traceScope_, __LINE__)(name)
+#define TRACE_COUNTER(name, value)  ::trace::counter(name, static_cast<double>(value))
+#define TRACE_INSTANT(name)         ::trace::instant(name)
+#else
+#define TRACE_SCOPE(name)           ((void)0)
+#define TRACE_COUNTER(name, value)  ((void)0)
+#define TRACE_INSTANT(name)         ((void)0)
+#endif
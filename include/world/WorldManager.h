@@ -5,7 +5,7 @@
 #include "data/Commands.h"
 #include "geometry/GeometryFactory.h"
 #include <unordered_map>
-#include "messaging/Channel.h"
+#include "messaging/MpscChannel.h"
 #include "world/WorldDirty.h"
 #include "data/PhysicsProps.h"
 
@@ -14,7 +14,7 @@ class WorldManager {
 public:
     WorldManager(const GeometryDatabase& geomDb,
                  GeometryFactory& geomFactory,
-                 msg::Channel<WorldCommand>& worldCmds
+                 msg::MpscChannel<WorldCommand>& worldCmds
                     );
 
     // Apply a single world mutation command
@@ -70,6 +70,6 @@ private:
     const GeometryDatabase& geomDb_;
     GeometryFactory& geomFactory_;
 
-    msg::Channel<WorldCommand>& worldCmds_;
+    msg::MpscChannel<WorldCommand>& worldCmds_;
 
 };
@@ -0,0 +1,202 @@
+#include "analysis/CsvTable.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+namespace analysis {
+
+namespace {
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+// Below this a single worker is faster than starting threads
+constexpr std::size_t kMinBytesPerWorker = 1 << 20;
+
+bool readWholeFile(const std::string& path, std::vector<char>& out) {
+    std::error_code ec;
+    const auto bytes = std::filesystem::file_size(path, ec);
+    std::FILE* f = ec ? nullptr : std::fopen(path.c_str(), "rb");
+    if (!f)
+        return false;
+
+    out.resize(static_cast<std::size_t>(bytes));
+    out.resize(std::fread(out.data(), 1, out.size(), f));
+    std::fclose(f);
+    return true;
+}
+
+const char* lineEnd(const char* p, const char* end) {
+    const void* nl = std::memchr(p, '\n', static_cast<std::size_t>(end - p));
+    return nl ? static_cast<const char*>(nl) : end;
+}
+
+// Start of the line after p's, or end
+const char* nextLine(const char* p, const char* end) {
+    const char* eol = lineEnd(p, end);
+    return eol < end ? eol + 1 : end;
+}
+
+std::string trimName(const char* b, const char* e) {
+    while (b < e && (*b == ' ' || *b == '"' || *b == '\t'))
+        ++b;
+    while (e > b && (e[-1] == ' ' || e[-1] == '"' || e[-1] == '\r' || e[-1] == '\t'))
+        --e;
+    return std::string(b, e);
+}
+
+// Parse [begin, end) - whole lines only - into per-column vectors
+void parseSlice(const char* begin, const char* end, std::size_t colCount,
+                std::vector<std::vector<double>>& cols) {
+    std::size_t lines = 0;
+    for (const char* p = begin; p < end; p = nextLine(p, end))
+        ++lines;
+
+    cols.assign(colCount, {});
+    for (auto& c : cols)
+        c.reserve(lines);
+
+    for (const char* p = begin; p < end;) {
+        const char* eol = lineEnd(p, end);
+        const char* stop = (eol > p && eol[-1] == '\r') ? eol - 1 : eol;
+
+        if (stop > p) { // blank lines carry no row
+            for (std::size_t c = 0; c < colCount; ++c) {
+                while (p < stop && *p == ' ')
+                    ++p;
+
+                double v = kNaN;
+                const auto r = std::from_chars(p, stop, v);
+                if (r.ec != std::errc())
+                    v = kNaN;
+                p = r.ptr;
+
+                while (p < stop && *p != ',') // quoted or trailing junk
+                    ++p;
+                if (p < stop)
+                    ++p;
+
+                cols[c].push_back(v);
+            }
+        }
+        p = eol < end ? eol + 1 : end;
+    }
+}
+
+} // namespace
+
+bool CsvTable::load(const std::string& path, unsigned threads) {
+    path_ = path;
+    names_.clear();
+    cols_.clear();
+    rows_ = 0;
+
+    std::vector<char> buf;
+    if (!readWholeFile(path, buf)) {
+        std::cerr << "CsvTable: cannot open " << path << "\n";
+        return false;
+    }
+
+    const char* const begin = buf.data();
+    const char* const end = begin + buf.size();
+
+    const char* headerEnd = lineEnd(begin, end);
+    for (const char* p = begin;;) {
+        const char* comma = static_cast<const char*>(
+            std::memchr(p, ',', static_cast<std::size_t>(headerEnd - p)));
+        names_.push_back(trimName(p, comma ? comma : headerEnd));
+        if (!comma)
+            break;
+        p = comma + 1;
+    }
+    if (names_.size() == 1 && names_[0].empty()) {
+        std::cerr << "CsvTable: " << path << " has no header\n";
+        names_.clear();
+        return false;
+    }
+    if (names_.back().empty()) // trailing comma
+        names_.pop_back();
+
+    const char* body = nextLine(begin, end);
+    const std::size_t bodyBytes = static_cast<std::size_t>(end - body);
+
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t workers = std::max<std::size_t>(
+        1, std::min<std::size_t>(threads, bodyBytes / kMinBytesPerWorker));
+
+    // Slice boundaries, each moved forward to the start of a line
+    std::vector<const char*> cut(workers + 1, end);
+    cut[0] = body;
+    for (std::size_t w = 1; w < workers; ++w) {
+        const char* p = body + bodyBytes * w / workers;
+        p = std::max(p, cut[w - 1]);
+        cut[w] = nextLine(p, end);
+    }
+
+    std::vector<std::vector<std::vector<double>>> parts(workers);
+    if (workers == 1) {
+        parseSlice(cut[0], cut[1], names_.size(), parts[0]);
+    } else {
+        std::vector<std::thread> pool;
+        pool.reserve(workers);
+        for (std::size_t w = 0; w < workers; ++w)
+            pool.emplace_back(parseSlice, cut[w], cut[w + 1], names_.size(), std::ref(parts[w]));
+        for (auto& t : pool)
+            t.join();
+    }
+
+    for (const auto& part : parts)
+        rows_ += part.empty() ? 0 : part[0].size();
+
+    cols_.resize(names_.size());
+    for (std::size_t c = 0; c < names_.size(); ++c) {
+        if (workers == 1) {
+            cols_[c] = std::move(parts[0][c]);
+            continue;
+        }
+        cols_[c].reserve(rows_);
+        for (const auto& part : parts)
+            cols_[c].insert(cols_[c].end(), part[c].begin(), part[c].end());
+    }
+    missing_.assign(rows_, kNaN);
+    return true;
+}
+
+const std::vector<double>* CsvTable::find(const char* name) const {
+    for (std::size_t c = 0; c < names_.size(); ++c) {
+        if (names_[c] == name)
+            return &cols_[c];
+    }
+    return nullptr;
+}
+
+const std::vector<double>& CsvTable::col(const char* name) const {
+    if (const auto* c = find(name))
+        return *c;
+
+    std::cerr << "CsvTable: " << path_ << " has no column '" << name << "'\n";
+    return missing_;
+}
+
+void CsvTable::filter(const std::vector<bool>& keep) {
+    std::size_t kept = 0;
+    for (auto& c : cols_) {
+        kept = 0;
+        for (std::size_t r = 0; r < c.size(); ++r) {
+            if (r < keep.size() && keep[r])
+                c[kept++] = c[r];
+        }
+        c.resize(kept);
+    }
+    rows_ = cols_.empty() ? 0 : kept;
+    missing_.assign(rows_, kNaN);
+}
+
+} // namespace analysis
@@ -0,0 +1,959 @@
+#include "analysis/Reports.h"
+#include "analysis/Stats.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <charconv>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <future>
+#include <iostream>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace analysis {
+
+namespace {
+
+namespace fs = std::filesystem;
+
+// printf into the report's console text
+void say(std::ostream& out, const char* fmt, ...) {
+    char buf[512];
+    va_list args;
+    va_start(args, fmt);
+    std::vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    out << buf;
+}
+
+void banner(std::ostream& out, const char* title) {
+    out << "\n========================================\n"
+        << title
+        << "\n========================================\n";
+}
+
+// Numbers as MATLAB's writetable() prints them
+std::string num(double v) {
+    if (std::isnan(v)) return "NaN";
+    if (std::isinf(v)) return v > 0 ? "Inf" : "-Inf";
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.15g", v);
+    return buf;
+}
+
+std::string outPath(const std::string& dir, const char* name) {
+    return (fs::path(dir) / name).string();
+}
+
+bool writeFile(const std::string& path, const std::string& text, std::ostream& out) {
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) {
+        std::cerr << "analyze: cannot write " << path << "\n";
+        return false;
+    }
+    std::fwrite(text.data(), 1, text.size(), f);
+    std::fclose(f);
+    out << "Wrote " << path << "\n";
+    return true;
+}
+
+// One-row (or few-row) table written like writetable()
+struct SummaryCsv {
+    std::vector<std::string> names;
+    std::vector<std::vector<std::string>> rows;
+
+    void add(const char* name, double v) { add(name, num(v)); }
+    void add(const char* name, std::string v) {
+        if (rows.size() == 1) names.emplace_back(name);
+        rows.back().push_back(std::move(v));
+    }
+    void newRow() { rows.emplace_back(); }
+
+    std::string text() const {
+        std::string s;
+        for (std::size_t i = 0; i < names.size(); ++i)
+            s += (i ? "," : "") + names[i];
+        s += '\n';
+        for (const auto& r : rows) {
+            for (std::size_t i = 0; i < r.size(); ++i)
+                s += (i ? "," : "") + r[i];
+            s += '\n';
+        }
+        return s;
+    }
+};
+
+// Percentile table (0 - 100 % in 0.1 % steps) of several distributions,
+// the data behind the CDF plots in the scripts
+std::string cdfTable(const std::vector<std::string>& names, const std::vector<const Sorted*>& dists) {
+    std::string s = "percentile";
+    for (const auto& n : names)
+        s += "," + n;
+    s += '\n';
+    for (int step = 0; step <= 1000; ++step) {
+        const double p = step / 10.0;
+        s += num(p);
+        for (const Sorted* d : dists)
+            s += "," + num(d->percentile(p));
+        s += '\n';
+    }
+    return s;
+}
+
+std::vector<double> scaled(const std::vector<double>& v, double k) {
+    std::vector<double> r(v.size());
+    for (std::size_t i = 0; i < v.size(); ++i)
+        r[i] = v[i] * k;
+    return r;
+}
+
+double nanMax(const std::vector<double>& v) {
+    double m = kNaN;
+    for (double x : v)
+        if (!std::isnan(x) && (std::isnan(m) || x > m)) m = x;
+    return m;
+}
+
+// Median of the values at or above the 95th percentile: the level a capped
+// signal sits at most of the time it is near its top
+double topTailMedian(const std::vector<double>& x) {
+    std::vector<double> finite;
+    finite.reserve(x.size());
+    for (double v : x)
+        if (std::isfinite(v)) finite.push_back(v);
+    if (finite.empty()) return kNaN;
+
+    const double p95 = Sorted(finite).percentile(95.0);
+    std::vector<double> tail;
+    for (double v : finite)
+        if (v >= p95) tail.push_back(v);
+    return tail.empty() ? Sorted(finite).max() : Sorted(std::move(tail)).median();
+}
+
+// intersect(a, b, 'stable'): index pairs of the first occurrence of each
+// value of a that also appears in b, in a's order
+std::vector<std::pair<std::size_t, std::size_t>> matchSeq(const std::vector<double>& a,
+                                                          const std::vector<double>& b) {
+    std::unordered_map<double, std::size_t> firstInB;
+    firstInB.reserve(b.size());
+    for (std::size_t j = 0; j < b.size(); ++j)
+        firstInB.emplace(b[j], j);
+
+    std::unordered_set<double> seen;
+    std::vector<std::pair<std::size_t, std::size_t>> pairs;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (std::isnan(a[i]) || !seen.insert(a[i]).second)
+            continue;
+        const auto it = firstInB.find(a[i]);
+        if (it != firstInB.end())
+            pairs.emplace_back(i, it->second);
+    }
+    return pairs;
+}
+
+double pct(std::size_t n, std::size_t total) {
+    return total ? 100.0 * static_cast<double>(n) / static_cast<double>(total) : kNaN;
+}
+
+// Number in a file name between prefix and suffix, e.g. rate_<1000>hz
+double nameNumber(const std::string& path, const char* prefix, const char* suffix) {
+    const std::string stem = fs::path(path).stem().string();
+    const std::size_t b = stem.find(prefix);
+    if (b == std::string::npos) return kNaN;
+    const char* p = stem.c_str() + b + std::strlen(prefix);
+    double v = kNaN;
+    const auto r = std::from_chars(p, stem.c_str() + stem.size(), v);
+    return (r.ec == std::errc() && std::strcmp(r.ptr, suffix) == 0) ? v : kNaN;
+}
+
+} // namespace
+
+// ------------------------------------------------------------
+// End_to_End.m
+// ------------------------------------------------------------
+bool timingReport(const CsvTable& timing, const CsvTable& state,
+                  const std::string& outDir, std::ostream& out) {
+    const auto& rx      = timing.col("rx_state_seq");
+    const auto& ref     = timing.col("ref_state_seq");
+    const auto& txSeq   = timing.col("tx_cmd_seq");
+    const auto& tParse  = timing.col("t_rx_parse_ns");
+    const auto& tPub    = timing.col("t_tool_publish_ns");
+    const auto& tWrench = timing.col("t_wrench_consume_ns");
+    const auto& tStart  = timing.col("t_tx_start_ns");
+    const auto& tDone   = timing.col("t_tx_done_ns");
+
+    std::vector<double> e2e, publish, pipeline, tx, mState, mCmd, mParseNs;
+    for (std::size_t i = 0; i < timing.rows(); ++i) {
+        if (rx[i] != ref[i])
+            continue;
+        e2e.push_back((tDone[i] - tParse[i]) / 1e6);
+        publish.push_back((tPub[i] - tParse[i]) / 1e6);
+        pipeline.push_back((tWrench[i] - tPub[i]) / 1e6);
+        tx.push_back((tDone[i] - tStart[i]) / 1e6);
+        mState.push_back(rx[i]);
+        mCmd.push_back(txSeq[i]);
+        mParseNs.push_back(tParse[i]);
+    }
+    const std::size_t numMatched = e2e.size();
+
+    banner(out, "MATCHED CLOSED-LOOP TIMING ANALYSIS");
+    say(out, "Total rows:           %zu\n", timing.rows());
+    say(out, "Matched rows:         %zu\n", numMatched);
+    say(out, "Unmatched rows:       %zu\n", timing.rows() - numMatched);
+    say(out, "Matched fraction:     %.4f\n",
+        static_cast<double>(numMatched) / static_cast<double>(std::max<std::size_t>(timing.rows(), 1)));
+
+    const std::vector<double> stateGap = diff(mState);
+    const std::vector<double> cmdGap = diff(mCmd);
+    const Sorted stateGapS(stateGap), cmdGapS(cmdGap);
+    const auto skips = [](const std::vector<double>& g) {
+        return std::count_if(g.begin(), g.end(), [](double d) { return d > 1; });
+    };
+
+    banner(out, "MATCHED SEQUENCE GAP ANALYSIS");
+    say(out, "Mean matched state seq gap:   %.3f\n", mean(stateGap));
+    say(out, "Median matched state seq gap: %.3f\n", stateGapS.median());
+    say(out, "Max matched state seq gap:    %.0f\n", stateGapS.max());
+    say(out, "Mean matched cmd seq gap:     %.3f\n", mean(cmdGap));
+    say(out, "Median matched cmd seq gap:   %.3f\n", cmdGapS.median());
+    say(out, "Max matched cmd seq gap:      %.0f\n", cmdGapS.max());
+    say(out, "Rows with matched state skip (>1): %td\n", skips(stateGap));
+    say(out, "Rows with matched cmd skip   (>1): %td\n", skips(cmdGap));
+
+    const Sorted e2eS(e2e), publishS(publish), pipelineS(pipeline), txS(tx);
+
+    banner(out, "HOST-SIDE END-TO-END LATENCY");
+    say(out, "Mean: %.4f ms\n", mean(e2e));
+    say(out, "Median: %.4f ms\n", e2eS.median());
+    say(out, "Std:  %.4f ms\n", stddev(e2e));
+    say(out, "P95:  %.4f ms\n", e2eS.percentile(95));
+    say(out, "P99:  %.4f ms\n", e2eS.percentile(99));
+    say(out, "Max:  %.4f ms\n\n", e2eS.max());
+    say(out, "Publish delay mean:   %.4f ms\n", mean(publish));
+    say(out, "Publish delay median: %.4f ms\n", publishS.median());
+    say(out, "Pipeline delay mean:  %.4f ms\n", mean(pipeline));
+    say(out, "Pipeline delay median:%.4f ms\n", pipelineS.median());
+    say(out, "TX duration mean:     %.4f ms\n", mean(tx));
+    say(out, "TX duration median:   %.4f ms\n", txS.median());
+
+    const double txP99 = txS.percentile(99), e2eP99 = e2eS.percentile(99);
+    banner(out, "MATCHED OUTLIER SUMMARY");
+    say(out, "TX outliers above P99 threshold:     %td\n",
+        std::count_if(tx.begin(), tx.end(), [&](double d) { return d > txP99; }));
+    say(out, "Host E2E outliers above P99 thresh:  %td\n",
+        std::count_if(e2e.begin(), e2e.end(), [&](double d) { return d > e2eP99; }));
+
+    std::vector<std::size_t> worst(numMatched);
+    for (std::size_t i = 0; i < numMatched; ++i) worst[i] = i;
+    const std::size_t topN = std::min<std::size_t>(10, numMatched);
+    std::partial_sort(worst.begin(), worst.begin() + topN, worst.end(),
+                      [&](std::size_t a, std::size_t b) { return e2e[a] > e2e[b]; });
+    out << "\nWorst matched host E2E rows:\n";
+    say(out, "  %12s %10s %18s %10s\n", "rx_state_seq", "tx_cmd_seq", "t_rx_parse_ns", "e2e_ms");
+    for (std::size_t k = 0; k < topN; ++k) {
+        const std::size_t i = worst[k];
+        say(out, "  %12.0f %10.0f %18.0f %10.4f\n", mState[i], mCmd[i], mParseNs[i], e2e[i]);
+    }
+
+    // Raw parsed state stream
+    const auto& sSeq   = state.col("rx_state_seq");
+    const auto& sParse = state.col("t_rx_parse_ns");
+    const auto& sMcu   = state.col("state_mcu_us");
+    const auto& sChunk = state.col("t_chunk_read_ns");
+
+    const std::vector<double> rawGap = diff(sSeq);
+    const std::vector<double> parseDt = scaled(diff(sParse), 1e-6);
+    const std::vector<double> mcuDt = scaled(diff(sMcu), 1e-3);
+
+    std::vector<double> chunkToParse(state.rows());
+    for (std::size_t i = 0; i < state.rows(); ++i)
+        chunkToParse[i] = (sParse[i] - sChunk[i]) / 1e6;
+
+    std::vector<double> chunks(sChunk);
+    chunks.erase(std::remove_if(chunks.begin(), chunks.end(), [](double d) { return std::isnan(d); }), chunks.end());
+    std::sort(chunks.begin(), chunks.end());
+    chunks.erase(std::unique(chunks.begin(), chunks.end()), chunks.end());
+    const std::vector<double> chunkDt = scaled(diff(chunks), 1e-6);
+
+    std::vector<double> effMcu;
+    for (std::size_t i = 0; i < rawGap.size(); ++i)
+        if (rawGap[i] > 0) effMcu.push_back(mcuDt[i] / rawGap[i]);
+
+    const Sorted rawGapS(rawGap), parseDtS(parseDt), mcuDtS(mcuDt), chunkDtS(chunkDt),
+                 chunkToParseS(chunkToParse), effMcuS(effMcu);
+    const double parseRateHz = 1000.0 / mean(parseDt);
+    const double mcuRateHz = 1000.0 / mean(effMcu);
+
+    banner(out, "RAW PARSED STATE-PACKET ANALYSIS");
+    say(out, "Total raw parsed state rows: %zu\n", state.rows());
+
+    banner(out, "RAW STATE SEQUENCE ANALYSIS");
+    say(out, "Mean raw state seq gap:    %.4f\n", mean(rawGap));
+    say(out, "Median raw state seq gap:  %.4f\n", rawGapS.median());
+    say(out, "Max raw state seq gap:     %.0f\n", rawGapS.max());
+    say(out, "Rows with raw state skip (>1): %td\n", skips(rawGap));
+
+    banner(out, "RAW PARSED-PACKET HOST TIMING ANALYSIS");
+    say(out, "Mean raw parse inter-arrival:   %.4f ms\n", mean(parseDt));
+    say(out, "Median raw parse inter-arrival: %.4f ms\n", parseDtS.median());
+    say(out, "Std raw parse inter-arrival:    %.4f ms\n", stddev(parseDt));
+    say(out, "P95 raw parse inter-arrival:    %.4f ms\n", parseDtS.percentile(95));
+    say(out, "P99 raw parse inter-arrival:    %.4f ms\n", parseDtS.percentile(99));
+    say(out, "Estimated parsed packet rate on host: %.2f Hz\n", parseRateHz);
+
+    banner(out, "CHUNK DELIVERY TIMING ANALYSIS");
+    say(out, "Unique chunk count:              %zu\n", chunks.size());
+    say(out, "Mean unique chunk inter-arrival: %.4f ms\n", mean(chunkDt));
+    say(out, "Median unique chunk inter-arrival: %.4f ms\n", chunkDtS.median());
+    say(out, "Std unique chunk inter-arrival:  %.4f ms\n", stddev(chunkDt));
+    say(out, "P95 unique chunk inter-arrival:  %.4f ms\n", chunkDtS.percentile(95));
+    say(out, "P99 unique chunk inter-arrival:  %.4f ms\n", chunkDtS.percentile(99));
+
+    banner(out, "CHUNK-TO-PARSE DELAY ANALYSIS");
+    say(out, "Mean chunk->parse delay:   %.6f ms\n", mean(chunkToParse));
+    say(out, "Median chunk->parse delay: %.6f ms\n", chunkToParseS.median());
+    say(out, "Std chunk->parse delay:    %.6f ms\n", stddev(chunkToParse));
+    say(out, "P95 chunk->parse delay:    %.6f ms\n", chunkToParseS.percentile(95));
+    say(out, "P99 chunk->parse delay:    %.6f ms\n", chunkToParseS.percentile(99));
+    say(out, "Max chunk->parse delay:    %.6f ms\n", chunkToParseS.max());
+
+    banner(out, "RAW MCU TIMING TREND ANALYSIS");
+    say(out, "Mean raw MCU dt between parsed rows:   %.4f ms\n", mean(mcuDt));
+    say(out, "Median raw MCU dt between parsed rows: %.4f ms\n", mcuDtS.median());
+    say(out, "Std raw MCU dt between parsed rows:    %.4f ms\n", stddev(mcuDt));
+    say(out, "P95 raw MCU dt between parsed rows:    %.4f ms\n", mcuDtS.percentile(95));
+    say(out, "Mean effective MCU period per state:   %.4f ms\n", mean(effMcu));
+    say(out, "Median effective MCU period per state: %.4f ms\n", effMcuS.median());
+    say(out, "P95 effective MCU period per state:    %.4f ms\n", effMcuS.percentile(95));
+    say(out, "P99 effective MCU period per state:    %.4f ms\n", effMcuS.percentile(99));
+    say(out, "Estimated MCU state rate from seq+MCU time: %.2f Hz\n", mcuRateHz);
+
+    banner(out, "MATCHED VS RAW LOG COMPARISON");
+    say(out, "Matched rows: %zu\n", numMatched);
+    say(out, "Raw parsed state rows: %zu\n", state.rows());
+    say(out, "Matched / raw fraction: %.4f\n",
+        static_cast<double>(numMatched) / static_cast<double>(std::max<std::size_t>(state.rows(), 1)));
+    say(out, "Mean matched state seq gap: %.4f\n", mean(stateGap));
+    say(out, "Mean raw state seq gap:     %.4f\n\n", mean(rawGap));
+
+    SummaryCsv ts;
+    ts.newRow();
+    ts.add("hostE2E_mean_ms", mean(e2e));
+    ts.add("hostE2E_median_ms", e2eS.median());
+    ts.add("hostE2E_std_ms", stddev(e2e));
+    ts.add("hostE2E_p95_ms", e2eS.percentile(95));
+    ts.add("hostE2E_p99_ms", e2eS.percentile(99));
+    ts.add("hostE2E_max_ms", e2eS.max());
+    ts.add("publish_mean_ms", mean(publish));
+    ts.add("publish_median_ms", publishS.median());
+    ts.add("pipeline_mean_ms", mean(pipeline));
+    ts.add("pipeline_median_ms", pipelineS.median());
+    ts.add("tx_mean_ms", mean(tx));
+    ts.add("tx_median_ms", txS.median());
+    ts.add("matchedStateSeqGap_mean", mean(stateGap));
+    ts.add("matchedStateSeqGap_max", stateGapS.max());
+    ts.add("matchedCmdSeqGap_mean", mean(cmdGap));
+    ts.add("matchedCmdSeqGap_max", cmdGapS.max());
+
+    SummaryCsv ss;
+    ss.newRow();
+    ss.add("rawParseDt_mean_ms", mean(parseDt));
+    ss.add("rawParseDt_median_ms", parseDtS.median());
+    ss.add("rawParseDt_std_ms", stddev(parseDt));
+    ss.add("rawParseDt_p95_ms", parseDtS.percentile(95));
+    ss.add("rawParseDt_p99_ms", parseDtS.percentile(99));
+    ss.add("rawHostParseRate_Hz", parseRateHz);
+    ss.add("chunkDt_mean_ms", mean(chunkDt));
+    ss.add("chunkDt_median_ms", chunkDtS.median());
+    ss.add("chunkDt_std_ms", stddev(chunkDt));
+    ss.add("chunkDt_p95_ms", chunkDtS.percentile(95));
+    ss.add("chunkDt_p99_ms", chunkDtS.percentile(99));
+    ss.add("chunkToParse_mean_ms", mean(chunkToParse));
+    ss.add("chunkToParse_median_ms", chunkToParseS.median());
+    ss.add("chunkToParse_std_ms", stddev(chunkToParse));
+    ss.add("chunkToParse_p95_ms", chunkToParseS.percentile(95));
+    ss.add("chunkToParse_p99_ms", chunkToParseS.percentile(99));
+    ss.add("chunkToParse_max_ms", chunkToParseS.max());
+    ss.add("rawStateSeqGap_mean", mean(rawGap));
+    ss.add("rawStateSeqGap_median", rawGapS.median());
+    ss.add("rawStateSeqGap_max", rawGapS.max());
+    ss.add("rawMcuDt_mean_ms", mean(mcuDt));
+    ss.add("rawMcuDt_median_ms", mcuDtS.median());
+    ss.add("effectiveMcuPeriod_mean_ms", mean(effMcu));
+    ss.add("effectiveMcuPeriod_median_ms", effMcuS.median());
+    ss.add("effectiveMcuPeriod_p95_ms", effMcuS.percentile(95));
+    ss.add("effectiveMcuPeriod_p99_ms", effMcuS.percentile(99));
+    ss.add("effectiveMcuRate_Hz", mcuRateHz);
+
+    bool ok = writeFile(outPath(outDir, "device_timing_summary.csv"), ts.text(), out);
+    ok &= writeFile(outPath(outDir, "device_state_summary.csv"), ss.text(), out);
+    ok &= writeFile(outPath(outDir, "latency_cdf.csv"),
+                    cdfTable({"host_e2e_ms", "publish_ms", "pipeline_ms", "tx_ms", "raw_parse_dt_ms", "chunk_to_parse_ms"},
+                             {&e2eS, &publishS, &pipelineS, &txS, &parseDtS, &chunkToParseS}),
+                    out);
+    return ok;
+}
+
+// ------------------------------------------------------------
+// device_safety_validation_analysis.m
+// ------------------------------------------------------------
+bool safetyReport(CsvTable host, CsvTable device, const SafetyConfig& cfg,
+                  const std::string& outDir, std::ostream& out) {
+    // Only rows that carried a command / a real state packet
+    const auto keepPositive = [](CsvTable& t, const char* seqCol) {
+        const auto* seq = t.find(seqCol);
+        if (!seq) return;
+        std::vector<bool> keep(t.rows());
+        for (std::size_t i = 0; i < t.rows(); ++i) keep[i] = (*seq)[i] > 0;
+        t.filter(keep);
+    };
+    keepPositive(host, "tx_cmd_seq");
+    keepPositive(device, "rx_state_seq");
+
+    const auto keepFinite = [](CsvTable& t, std::initializer_list<const char*> cols) {
+        std::vector<bool> keep(t.rows(), true);
+        for (const char* c : cols) {
+            const auto& v = t.col(c);
+            for (std::size_t i = 0; i < t.rows(); ++i) keep[i] = keep[i] && std::isfinite(v[i]);
+        }
+        const std::size_t removed = static_cast<std::size_t>(std::count(keep.begin(), keep.end(), false));
+        t.filter(keep);
+        return removed;
+    };
+    say(out, "Removed %zu invalid host rows.\n", keepFinite(host, {"tau1_raw", "tau2_raw", "tau1", "tau2"}));
+    say(out, "Removed %zu invalid device rows.\n",
+        keepFinite(device, {"applied_tau1", "applied_tau2", "watchdog_active", "sat1", "sat2"}));
+
+    if (host.rows() == 0 || device.rows() == 0) {
+        std::cerr << "analyze: no valid " << (host.rows() == 0 ? "host" : "device") << " rows remain\n";
+        return false;
+    }
+
+    const char* hostTimeCol = host.has("t_tx_start_ns") ? "t_tx_start_ns" : "t_rx_parse_ns";
+    const char* devTimeCol = device.has("t_rx_parse_ns") ? "t_rx_parse_ns" : "t_chunk_read_ns";
+    const double t0 = std::min(host.col(hostTimeCol)[0], device.col(devTimeCol)[0]);
+
+    if (cfg.ignoreStartS > 0.0) {
+        const auto keepAfter = [&](CsvTable& t, const char* timeCol) {
+            const auto& ns = t.col(timeCol);
+            std::vector<bool> keep(t.rows());
+            for (std::size_t i = 0; i < t.rows(); ++i) keep[i] = (ns[i] - t0) * 1e-9 >= cfg.ignoreStartS;
+            t.filter(keep);
+        };
+        keepAfter(host, hostTimeCol);
+        keepAfter(device, devTimeCol);
+        if (host.rows() == 0 || device.rows() == 0) {
+            std::cerr << "analyze: no rows remain after ignoring the first " << cfg.ignoreStartS << " s\n";
+            return false;
+        }
+    }
+
+    std::vector<double> tDev(device.rows());
+    for (std::size_t i = 0; i < device.rows(); ++i)
+        tDev[i] = (device.col(devTimeCol)[i] - t0) * 1e-9 - cfg.ignoreStartS;
+
+    // Host-side saturation
+    const auto& tau1Raw = host.col("tau1_raw");
+    const auto& tau2Raw = host.col("tau2_raw");
+    const auto& tau1 = host.col("tau1");
+    const auto& tau2 = host.col("tau2");
+    const auto* hostSat1Col = host.find("host_sat1");
+    const auto* hostSat2Col = host.find("host_sat2");
+
+    std::size_t hostSat1 = 0, hostSat2 = 0, hostSatAny = 0;
+    std::vector<double> rawMag(host.rows()), cmdMag(host.rows());
+    for (std::size_t i = 0; i < host.rows(); ++i) {
+        const bool s1 = hostSat1Col ? (*hostSat1Col)[i] == 1 : std::abs(tau1Raw[i] - tau1[i]) > 1e-6;
+        const bool s2 = hostSat2Col ? (*hostSat2Col)[i] == 1 : std::abs(tau2Raw[i] - tau2[i]) > 1e-6;
+        hostSat1 += s1;
+        hostSat2 += s2;
+        hostSatAny += (s1 || s2);
+        rawMag[i] = std::hypot(tau1Raw[i], tau2Raw[i]);
+        cmdMag[i] = std::hypot(tau1[i], tau2[i]);
+    }
+
+    // Device side
+    const std::size_t nDev = device.rows();
+    const auto& applied1 = device.col("applied_tau1");
+    const auto& applied2 = device.col("applied_tau2");
+    const auto& wdCol = device.col("watchdog_active");
+    const auto& sat1Col = device.col("sat1");
+    const auto& sat2Col = device.col("sat2");
+
+    std::vector<bool> devSat(nDev), watchdog(nDev);
+    std::size_t devSat1 = 0, devSat2 = 0, devSatAny = 0, wdActive = 0;
+    std::vector<double> appliedMag(nDev);
+    for (std::size_t i = 0; i < nDev; ++i) {
+        const bool s1 = sat1Col[i] == 1, s2 = sat2Col[i] == 1;
+        devSat[i] = s1 || s2;
+        watchdog[i] = wdCol[i] == 1;
+        devSat1 += s1;
+        devSat2 += s2;
+        devSatAny += devSat[i];
+        wdActive += watchdog[i];
+        appliedMag[i] = std::hypot(applied1[i], applied2[i]);
+    }
+
+    // The firmware may report torque with the opposite sign convention per
+    // joint: pick whichever sign best matches the host command
+    std::vector<std::pair<std::size_t, std::size_t>> pairs;
+    if (host.has("ref_state_seq") && device.has("rx_state_seq"))
+        pairs = matchSeq(host.col("ref_state_seq"), device.col("rx_state_seq"));
+    const bool seqMatched = !pairs.empty();
+    if (pairs.empty()) {
+        for (std::size_t i = 0; i < std::min(host.rows(), nDev); ++i) pairs.emplace_back(i, i);
+    }
+
+    bool invert1 = false, invert2 = false;
+    {
+        double same1 = 0, same2 = 0, inv1 = 0, inv2 = 0;
+        for (const auto& [h, d] : pairs) {
+            same1 += (tau1[h] - applied1[d]) * (tau1[h] - applied1[d]);
+            same2 += (tau2[h] - applied2[d]) * (tau2[h] - applied2[d]);
+            inv1 += (tau1[h] + applied1[d]) * (tau1[h] + applied1[d]);
+            inv2 += (tau2[h] + applied2[d]) * (tau2[h] + applied2[d]);
+        }
+        invert1 = inv1 < same1;
+        invert2 = inv2 < same2;
+    }
+
+    std::vector<double> dev1(nDev), dev2(nDev), dev1Abs(nDev), dev2Abs(nDev), alignedMag(nDev);
+    for (std::size_t i = 0; i < nDev; ++i) {
+        dev1[i] = invert1 ? -applied1[i] : applied1[i];
+        dev2[i] = invert2 ? -applied2[i] : applied2[i];
+        dev1Abs[i] = std::abs(dev1[i]);
+        dev2Abs[i] = std::abs(dev2[i]);
+        alignedMag[i] = std::hypot(dev1[i], dev2[i]);
+    }
+
+    // Slew from MCU time when logged, host parse time otherwise
+    std::vector<double> tSlew = tDev;
+    if (const auto* mcu = device.find("state_mcu_us")) {
+        for (std::size_t i = 0; i < nDev; ++i) tSlew[i] = ((*mcu)[i] - (*mcu)[0]) * 1e-6;
+    }
+    std::vector<double> slew(nDev > 0 ? nDev - 1 : 0, kNaN);
+    std::size_t rateLimited = 0, rateLimitedSat = 0;
+    const double rateLimitThresh = 0.9 * cfg.slewLimitNmPerS;
+    for (std::size_t i = 0; i + 1 < nDev; ++i) {
+        const double dt = tSlew[i + 1] - tSlew[i];
+        if (!(dt > cfg.minSlewDtS))
+            continue;
+        slew[i] = std::max(std::abs(dev1[i + 1] - dev1[i]), std::abs(dev2[i + 1] - dev2[i])) / dt;
+        if (slew[i] >= rateLimitThresh) {
+            ++rateLimited;
+            rateLimitedSat += devSat[i + 1];
+        }
+    }
+    const Sorted slewS(slew);
+
+    // Cap checks
+    const double cap1 = topTailMedian(dev1Abs);
+    const double cap2 = topTailMedian(dev2Abs);
+    const double capCombined = topTailMedian(alignedMag);
+    const double capTol = std::max(1e-2, 0.02 * cfg.torqueCapNm);
+    std::size_t satFalseNeg = 0, satFalsePos = 0;
+    for (std::size_t i = 0; i < nDev; ++i) {
+        const bool nearCap = dev1Abs[i] >= cfg.torqueCapNm - capTol || dev2Abs[i] >= cfg.torqueCapNm - capTol;
+        satFalseNeg += nearCap && !devSat[i];
+        satFalsePos += devSat[i] && !nearCap;
+    }
+
+    // Watchdog windows: each rising edge starts one event
+    std::vector<double> wdDur;
+    for (std::size_t i = 0; i < nDev; ++i) {
+        if (!watchdog[i] || (i > 0 && watchdog[i - 1]))
+            continue;
+        std::size_t j = i;
+        while (j + 1 < nDev && watchdog[j + 1]) ++j;
+        wdDur.push_back(tDev[j] - tDev[i]);
+    }
+    const Sorted wdDurS(wdDur);
+    double wdTotal = 0;
+    for (double d : wdDur) wdTotal += d;
+
+    out << "\n=== Host-side Torque Saturation ===\n";
+    say(out, "Samples: %zu\n", host.rows());
+    say(out, "Joint 1 saturation rate: %.3f %%\n", pct(hostSat1, host.rows()));
+    say(out, "Joint 2 saturation rate: %.3f %%\n", pct(hostSat2, host.rows()));
+    say(out, "Any-joint saturation rate: %.3f %%\n", pct(hostSatAny, host.rows()));
+    say(out, "Mean |tau_raw|: %.3f N.m\n", mean(rawMag));
+    say(out, "Mean |tau_clamped|: %.3f N.m\n", mean(cmdMag));
+    say(out, "Max |tau_raw|: %.3f N.m\n", nanMax(rawMag));
+    say(out, "Max |tau_clamped|: %.3f N.m\n", nanMax(cmdMag));
+
+    out << "\n=== Device-side Applied Torque and Safety ===\n";
+    say(out, "Samples: %zu\n", nDev);
+    say(out, "Watchdog active rate: %.3f %%\n", pct(wdActive, nDev));
+    say(out, "Joint 1 device sat/limit rate: %.3f %%\n", pct(devSat1, nDev));
+    say(out, "Joint 2 device sat/limit rate: %.3f %%\n", pct(devSat2, nDev));
+    say(out, "Any-joint device sat/limit rate: %.3f %%\n", pct(devSatAny, nDev));
+    say(out, "Mean |applied tau|: %.3f N.m\n", mean(appliedMag));
+    say(out, "Max |applied tau1|: %.3f N.m\n", nanMax(dev1Abs));
+    say(out, "Max |applied tau2|: %.3f N.m\n", nanMax(dev2Abs));
+    say(out, "Detected sign inversion joint 1: %d\n", invert1 ? 1 : 0);
+    say(out, "Detected sign inversion joint 2: %d\n", invert2 ? 1 : 0);
+
+    out << "\n=== Slew-Rate Evidence ===\n";
+    if (!slewS.empty()) {
+        say(out, "Max joint slew: %.3f N.m/s\n", slewS.max());
+        say(out, "Median joint slew: %.3f N.m/s\n", slewS.median());
+        say(out, "95th percentile joint slew: %.3f N.m/s\n", slewS.percentile(95));
+        say(out, "99th percentile joint slew: %.3f N.m/s\n", slewS.percentile(99));
+        say(out, "Rate-limited sample count: %zu\n", rateLimited);
+        say(out, "Rate-limited samples also flagged sat/limit: %zu\n", rateLimitedSat);
+    } else {
+        out << "Not enough samples to estimate slew rate.\n";
+    }
+
+    out << "\n=== Torque Cap / Saturation Check ===\n";
+    say(out, "Firmware torque cap: %.3f N.m\n", cfg.torqueCapNm);
+    say(out, "Empirical combined top-tail cap estimate: %.3f N.m\n", capCombined);
+    say(out, "Empirical joint 1 top-tail cap estimate: %.3f N.m\n", cap1);
+    say(out, "Empirical joint 2 top-tail cap estimate: %.3f N.m\n", cap2);
+    say(out, "Near-cap tolerance: %.3f N.m\n", capTol);
+    say(out, "Saturation mismatches: %zu total, fn=%zu, fp=%zu\n",
+        satFalseNeg + satFalsePos, satFalseNeg, satFalsePos);
+
+    out << "\n=== Host vs Device Agreement ===\n";
+    if (seqMatched) {
+        std::vector<double> err1, err2, errMag;
+        for (const auto& [h, d] : pairs) {
+            err1.push_back(std::abs(tau1[h] - dev1[d]));
+            err2.push_back(std::abs(tau2[h] - dev2[d]));
+            errMag.push_back(std::abs(std::hypot(tau1[h], tau2[h]) - alignedMag[d]));
+        }
+        say(out, "Matched cycles: %zu\n", pairs.size());
+        say(out, "Mean abs aligned torque error joint 1: %.4f N.m\n", mean(err1));
+        say(out, "Mean abs aligned torque error joint 2: %.4f N.m\n", mean(err2));
+        say(out, "Mean abs aligned torque magnitude error: %.4f N.m\n", mean(errMag));
+        say(out, "Max abs aligned torque magnitude error: %.4f N.m\n", nanMax(errMag));
+    } else {
+        out << "No sequence-matched host/device rows were found.\n";
+    }
+
+    out << "\n=== Watchdog Behaviour ===\n";
+    if (!wdDur.empty()) {
+        say(out, "Watchdog event count: %zu\n", wdDur.size());
+        say(out, "Watchdog active rate: %.3f %%\n", pct(wdActive, nDev));
+        say(out, "Total active time: %.3f s\n", wdTotal);
+        say(out, "Mean duration: %.3f s\n", mean(wdDur));
+        say(out, "Median duration: %.3f s\n", wdDurS.median());
+        say(out, "Max duration: %.3f s\n", wdDurS.max());
+    } else {
+        say(out, "Watchdog did not activate after first %.1f s.\n", cfg.ignoreStartS);
+    }
+    out << "\n";
+
+    std::string txt = "COMBINED SUMMARY\n";
+    char line[128];
+    const auto add = [&](const char* fmt, auto v) {
+        std::snprintf(line, sizeof(line), fmt, v);
+        txt += line;
+    };
+    add("Host any-sat: %.3f %%\n", pct(hostSatAny, host.rows()));
+    add("Device watchdog active: %.3f %%\n", pct(wdActive, nDev));
+    add("Device sat/limit: %.3f %%\n", pct(devSatAny, nDev));
+    add("Firmware torque cap: %.3f N.m\n", cfg.torqueCapNm);
+    add("Empirical cap combined: %.3f N.m\n", capCombined);
+    add("Empirical cap j1: %.3f N.m\n", cap1);
+    add("Empirical cap j2: %.3f N.m\n", cap2);
+    add("Max joint slew: %.3f N.m/s\n", slewS.max());
+    add("Firmware slew limit: %.3f N.m/s\n", cfg.slewLimitNmPerS);
+    add("Sat mismatches: %zu\n", satFalseNeg + satFalsePos);
+    add("Rate-limited count: %zu\n", rateLimited);
+    add("Watchdog events: %zu\n", wdDur.size());
+
+    std::string hist = "slew_lo_nm_s,slew_hi_nm_s,count\n";
+    const Histogram h = histogram(slewS, cfg.slewBins);
+    for (std::size_t b = 0; b < h.counts.size(); ++b) {
+        const double lo = h.lo + h.width * static_cast<double>(b);
+        hist += num(lo) + "," + num(lo + h.width) + "," + std::to_string(h.counts[b]) + "\n";
+    }
+
+    bool ok = writeFile(outPath(outDir, "results_combined_summary.txt"), txt, out);
+    ok &= writeFile(outPath(outDir, "slew_histogram.csv"), hist, out);
+    return ok;
+}
+
+// ------------------------------------------------------------
+// CommAnalysis.m
+// ------------------------------------------------------------
+bool commReport(const std::vector<std::string>& rateFiles, const std::vector<std::string>& rttFiles,
+                const std::string& outDir, std::ostream& out) {
+    struct Loaded {
+        std::string name;
+        double      nominal = kNaN;
+        CsvTable    table;
+        bool        ok = false;
+    };
+    const auto loadAll = [](const std::vector<std::string>& files, const char* prefix, const char* suffix) {
+        std::vector<std::future<Loaded>> jobs;
+        for (const auto& f : files) {
+            jobs.push_back(std::async(std::launch::async, [f, prefix, suffix] {
+                Loaded l;
+                l.name = fs::path(f).stem().string();
+                l.nominal = nameNumber(f, prefix, suffix);
+                l.ok = l.table.load(f, 1);
+                return l;
+            }));
+        }
+        std::vector<Loaded> all;
+        for (auto& j : jobs) {
+            Loaded l = j.get();
+            if (l.ok) all.push_back(std::move(l));
+        }
+        std::stable_sort(all.begin(), all.end(),
+                         [](const Loaded& a, const Loaded& b) { return a.nominal < b.nominal; });
+        return all;
+    };
+
+    bool ok = true;
+
+    if (!rateFiles.empty()) {
+        out << "====================================================\n"
+            << "PACKET RATE / INTEGRITY ANALYSIS\n"
+            << "====================================================\n";
+
+        const std::vector<Loaded> rates = loadAll(rateFiles, "rate_", "hz");
+        std::vector<Sorted> dts(rates.size());
+        SummaryCsv sum;
+        for (std::size_t i = 0; i < rates.size(); ++i) {
+            const CsvTable& T = rates[i].table;
+            std::vector<double> dt;
+            for (double d : T.col("dt_arrival_ms"))
+                if (d > 0) dt.push_back(d);
+            dts[i] = Sorted(dt);
+
+            double drops = 0, ooo = 0;
+            for (double d : T.col("dropped_since_last")) if (!std::isnan(d)) drops += d;
+            for (double d : T.col("out_of_order")) if (!std::isnan(d)) ooo += d;
+            const double packets = static_cast<double>(T.rows());
+            const double meanDt = mean(dt);
+
+            say(out, "\n%s.csv\n", rates[i].name.c_str());
+            say(out, "  Requested rate:      %.0f Hz\n", rates[i].nominal);
+            say(out, "  Measured rate:       %.2f Hz\n", 1000.0 / meanDt);
+            say(out, "  Mean dt:             %.4f ms\n", meanDt);
+            say(out, "  Std dt (jitter):     %.4f ms\n", stddev(dt));
+            say(out, "  P95 dt:              %.4f ms\n", dts[i].percentile(95));
+            say(out, "  P99 dt:              %.4f ms\n", dts[i].percentile(99));
+            say(out, "  Total packets:       %.0f\n", packets);
+            say(out, "  Total drops:         %.0f\n", drops);
+            say(out, "  Drop fraction:       %.6f\n", drops / std::max(packets, 1.0));
+            say(out, "  Out-of-order total:  %.0f\n", ooo);
+            say(out, "  Out-of-order frac:   %.6f\n", ooo / std::max(packets, 1.0));
+
+            sum.newRow();
+            sum.add("rateNames", rates[i].name);
+            sum.add("requestedRateHz", rates[i].nominal);
+            sum.add("measuredRateHz", 1000.0 / meanDt);
+            sum.add("meanDtMs", meanDt);
+            sum.add("stdDtMs", stddev(dt));
+            sum.add("p95DtMs", dts[i].percentile(95));
+            sum.add("p99DtMs", dts[i].percentile(99));
+            sum.add("totalPackets", packets);
+            sum.add("totalDrops", drops);
+            sum.add("dropFraction", drops / std::max(packets, 1.0));
+            sum.add("totalOutOfOrder", ooo);
+            sum.add("outOfOrderFraction", ooo / std::max(packets, 1.0));
+        }
+
+        std::vector<std::string> names;
+        std::vector<const Sorted*> dists;
+        for (std::size_t i = 0; i < rates.size(); ++i) {
+            names.push_back(rates[i].name + "_dt_ms");
+            dists.push_back(&dts[i]);
+        }
+        out << "\n";
+        ok &= writeFile(outPath(outDir, "rate_summary.csv"), sum.text(), out);
+        ok &= writeFile(outPath(outDir, "rate_dt_cdf.csv"), cdfTable(names, dists), out);
+    }
+
+    if (!rttFiles.empty()) {
+        out << "\n====================================================\n"
+            << "ROUND-TRIP LATENCY ANALYSIS\n"
+            << "====================================================\n";
+
+        const std::vector<Loaded> rtts = loadAll(rttFiles, "rtt_", "ms");
+        std::vector<Sorted> valid(rtts.size());
+        SummaryCsv sum;
+        for (std::size_t i = 0; i < rtts.size(); ++i) {
+            const CsvTable& T = rtts[i].table;
+            const auto& success = T.col("success");
+            const auto& rtt = T.col("rtt_ms");
+            std::vector<double> v;
+            for (std::size_t r = 0; r < T.rows(); ++r)
+                if (success[r] == 1) v.push_back(rtt[r]);
+            valid[i] = Sorted(v);
+            const double successRate = mean(success);
+
+            say(out, "\n%s.csv\n", rtts[i].name.c_str());
+            say(out, "  Nominal interval: %.0f ms\n", rtts[i].nominal);
+            say(out, "  Success rate:     %.4f\n", successRate);
+            say(out, "  Mean RTT:         %.4f ms\n", mean(v));
+            say(out, "  Std RTT:          %.4f ms\n", stddev(v));
+            say(out, "  P95 RTT:          %.4f ms\n", valid[i].percentile(95));
+            say(out, "  P99 RTT:          %.4f ms\n", valid[i].percentile(99));
+            say(out, "  Min RTT:          %.4f ms\n", valid[i].min());
+            say(out, "  Max RTT:          %.4f ms\n", valid[i].max());
+            say(out, "  Samples:          %zu\n", T.rows());
+
+            sum.newRow();
+            sum.add("rttNames", rtts[i].name);
+            sum.add("testIntervalMs", rtts[i].nominal);
+            sum.add("successRate", successRate);
+            sum.add("meanRttMs", mean(v));
+            sum.add("stdRttMs", stddev(v));
+            sum.add("p95RttMs", valid[i].percentile(95));
+            sum.add("p99RttMs", valid[i].percentile(99));
+            sum.add("minRttMs", valid[i].min());
+            sum.add("maxRttMs", valid[i].max());
+            sum.add("numSamples", static_cast<double>(T.rows()));
+        }
+
+        std::vector<std::string> names;
+        std::vector<const Sorted*> dists;
+        for (std::size_t i = 0; i < rtts.size(); ++i) {
+            names.push_back(rtts[i].name + "_ms");
+            dists.push_back(&valid[i]);
+        }
+        out << "\n";
+        ok &= writeFile(outPath(outDir, "rtt_summary.csv"), sum.text(), out);
+        ok &= writeFile(outPath(outDir, "rtt_cdf.csv"), cdfTable(names, dists), out);
+    }
+    return ok;
+}
+
+// ------------------------------------------------------------
+// simulation_validation_analysis.m
+// ------------------------------------------------------------
+bool simReport(const CsvTable& sim, const SimConfig& cfg, std::ostream& out) {
+    const auto& tRaw = sim.col("t_sec");
+    std::size_t first = sim.rows();
+    for (std::size_t i = 0; i < sim.rows(); ++i) {
+        if (std::isfinite(tRaw[i]) && tRaw[i] > 0) {
+            first = i;
+            break;
+        }
+    }
+    if (first == sim.rows()) {
+        std::cerr << "analyze: " << sim.path() << " has no valid timestamps\n";
+        return false;
+    }
+    const double t0 = tRaw[first];
+
+    const auto& dx = sim.col("device_x");
+    const auto& dy = sim.col("device_y");
+    const auto& dz = sim.col("device_z");
+    const auto& px = sim.col("proxy_x");
+    const auto& py = sim.col("proxy_y");
+    const auto& pz = sim.col("proxy_z");
+    const auto& fx = sim.col("force_x");
+    const auto& fy = sim.col("force_y");
+    const auto& fz = sim.col("force_z");
+    const auto& nx = sim.col("normal_x");
+    const auto& ny = sim.col("normal_y");
+    const auto& nz = sim.col("normal_z");
+    const auto* penCol = sim.find("penetration_depth_m");
+    const auto* contactCol = sim.find("contact_active");
+
+    std::vector<double> pen, fmag, ratio, holdF;
+    for (std::size_t i = 0; i < sim.rows(); ++i) {
+        const double t = tRaw[i] - t0;
+        if (!(t >= 0.0) || t < cfg.ignoreStartS)
+            continue;
+
+        const double d = penCol ? (*penCol)[i]
+                                : std::sqrt((dx[i] - px[i]) * (dx[i] - px[i]) + (dy[i] - py[i]) * (dy[i] - py[i]) +
+                                            (dz[i] - pz[i]) * (dz[i] - pz[i]));
+        const bool contact = contactCol ? ((*contactCol)[i] != 0 && !std::isnan((*contactCol)[i])) : d > 0;
+        if (!contact)
+            continue;
+
+        const double f = std::sqrt(fx[i] * fx[i] + fy[i] * fy[i] + fz[i] * fz[i]);
+        pen.push_back(d);
+        fmag.push_back(f);
+
+        const double nNorm = std::sqrt(nx[i] * nx[i] + ny[i] * ny[i] + nz[i] * nz[i]);
+        if (!(nNorm > 1e-9))
+            continue;
+        const double ux = nx[i] / nNorm, uy = ny[i] / nNorm, uz = nz[i] / nNorm;
+        const double fn = fx[i] * ux + fy[i] * uy + fz[i] * uz;
+        const double tx = fx[i] - fn * ux, ty = fy[i] - fn * uy, tz = fz[i] - fn * uz;
+        const double ft = std::sqrt(tx * tx + ty * ty + tz * tz);
+        ratio.push_back(std::abs(fn) / std::max(ft, 1e-9));
+
+        if (t >= cfg.holdStartS && t <= cfg.holdEndS)
+            holdF.push_back(f);
+    }
+
+    out << "\n=== Penetration Statistics (m) ===\n";
+    if (pen.empty()) {
+        out << "No contact samples detected.\n";
+        return true;
+    }
+    const Sorted penS(pen);
+    say(out, "mean:   %.6f\n", mean(pen));
+    say(out, "median: %.6f\n", penS.median());
+    say(out, "p95:    %.6f\n", penS.percentile(95));
+    say(out, "max:    %.6f\n", penS.max());
+
+    // Least-squares line through (penetration, |F|)
+    double sx = 0, sy = 0;
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < pen.size(); ++i) {
+        if (!std::isfinite(pen[i]) || !std::isfinite(fmag[i])) continue;
+        sx += pen[i];
+        sy += fmag[i];
+        ++n;
+    }
+    if (n >= 2) {
+        const double mx = sx / static_cast<double>(n), my = sy / static_cast<double>(n);
+        double sxx = 0, sxy = 0;
+        for (std::size_t i = 0; i < pen.size(); ++i) {
+            if (!std::isfinite(pen[i]) || !std::isfinite(fmag[i])) continue;
+            sxx += (pen[i] - mx) * (pen[i] - mx);
+            sxy += (pen[i] - mx) * (fmag[i] - my);
+        }
+        const double slope = sxx > 0 ? sxy / sxx : kNaN;
+        const double intercept = my - slope * mx;
+        double ssRes = 0, ssTot = 0;
+        for (std::size_t i = 0; i < pen.size(); ++i) {
+            if (!std::isfinite(pen[i]) || !std::isfinite(fmag[i])) continue;
+            const double r = fmag[i] - (slope * pen[i] + intercept);
+            ssRes += r * r;
+            ssTot += (fmag[i] - my) * (fmag[i] - my);
+        }
+        out << "\n=== Force vs Penetration Fit ===\n";
+        say(out, "k_eff slope: %.3f N/m\n", slope);
+        say(out, "intercept:   %.6f N\n", intercept);
+        say(out, "R^2:         %.4f\n", 1.0 - ssRes / std::max(ssTot, DBL_EPSILON));
+    } else {
+        out << "\nNot enough valid contact samples for linear fit.\n";
+    }
+
+    if (!ratio.empty()) {
+        const Sorted ratioS(ratio);
+        out << "\n=== Constrained Motion Force Decomposition ===\n";
+        say(out, "median |F_n|/|F_t|: %.3f\n", ratioS.median());
+        say(out, "p95 |F_n|/|F_t|:    %.3f\n", ratioS.percentile(95));
+
+        if (holdF.size() > 5) {
+            const double mu = mean(holdF), sigma = stddev(holdF);
+            out << "\n=== Sustained Contact Stability (Hold Region) ===\n";
+            say(out, "Hold Region %.2f s to %.2f s\n", cfg.holdStartS, cfg.holdEndS);
+            say(out, "force mean: %.4f N\n", mu);
+            say(out, "force std:  %.4f N\n", sigma);
+            say(out, "force CV:   %.4f\n", sigma / std::max(mu, DBL_EPSILON));
+        } else {
+            out << "\nNot enough samples in hold region.\n";
+        }
+    }
+    return true;
+}
+
+} // namespace analysis
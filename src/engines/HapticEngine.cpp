@@ -3,6 +3,7 @@
 #include "geometry/GeometryDatabase.h"
 #include "geometry/GeometryEntry.h"
 #include "geometry/sdf/SDF.h"
+#include "trace/Trace.h"
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/quaternion.hpp>
@@ -10,6 +11,7 @@
 #include <chrono>
 #include <thread>
 #include <cmath>
+#include <limits>
 #include <iostream>
 // ------------------------------------------------------------
 // Small math helpers (local to this TU)
@@ -35,52 +37,16 @@ static inline Vec3 normalize(const Vec3& v) {
     return mul(v, 1.0/n);
 }
 
-// ------------------------------------------------------------
-// Frame transforms
-// ------------------------------------------------------------
-static inline Vec3 toLocal(const Pose& T_ws, const Vec3& p_ws) {
-    glm::quat q  = glm::quat(T_ws.q);
-    glm::quat qi = glm::inverse(q);
-
-    glm::vec3 t = glm::vec3(p_ws.x, p_ws.y, p_ws.z)
-                - glm::vec3(T_ws.p.x, T_ws.p.y, T_ws.p.z);
-
-    glm::vec3 pl = qi * t;
-
-    //undo uniform scale
-    pl /= float(T_ws.s);
-
-    return {pl.x, pl.y, pl.z};
-}
-
-
-static inline Vec3 toWorld(const Pose& T_ws, const Vec3& p_ls) {
-    glm::quat q = glm::quat(T_ws.q);
-
-    glm::vec3 pw = q * (float(T_ws.s) * glm::vec3(p_ls.x, p_ls.y, p_ls.z))
-                 + glm::vec3(T_ws.p.x, T_ws.p.y, T_ws.p.z);
-
-    return {pw.x, pw.y, pw.z};
-}
-
-
-static inline Vec3 dirToWorld(const Pose& T_ws, const Vec3& v_ls) {
-    glm::quat q = glm::quat(T_ws.q);
-    glm::vec3 vw = q * glm::vec3(v_ls.x, v_ls.y, v_ls.z);
-    return {vw.x, vw.y, vw.z};
-}
-
-
 // ------------------------------------------------------------
 // Constructor / public API
 // ------------------------------------------------------------
 HapticEngine::HapticEngine(const GeometryDatabase& geomDb,
                            msg::SnapshotChannel<WorldSnapshot>& worldSnaps,
-                           msg::Channel<ToolStateMsg>& toolIn,
-                           msg::Channel<HapticSnapshotMsg>& hapticOut,
+                           msg::MailboxChannel<ToolStateMsg>& toolIn,
+                           msg::BroadcastChannel<HapticSnapshotMsg>& hapticOut,
                            msg::Channel<HapticWrenchCmd>& wrenchOut,
-                           msg::Channel<HapticWrenchCmd>& deviceCmdOut,
-                           msg::Channel<SimulationValidationLogMsg>& simLogOut)
+                           msg::MailboxChannel<HapticWrenchCmd>& deviceCmdOut,
+                           msg::SpscChannel<SimulationValidationLogMsg>& simLogOut)
 : geometryDb_(geomDb)
 , worldSnaps_(worldSnaps)
 , toolIn_(toolIn)
@@ -106,6 +72,8 @@ void HapticEngine::run()
 {
     using clock = std::chrono::steady_clock;
 
+    trace::setThreadName("haptics");
+
     constexpr auto targetPeriod = std::chrono::microseconds(1000);
     auto nextWake = clock::now();
     auto lastLoopStart = nextWake;
@@ -133,12 +101,9 @@ void HapticEngine::run()
         double wakeErrorMs =
             std::chrono::duration<double, std::milli>(afterSleep - nextWake).count();
 
-        // static int printCounter = 0;
-        // if (++printCounter % 1000 == 0) {
-        //     std::cout << "Haptic period: " << periodMs
-        //               << " ms, compute: " << computeMs
-        //               << " ms, wake error: " << wakeErrorMs << " ms\n";
-        // }
+        TRACE_COUNTER("haptics.period_ms", periodMs);
+        TRACE_COUNTER("haptics.compute_ms", computeMs);
+        TRACE_COUNTER("haptics.wake_error_ms", wakeErrorMs);
     }
 }
 // ------------------------------------------------------------
@@ -146,66 +111,51 @@ void HapticEngine::run()
 // ------------------------------------------------------------
 void HapticEngine::update(float dt)
 {
+    TRACE_SCOPE("HapticEngine::update");
+
     // --------------------------------------------------------
-    // Drain latest world snapshot
+    // Latest world snapshot (pinned in place, no copy). The scene is only
+    // prepared when it changes; ticks in between reuse it as is
     // --------------------------------------------------------
-    worldSnaps_.tryRead(latestWorld_, worldSnapVersion_);
+    if (worldSnaps_.tryAcquire(latestWorld_, worldSnapVersion_) && latestWorld_)
+        scene_.prepare(*latestWorld_, geometryDb_);
 
     // --------------------------------------------------------
-    // Drain latest tool state
+    // Latest tool state (mailbox keeps only the newest)
     // --------------------------------------------------------
-    ToolStateMsg ti;
-    while (toolIn_.tryConsume(ti)) {
-        latestTool_ = std::move(ti);
-    }
+    toolIn_.tryRead(latestTool_, toolVersion_);
 
     const Pose& toolPose = latestTool_.toolPose_ws;
     Pose proxyPose = proxyPosePrev_;
     Pose refPose   = toolPose;
 
     // --------------------------------------------------------
-    // Contact search using SDFs
+    // Contact search using SDFs: the nearest batched primitive, plus other
+    // objects whose bounds come within kContactSearchRadius of the tool and
+    // unbounded ones
     // --------------------------------------------------------
-    double bestPhi = 1e30;
+    const HapticScene::Nearest nearest = scene_.nearest(toolPose.p, kContactSearchRadius);
+    const double bestPhi = nearest.phi;
     ObjectID contactId = 0;
     Vec3 contactPoint_ws{0,0,0};
     Vec3 contactNormal_ws{0,1,0};
 
-    for (const ObjectState& obj : latestWorld_.objects) {
-
-        // Skip tool/proxy objects
-        if (obj.role == Role::Tool || obj.role == Role::Proxy)
-            continue;
-
-        // Geometry lookup (assumes GeometryEntry exposes SDF*)
-        const GeometryEntry& geom = geometryDb_.get(obj.geom);
-        const SDF* sdf = geom.sdf.get();
-        if (!sdf) continue;
-
-        Vec3 p_ls = toLocal(obj.T_ws, toolPose.p);
-        SDFQuery q = sdf->queryLocal(p_ls);
-
-        // convert distance to world units
-        double phi_ws = q.phi * obj.T_ws.s;
-        if (phi_ws < bestPhi) {
-            bestPhi = phi_ws;
-
-            if (phi_ws < 0.0) {
-                contactId = obj.id;
-                //std::cout << "Contact with object " << contactId << " at phi = " << phi_ws << "\n";
-                Vec3 grad_ls = q.grad;
-                double g2 = dot(grad_ls, grad_ls);
-
-                Vec3 proj_ls = p_ls;
-                if (g2 > 1e-10 && std::isfinite(q.phi)) {
-                    Vec3 n_ls = mul(grad_ls, 1.0 / std::sqrt(g2));
-                    proj_ls   = sub(p_ls, mul(n_ls, q.phi)); // local projection
-                }
-
-                contactPoint_ws  = toWorld(obj.T_ws, proj_ls);
-                contactNormal_ws = normalize(dirToWorld(obj.T_ws, grad_ls));
-            }
+    if (bestPhi < 0.0) {
+        const HapticScene::Object& obj = *nearest.obj;
+        const SDFQuery& q = nearest.q;
+        contactId = obj.id;
+        //std::cout << "Contact with object " << contactId << " at phi = " << bestPhi << "\n";
+        Vec3 grad_ls = q.grad;
+        double g2 = dot(grad_ls, grad_ls);
+
+        Vec3 proj_ls = nearest.p_ls;
+        if (g2 > 1e-10 && std::isfinite(q.phi)) {
+            Vec3 n_ls = mul(grad_ls, 1.0 / std::sqrt(g2));
+            proj_ls   = sub(nearest.p_ls, mul(n_ls, q.phi)); // local projection
         }
+
+        contactPoint_ws  = obj.toWorld(proj_ls);
+        contactNormal_ws = normalize(obj.dirToWorld(grad_ls));
     }
 
     // --------------------------------------------------------
@@ -335,7 +285,11 @@ void HapticEngine::update(float dt)
     simLog.normal_z = contactNormal_ws.z;
 
     simLog.penetration_depth_m = static_cast<float>(norm(sub(toolPose.p, proxyPose.p)));
-    simLog.signed_phi_m = (bestPhi < 1e20) ? static_cast<float>(bestPhi) : 0.0f;
+    // Objects beyond the search radius were skipped, so past it bestPhi is
+    // only an upper bound on the nearest distance: log NaN instead
+    simLog.signed_phi_m = (bestPhi <= kContactSearchRadius)
+        ? static_cast<float>(bestPhi)
+        : std::numeric_limits<float>::quiet_NaN();
     simLog.contact_active = (contactId != 0) ? 1u : 0u;
 
     // --- Fix B: if contact just ended, reset filtered proxy velocity to avoid
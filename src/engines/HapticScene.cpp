@@ -0,0 +1,107 @@
+#include "engines/HapticScene.h"
+
+#include "geometry/GeometryEntry.h"
+#include "geometry/sdf/SDF.h"
+#include "trace/Trace.h"
+
+// Refitting keeps the tree shape; rebuild now and then so it tracks motion
+static constexpr uint32_t kRefitsPerRebuild = 100;
+
+// Below this many analytic primitives the batch isn't worth it
+static constexpr std::size_t kMinBatchPrimitives = 16;
+
+void HapticScene::prepare(const WorldSnapshot& world, const GeometryDatabase& geometry)
+{
+    TRACE_SCOPE("HapticScene::prepare");
+
+    objects_.clear();
+    poses_.clear();
+    batched_.clear();
+    primitiveBatch_.clear();
+    bvhBoxes_.clear();
+    bvhObjects_.clear();
+    unboundedObjects_.clear();
+
+    // Snapshot objects that can be touched, transforms inverted once here
+    SDFPrimitive prim;
+    std::size_t primitives = 0;
+    for (const ObjectState& obj : world.objects) {
+        if (obj.role == Role::Tool || obj.role == Role::Proxy)
+            continue;
+
+        const GeometryEntry& geom = geometry.get(obj.geom);
+        if (!geom.sdf)
+            continue;
+
+        Object o;
+        o.rotation     = glm::mat3_cast(obj.T_ws.q);
+        o.worldToLocal = glm::transpose(o.rotation) * (1.0 / obj.T_ws.s);
+        o.origin       = obj.T_ws.p;
+        o.scale        = obj.T_ws.s;
+        o.sdf          = geom.sdf.get();
+        o.id           = obj.id;
+        o.bounds       = transformAabb(geom.localBounds, o.rotation, o.origin, o.scale);
+        objects_.push_back(o);
+        poses_.push_back(obj.T_ws);
+
+        const bool analytic = o.sdf->primitive(prim);
+        batched_.push_back(analytic);
+        primitives += analytic;
+    }
+
+    // Analytic primitives go to the SIMD batch when there are enough of them,
+    // everything else to the BVH
+    const bool useBatch = primitives >= kMinBatchPrimitives;
+    for (uint32_t i = 0; i < objects_.size(); ++i) {
+        if (useBatch && batched_[i]) {
+            primitiveBatch_.add(*objects_[i].sdf, poses_[i], i);
+        } else if (objects_[i].bounds.isBounded()) {
+            bvhBoxes_.push_back(objects_[i].bounds);
+            bvhObjects_.push_back(i);
+        } else {
+            unboundedObjects_.push_back(i);
+        }
+    }
+    primitiveBatch_.finish();
+
+    updateBvh();
+}
+
+HapticScene::Nearest HapticScene::nearest(const Vec3& p_ws, double radius) const
+{
+    Nearest best;
+    forEachCandidate(p_ws, radius, [&](const Object& obj) {
+        const Vec3 p_ls = obj.toLocal(p_ws);
+        const SDFQuery q = obj.sdf->queryLocal(p_ls);
+
+        // convert distance to world units
+        const double phi_ws = q.phi * obj.scale;
+        if (phi_ws < best.phi) {
+            best.obj = &obj;
+            best.phi = phi_ws;
+            best.p_ls = p_ls;
+            best.q = q;
+        }
+    });
+    return best;
+}
+
+void HapticScene::updateBvh()
+{
+    // Same objects in the same order: the leaves still map to the right items
+    bool sameObjects = bvhObjects_.size() == bvhIds_.size();
+    for (std::size_t k = 0; sameObjects && k < bvhObjects_.size(); ++k)
+        sameObjects = objects_[bvhObjects_[k]].id == bvhIds_[k];
+
+    if (sameObjects && refitsSinceBuild_ < kRefitsPerRebuild) {
+        contactBvh_.refit(bvhBoxes_);
+        ++refitsSinceBuild_;
+        return;
+    }
+
+    contactBvh_.build(bvhBoxes_);
+    refitsSinceBuild_ = 0;
+    bvhIds_.clear();
+    for (uint32_t i : bvhObjects_)
+        bvhIds_.push_back(objects_[i].id);
+}
@@ -1,5 +1,6 @@
 // PhysXEngine.cpp
 #include "engines/PhysicsEnginePhysX.h"
+#include "trace/Trace.h"
 
 #include <PxRigidBody.h>
 #include <extensions/PxRigidActorExt.h>
@@ -38,6 +39,8 @@ PhysicsEnginePhysX::~PhysicsEnginePhysX() {
 // Public API
 // ------------------------------------------------------------
 void PhysicsEnginePhysX::step(double dt) {
+    TRACE_SCOPE("PhysicsEnginePhysX::step");
+
     // 1) If topology/props changed, rebuild actors
     if (wm_.consumeDirty(WorldDirty::Topology | WorldDirty::Physics)) {
         rebuildActors();
@@ -286,16 +289,18 @@ void PhysicsEnginePhysX::buildActorsFromWorld_() {
 // Per-step pipeline
 // ------------------------------------------------------------
 void PhysicsEnginePhysX::consumeInputsOnce_() {
-    // 1) Drain incoming wrench/impulse commands
-    std::vector<HapticWrenchCmd> cmds;
-    wrenchIn_.drain(cmds);
-
-    for (const auto& c : cmds) {
-        // You previously treated this as "impulse = F * duration".
-        // Keep that contract unless you switch to explicit impulse messages.
-        const glm::dvec3 J_ws = c.force_ws * c.duration_s;
-        applyImpulseAtPoint_(c.targetId, J_ws, c.point_ws);
-    }
+    // 1) Drain incoming wrench/impulse commands (one lock per batch, no allocation)
+    do {
+        wrenchBatch_.clear();
+        wrenchIn_.drainInto(wrenchBatch_);
+
+        for (const auto& c : wrenchBatch_) {
+            // You previously treated this as "impulse = F * duration".
+            // Keep that contract unless you switch to explicit impulse messages.
+            const glm::dvec3 J_ws = c.force_ws * c.duration_s;
+            applyImpulseAtPoint_(c.targetId, J_ws, c.point_ws);
+        }
+    } while (wrenchBatch_.full());
 
     // 2) Optional tool state consumption (store latest if you need it)
     // ToolStateMsg tool;
@@ -0,0 +1,82 @@
+#include "geometry/Bvh.h"
+
+#include <algorithm>
+
+void Bvh::clear() {
+    nodes_.clear();
+    items_.clear();
+    itemBoxes_.clear();
+}
+
+void Bvh::build(const std::vector<Aabb>& boxes) {
+    clear();
+    if (boxes.empty())
+        return;
+
+    items_.resize(boxes.size());
+    for (uint32_t i = 0; i < items_.size(); ++i)
+        items_[i] = i;
+
+    nodes_.reserve(2 * (boxes.size() / kLeafSize + 1));
+    nodes_.emplace_back();
+    buildNode(0, 0, static_cast<uint32_t>(items_.size()), boxes);
+
+    itemBoxes_.resize(items_.size());
+    for (std::size_t i = 0; i < items_.size(); ++i)
+        itemBoxes_[i] = boxes[items_[i]];
+}
+
+void Bvh::buildNode(uint32_t node, uint32_t begin, uint32_t end, const std::vector<Aabb>& boxes) {
+    Aabb box;
+    Aabb centers;
+    for (uint32_t i = begin; i < end; ++i) {
+        const Aabb& b = boxes[items_[i]];
+        box.grow(b);
+        const Vec3 c = b.center();
+        centers.grow({c, c});
+    }
+    nodes_[node].box = box;
+
+    if (end - begin <= kLeafSize) {
+        nodes_[node].first = begin;
+        nodes_[node].count = end - begin;
+        return;
+    }
+
+    // Split at the median center along the axis where the centers spread most
+    const Vec3 spread = centers.extent();
+    const int axis = (spread.x >= spread.y && spread.x >= spread.z) ? 0 : (spread.y >= spread.z ? 1 : 2);
+    const uint32_t mid = begin + (end - begin) / 2;
+    std::nth_element(items_.begin() + begin, items_.begin() + mid, items_.begin() + end,
+                     [&](uint32_t a, uint32_t b) {
+                         return boxes[a].lo[axis] + boxes[a].hi[axis] < boxes[b].lo[axis] + boxes[b].hi[axis];
+                     });
+
+    const uint32_t left = static_cast<uint32_t>(nodes_.size());
+    nodes_.emplace_back();
+    nodes_.emplace_back();
+    nodes_[node].first = left;
+    nodes_[node].count = 0;
+
+    buildNode(left, begin, mid, boxes);
+    buildNode(left + 1, mid, end, boxes);
+}
+
+void Bvh::refit(const std::vector<Aabb>& boxes) {
+    for (std::size_t i = 0; i < items_.size(); ++i)
+        itemBoxes_[i] = boxes[items_[i]];
+
+    // Children come after their parent, so a reverse sweep sees them first
+    for (std::size_t i = nodes_.size(); i-- > 0;) {
+        Node& n = nodes_[i];
+        Aabb box;
+        if (n.count > 0) {
+            for (uint32_t k = n.first; k < n.first + n.count; ++k)
+                box.grow(itemBoxes_[k]);
+        } else {
+            box = nodes_[n.first].box;
+            box.grow(nodes_[n.first + 1].box);
+        }
+        n.box = box;
+    }
+}
@@ -1,4 +1,5 @@
 #include "geometry/GeometryDatabase.h"
+#include "geometry/sdf/SDF.h"
 #include <stdexcept>
 
 void GeometryDatabase::registerGeometry(const GeometryEntry& entry) {
@@ -6,7 +7,9 @@ void GeometryDatabase::registerGeometry(const GeometryEntry& entry) {
         throw std::runtime_error("GeometryID already registered");
     }
 
-    entries_.emplace(entry.id, entry);
+    GeometryEntry& e = entries_.emplace(entry.id, entry).first->second;
+    if (e.sdf)
+        e.localBounds = e.sdf->localBounds();
     typeIndex_[entry.type] = entry.id;
 }
 
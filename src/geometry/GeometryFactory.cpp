@@ -2,13 +2,20 @@
 #include "geometry/sdf/PlaneSDF.h"
 #include "geometry/sdf/UnitSphereSDF.h"
 #include "geometry/sdf/UnitCubeSDF.h"
+#include "geometry/sdf/BrickSDF.h"
+#include "geometry/TriMesh.h"
+#include <chrono>
+#include <iostream>
 #include <memory>
 
 // ---- public API ----
 
 GeometryFactory::GeometryFactory(GeometryDatabase& db,
                                  RenderMeshRegistry& meshRegistry)
-    : db_(db), meshRegistry_(meshRegistry) {}
+    : db_(db), meshRegistry_(&meshRegistry) {}
+
+GeometryFactory::GeometryFactory(GeometryDatabase& db)
+    : db_(db), meshRegistry_(nullptr) {}
 
 
 GeometryID GeometryFactory::getPlane() {
@@ -32,8 +39,24 @@ GeometryID GeometryFactory::getCube() {
     return *cubeId_; 
 }
 
+GeometryID GeometryFactory::getMesh(const std::string& path, const GridSDFConfig& cfg) {
+    auto it = meshIds_.find(path);
+    if (it != meshIds_.end()) {
+        return it->second;
+    }
+    const GeometryID id = registerMesh(path, cfg);
+    if (id != 0) {
+        meshIds_.emplace(path, id);
+    }
+    return id;
+}
+
 // ---- private helpers ----
 
+RenderMeshHandle GeometryFactory::meshFor(MeshKind kind) {
+    return meshRegistry_ ? meshRegistry_->getOrCreate(kind) : 0;
+}
+
 GeometryID GeometryFactory::registerPlane() {
     GeometryEntry e;
     e.id = nextId_++;
@@ -42,7 +65,7 @@ GeometryID GeometryFactory::registerPlane() {
     // Later:
     e.sdf = std::make_shared<PlaneSDF>(Vec3{0,1,0}, 0.0);
 
-    e.renderMesh = meshRegistry_.getOrCreate(MeshKind::Plane);
+    e.renderMesh = meshFor(MeshKind::Plane);
     // e.physicsShape = ...
     // e.renderMesh = ...
 
@@ -57,7 +80,7 @@ GeometryID GeometryFactory::registerSphere() {
 
 
     e.sdf = std::make_shared<UnitSphereSDF>();
-    e.renderMesh = meshRegistry_.getOrCreate(MeshKind::Sphere);
+    e.renderMesh = meshFor(MeshKind::Sphere);
 
 
 
@@ -70,7 +93,62 @@ GeometryID GeometryFactory::registerCube() {
     e.id = nextId_++;
     e.type = SurfaceType::Cube;  
     e.sdf = std::make_shared<UnitCubeSDF>(); 
-    e.renderMesh = meshRegistry_.getOrCreate(MeshKind::Cube);
+    e.renderMesh = meshFor(MeshKind::Cube);
     db_.registerGeometry(e); 
     return e.id; 
-}
\ No newline at end of file
+}
+
+GeometryID GeometryFactory::registerMesh(const std::string& path, const GridSDFConfig& cfg) {
+    const auto t0 = std::chrono::steady_clock::now();
+    auto elapsedMs = [&t0] {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    };
+
+    GeometryEntry e;
+    e.type = SurfaceType::TriMesh;
+
+    const std::string ext = ".bricksdf";
+    if (path.size() > ext.size() && path.compare(path.size() - ext.size(), ext.size(), ext) == 0) {
+        std::shared_ptr<BrickSDF> sdf = BrickSDF::open(path);
+        if (!sdf) {
+            return 0;
+        }
+        std::cout << "GeometryFactory: " << path << ": " << sdf->brickCount() << " SDF bricks, "
+                  << sdf->poolBricks() << " resident at most\n";
+        e.sdf = sdf;
+    } else {
+        TriMesh mesh;
+        if (!loadTriMesh(path, mesh)) {
+            return 0;
+        }
+
+        if (GridSDF::sampleCount(mesh, cfg) <= kMaxDenseSamples) {
+            std::shared_ptr<GridSDF> sdf = GridSDF::loadOrBake(mesh, cfg, sdfCacheDir_);
+            if (!sdf) {
+                std::cerr << "GeometryFactory: no SDF for " << path << "\n";
+                return 0;
+            }
+            std::cout << "GeometryFactory: " << path << ": " << mesh.triangleCount() << " triangles, "
+                      << sdf->nx() << "x" << sdf->ny() << "x" << sdf->nz() << " SDF grid in " << elapsedMs() << " ms\n";
+            e.sdf = sdf;
+        } else {
+            BrickSDFConfig bricks;
+            bricks.voxel = cfg.voxel;
+            bricks.bandVoxels = cfg.bandVoxels;
+            bricks.threads = cfg.threads;
+            std::shared_ptr<BrickSDF> sdf = BrickSDF::openOrBake(mesh, bricks, sdfCacheDir_);
+            if (!sdf) {
+                std::cerr << "GeometryFactory: no SDF for " << path << "\n";
+                return 0;
+            }
+            std::cout << "GeometryFactory: " << path << ": " << mesh.triangleCount() << " triangles, "
+                      << sdf->brickCount() << " SDF bricks in " << elapsedMs() << " ms\n";
+            e.sdf = sdf;
+        }
+        e.renderMesh = meshRegistry_ ? meshRegistry_->createTriMesh(mesh) : 0;
+    }
+
+    e.id = nextId_++;
+    db_.registerGeometry(e);
+    return e.id;
+}
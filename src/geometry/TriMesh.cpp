@@ -0,0 +1,185 @@
+#include "geometry/TriMesh.h"
+#include "geometry/sdf/MeshDistance.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+Aabb TriMesh::bounds() const {
+    Aabb box;
+    for (const Vec3& v : vertices)
+        box.grow({v, v});
+    return box;
+}
+
+uint64_t TriMesh::contentHash() const {
+    const uint64_t counts[2] = {vertices.size(), indices.size()};
+    uint64_t h = fnv1a(kFnv1aBasis, counts, sizeof(counts));
+    h = fnv1a(h, vertices.data(), vertices.size() * sizeof(Vec3));
+    return fnv1a(h, indices.data(), indices.size() * sizeof(uint32_t));
+}
+
+// ------------------------------------------------------------
+// OBJ
+// ------------------------------------------------------------
+static bool loadObj(const std::string& path, TriMesh& out) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "loadTriMesh: cannot open " << path << "\n";
+        return false;
+    }
+
+    std::string line;
+    std::vector<uint32_t> face;
+    std::size_t lineNo = 0;
+    while (std::getline(in, line)) {
+        ++lineNo;
+        const char* s = line.c_str();
+        while (*s == ' ' || *s == '\t')
+            ++s;
+
+        if (s[0] == 'v' && (s[1] == ' ' || s[1] == '\t')) {
+            char* end = nullptr;
+            Vec3 v;
+            v.x = std::strtod(s + 2, &end);
+            v.y = std::strtod(end, &end);
+            v.z = std::strtod(end, &end);
+            out.vertices.push_back(v);
+        } else if (s[0] == 'f' && (s[1] == ' ' || s[1] == '\t')) {
+            // f v, f v/vt, f v//vn, f v/vt/vn; negative indices count from the end
+            face.clear();
+            const char* p = s + 2;
+            for (;;) {
+                char* end = nullptr;
+                const long idx = std::strtol(p, &end, 10);
+                if (end == p)
+                    break;
+                const long n = static_cast<long>(out.vertices.size());
+                const long i = idx > 0 ? idx - 1 : n + idx;
+                if (idx == 0 || i < 0 || i >= n) {
+                    std::cerr << "loadTriMesh: " << path << ":" << lineNo << ": bad vertex index\n";
+                    return false;
+                }
+                face.push_back(static_cast<uint32_t>(i));
+                p = end;
+                while (*p && *p != ' ' && *p != '\t')
+                    ++p;
+            }
+            for (std::size_t k = 2; k < face.size(); ++k) {
+                out.indices.push_back(face[0]);
+                out.indices.push_back(face[k - 1]);
+                out.indices.push_back(face[k]);
+            }
+        }
+    }
+    return true;
+}
+
+// ------------------------------------------------------------
+// STL
+// ------------------------------------------------------------
+
+// STL stores three separate corners per facet; weld them so neighbouring
+// triangles share vertices and edges
+class VertexWelder {
+public:
+    explicit VertexWelder(TriMesh& mesh) : mesh_(mesh) {}
+
+    void add(const Vec3& v) {
+        const std::array<double, 3> key{v.x, v.y, v.z};
+        auto it = index_.find(key);
+        if (it == index_.end()) {
+            it = index_.emplace(key, static_cast<uint32_t>(mesh_.vertices.size())).first;
+            mesh_.vertices.push_back(v);
+        }
+        mesh_.indices.push_back(it->second);
+    }
+
+private:
+    TriMesh& mesh_;
+    std::map<std::array<double, 3>, uint32_t> index_;
+};
+
+static bool loadStl(const std::string& path, TriMesh& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << "loadTriMesh: cannot open " << path << "\n";
+        return false;
+    }
+    in.seekg(0, std::ios::end);
+    const std::streamoff fileSize = in.tellg();
+    in.seekg(0);
+
+    VertexWelder weld(out);
+
+    // Binary: 80-byte header, uint32 count, 50 bytes per facet. Some
+    // exporters write "solid" into binary headers, so trust the size first.
+    char header[80] = {};
+    uint32_t count = 0;
+    in.read(header, sizeof(header));
+    in.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if (in && fileSize == 84 + std::streamoff(count) * 50) {
+        for (uint32_t t = 0; t < count; ++t) {
+            float f[12];     // normal, 3 corners
+            uint16_t attr;
+            in.read(reinterpret_cast<char*>(f), sizeof(f));
+            in.read(reinterpret_cast<char*>(&attr), sizeof(attr));
+            if (!in) {
+                std::cerr << "loadTriMesh: truncated " << path << "\n";
+                return false;
+            }
+            for (int c = 0; c < 3; ++c)
+                weld.add(Vec3{f[3 + 3 * c], f[4 + 3 * c], f[5 + 3 * c]});
+        }
+        return true;
+    }
+
+    // ASCII: only the "vertex x y z" lines matter, three per facet
+    if (std::strncmp(header, "solid", 5) != 0) {
+        std::cerr << "loadTriMesh: " << path << " is not an STL file\n";
+        return false;
+    }
+    in.clear();
+    in.seekg(0);
+    std::string word;
+    while (in >> word) {
+        if (word != "vertex")
+            continue;
+        Vec3 v;
+        if (!(in >> v.x >> v.y >> v.z)) {
+            std::cerr << "loadTriMesh: bad vertex in " << path << "\n";
+            return false;
+        }
+        weld.add(v);
+    }
+    out.indices.resize(out.indices.size() - out.indices.size() % 3);
+    return true;
+}
+
+bool loadTriMesh(const std::string& path, TriMesh& out) {
+    out = TriMesh{};
+
+    std::string ext = path.substr(path.find_last_of('.') + 1);
+    std::transform(ext.begin(), ext.end(), ext.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    bool ok = false;
+    if (ext == "obj")
+        ok = loadObj(path, out);
+    else if (ext == "stl")
+        ok = loadStl(path, out);
+    else
+        std::cerr << "loadTriMesh: unsupported mesh format " << path << " (expected .obj or .stl)\n";
+
+    if (ok && out.indices.empty()) {
+        std::cerr << "loadTriMesh: " << path << " has no triangles\n";
+        ok = false;
+    }
+    return ok;
+}
@@ -0,0 +1,783 @@
+#include "geometry/sdf/BrickSDF.h"
+#include "geometry/sdf/MeshDistance.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <tuple>
+
+// ------------------------------------------------------------
+// File
+// ------------------------------------------------------------
+//   BrickSDFFileHeader
+//   BrickSDFNodeRecord[nodeCount], sorted by (z, y, x)
+//   float coarse[brickCount]
+//   bricks, kBrickStride bytes each, from a page boundary: int16 samples
+//   (x fastest), phi = sample * band / 32767
+
+static constexpr char     kBrickSdfMagic[8] = {'B', 'R', 'I', 'C', 'K', 'S', 'D', 'F'};
+static constexpr uint32_t kBrickSdfVersion  = 1;
+
+struct BrickSDFFileHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t key;
+    double   origin[3];
+    double   voxel;
+    double   band;
+    uint32_t bricksAcross[3];
+    uint32_t reserved2;
+    double   boundsLo[3];
+    double   boundsHi[3];
+    uint64_t nodeCount;
+    uint64_t brickCount;
+    uint64_t nodesOffset;
+    uint64_t coarseOffset;
+    uint64_t bricksOffset;
+};
+
+// Set when the space just past the node's +x face is inside; fills the empty
+// nodes between it and the next node in its row
+static constexpr uint32_t kNodeExitsInside = 1u;
+
+struct BrickSDFNodeRecord {
+    uint32_t coord[3];
+    uint32_t firstBrick;
+    uint32_t flags;
+    uint32_t reserved;
+    uint64_t childMask[64];
+    uint64_t insideMask[64];
+};
+
+static constexpr uint32_t    kBrickCells   = 8;                // voxels per brick side
+static constexpr uint32_t    kBrickSide    = kBrickCells + 1;  // samples per brick side
+static constexpr uint32_t    kBrickSamples = kBrickSide * kBrickSide * kBrickSide;
+static constexpr std::size_t kBrickBytes   = kBrickSamples * sizeof(int16_t);
+static constexpr std::size_t kBrickStride  = (kBrickBytes + 7) & ~std::size_t(7);
+static constexpr uint32_t    kNodeBricks   = 16;               // bricks per node side
+static constexpr uint32_t    kNodeChildren = kNodeBricks * kNodeBricks * kNodeBricks;
+static constexpr uint32_t    kCoordBits    = 21;               // per axis in a root key
+static constexpr double      kQuantMax     = 32767.0;
+
+// Default resolution when BrickSDFConfig::voxel is 0
+static constexpr double kDefaultSamplesAcross = 1024.0;
+
+// Bricks start on a page boundary of the file
+static constexpr std::size_t kBrickAlign = 4096;
+
+namespace {
+
+uint64_t nodeKey(uint32_t nx, uint32_t ny, uint32_t nz) {
+    return (uint64_t(nz) << (2 * kCoordBits)) | (uint64_t(ny) << kCoordBits) | nx;
+}
+
+uint32_t childIndex(uint32_t bx, uint32_t by, uint32_t bz) {
+    return (bx % kNodeBricks) + kNodeBricks * ((by % kNodeBricks) + kNodeBricks * (bz % kNodeBricks));
+}
+
+uint32_t popcount64(uint64_t v) {
+    v = v - ((v >> 1) & 0x5555555555555555ull);
+    v = (v & 0x3333333333333333ull) + ((v >> 2) & 0x3333333333333333ull);
+    v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return static_cast<uint32_t>((v * 0x0101010101010101ull) >> 56);
+}
+
+std::size_t alignUp(std::size_t v, std::size_t a) {
+    return (v + a - 1) / a * a;
+}
+
+} // namespace
+
+// ------------------------------------------------------------
+// Bake
+// ------------------------------------------------------------
+bool BrickSDF::bake(const TriMesh& mesh, const BrickSDFConfig& cfg, const std::string& path)
+{
+    if (mesh.triangleCount() == 0) {
+        std::cerr << "BrickSDF: mesh has no triangles\n";
+        return false;
+    }
+
+    const Aabb bounds = mesh.bounds();
+    const Vec3 extent = bounds.extent();
+    const double longest = std::max({extent.x, extent.y, extent.z});
+    const double h = cfg.voxel > 0.0 ? cfg.voxel : longest / kDefaultSamplesAcross;
+    if (!(h > 0.0) || !std::isfinite(h)) {
+        std::cerr << "BrickSDF: mesh has no extent\n";
+        return false;
+    }
+    const uint32_t bandVoxels = std::max(1u, cfg.bandVoxels);
+    const double band = bandVoxels * h;
+
+    // As in GridSDF: a voxel more than the band on every side, so the domain
+    // border is outside and the sign can start from it
+    const double pad = (bandVoxels + 1) * h;
+    const Vec3 origin = bounds.lo - Vec3{pad};
+    uint32_t bricksAcross[3];
+    uint32_t samplesAcross[3];  // brick samples share faces: 8 * bricks + 1
+    for (int a = 0; a < 3; ++a) {
+        const double cells = std::ceil((extent[a] + 2.0 * pad) / h);
+        const double bricks = std::ceil(cells / kBrickCells);
+        if (bricks >= double(kNodeBricks) * double(1u << kCoordBits)) {
+            std::cerr << "BrickSDF: " << bricks << " bricks across is too many; use a larger voxel\n";
+            return false;
+        }
+        bricksAcross[a] = static_cast<uint32_t>(bricks);
+        samplesAcross[a] = bricksAcross[a] * kBrickCells + 1;
+    }
+
+    // Sample index range each triangle's band covers
+    struct SampleRange { uint32_t lo[3], hi[3]; };
+    const std::vector<MeshTriangle> tris = prepareMeshTriangles(mesh);
+    std::vector<SampleRange> ranges(tris.size());
+    for (std::size_t t = 0; t < tris.size(); ++t) {
+        const MeshTriangle& tri = tris[t];
+        for (int a = 0; a < 3; ++a) {
+            const double lo = std::min({tri.a[a], tri.b[a], tri.c[a]}) - origin[a];
+            const double hi = std::max({tri.a[a], tri.b[a], tri.c[a]}) - origin[a];
+            ranges[t].lo[a] = static_cast<uint32_t>(std::max(0.0, std::floor(lo / h) - bandVoxels));
+            ranges[t].hi[a] = static_cast<uint32_t>(std::min(double(samplesAcross[a] - 1), std::ceil(hi / h) + bandVoxels));
+        }
+    }
+    // Bricks holding samples [lo, hi]; a sample on a brick face is in both
+    auto brickRange = [](const SampleRange& r, int a, uint32_t& lo, uint32_t& hi, uint32_t across) {
+        lo = r.lo[a] > 0 ? (r.lo[a] - 1) / kBrickCells : 0;
+        hi = std::min(r.hi[a] / kBrickCells, across - 1);
+    };
+
+    // Pass 1: the nodes each triangle's band reaches, which of their bricks,
+    // and the triangles per node
+    struct BuildNode {
+        uint32_t coord[3];
+        uint32_t firstBrick = 0;
+        uint32_t flags = 0;
+        uint64_t childMask[64] = {};
+        uint64_t insideMask[64] = {};
+        std::vector<uint32_t> tris;
+    };
+    std::vector<BuildNode> nodes;
+    {
+        std::unordered_map<uint64_t, uint32_t> nodeIndex;
+        for (std::size_t t = 0; t < tris.size(); ++t) {
+            uint32_t blo[3], bhi[3];
+            for (int a = 0; a < 3; ++a)
+                brickRange(ranges[t], a, blo[a], bhi[a], bricksAcross[a]);
+
+            for (uint32_t nz = blo[2] / kNodeBricks; nz <= bhi[2] / kNodeBricks; ++nz)
+            for (uint32_t ny = blo[1] / kNodeBricks; ny <= bhi[1] / kNodeBricks; ++ny)
+            for (uint32_t nx = blo[0] / kNodeBricks; nx <= bhi[0] / kNodeBricks; ++nx) {
+                auto [it, added] = nodeIndex.emplace(nodeKey(nx, ny, nz), static_cast<uint32_t>(nodes.size()));
+                if (added) {
+                    nodes.emplace_back();
+                    nodes.back().coord[0] = nx;
+                    nodes.back().coord[1] = ny;
+                    nodes.back().coord[2] = nz;
+                }
+                BuildNode& node = nodes[it->second];
+                node.tris.push_back(static_cast<uint32_t>(t));
+
+                for (uint32_t bz = std::max(blo[2], nz * kNodeBricks); bz <= std::min(bhi[2], nz * kNodeBricks + kNodeBricks - 1); ++bz)
+                for (uint32_t by = std::max(blo[1], ny * kNodeBricks); by <= std::min(bhi[1], ny * kNodeBricks + kNodeBricks - 1); ++by)
+                for (uint32_t bx = std::max(blo[0], nx * kNodeBricks); bx <= std::min(bhi[0], nx * kNodeBricks + kNodeBricks - 1); ++bx) {
+                    const uint32_t c = childIndex(bx, by, bz);
+                    node.childMask[c >> 6] |= uint64_t(1) << (c & 63);
+                }
+            }
+        }
+    }
+
+    // Rows along x, so the sign can be carried from the -x border
+    std::sort(nodes.begin(), nodes.end(), [](const BuildNode& a, const BuildNode& b) {
+        return std::make_tuple(a.coord[2], a.coord[1], a.coord[0]) < std::make_tuple(b.coord[2], b.coord[1], b.coord[0]);
+    });
+    std::vector<std::size_t> rowStart;
+    std::size_t brickCount = 0;
+    for (std::size_t n = 0; n < nodes.size(); ++n) {
+        if (n == 0 || nodes[n].coord[1] != nodes[n - 1].coord[1] || nodes[n].coord[2] != nodes[n - 1].coord[2])
+            rowStart.push_back(n);
+        nodes[n].firstBrick = static_cast<uint32_t>(brickCount);
+        for (uint64_t w : nodes[n].childMask)
+            brickCount += popcount64(w);
+    }
+    rowStart.push_back(nodes.size());
+    if (brickCount >= std::numeric_limits<uint32_t>::max()) {
+        std::cerr << "BrickSDF: " << brickCount << " bricks is too many; use a larger voxel\n";
+        return false;
+    }
+
+    const std::size_t nodesOffset = alignUp(sizeof(BrickSDFFileHeader), 64);
+    const std::size_t coarseOffset = nodesOffset + nodes.size() * sizeof(BrickSDFNodeRecord);
+    const std::size_t bricksOffset = alignUp(coarseOffset + brickCount * sizeof(float), kBrickAlign);
+    const std::size_t fileBytes = bricksOffset + brickCount * kBrickStride;
+
+    // Written next to the target and renamed, like the GridSDF cache
+    const std::string tmp = path + ".tmp";
+    logging::MappedFile out;
+    if (!out.create(tmp, fileBytes))
+        return false;
+    uint8_t* base = static_cast<uint8_t*>(out.data());
+    float* coarse = reinterpret_cast<float*>(base + coarseOffset);
+
+    // Pass 2, one node row per task. Each brick row of the node row carries,
+    // per line of samples, the sign of the last sample it had a distance for
+    // (outside at the border). Between two band samples on a line there is no
+    // surface crossing, so samples outside the band take that sign, and so do
+    // the empty bricks and nodes the line passes through.
+    const double band2 = band * band;
+    const uint32_t threadCount = cfg.threads > 0 ? cfg.threads
+                                                 : std::max(1u, std::thread::hardware_concurrency());
+    std::atomic<std::size_t> nextRow{0};
+
+    auto bakeRows = [&] {
+        std::vector<std::vector<uint32_t>> childTris(kNodeChildren);
+        std::vector<int8_t> carry(kNodeBricks * kNodeBricks * kBrickSide * kBrickSide);
+        float phi[kBrickSamples];
+
+        for (;;) {
+            const std::size_t row = nextRow.fetch_add(1);
+            if (row + 1 >= rowStart.size())
+                return;
+            std::fill(carry.begin(), carry.end(), int8_t(1));
+
+            for (std::size_t n = rowStart[row]; n < rowStart[row + 1]; ++n) {
+                BuildNode& node = nodes[n];
+                const uint32_t bx0 = node.coord[0] * kNodeBricks;
+                const uint32_t by0 = node.coord[1] * kNodeBricks;
+                const uint32_t bz0 = node.coord[2] * kNodeBricks;
+
+                for (std::vector<uint32_t>& list : childTris)
+                    list.clear();
+                for (uint32_t t : node.tris) {
+                    uint32_t blo[3], bhi[3];
+                    for (int a = 0; a < 3; ++a) {
+                        brickRange(ranges[t], a, blo[a], bhi[a], bricksAcross[a]);
+                        blo[a] = std::max(blo[a], node.coord[a] * kNodeBricks) - node.coord[a] * kNodeBricks;
+                        bhi[a] = std::min(bhi[a], node.coord[a] * kNodeBricks + kNodeBricks - 1) - node.coord[a] * kNodeBricks;
+                    }
+                    for (uint32_t z = blo[2]; z <= bhi[2]; ++z)
+                    for (uint32_t y = blo[1]; y <= bhi[1]; ++y)
+                    for (uint32_t x = blo[0]; x <= bhi[0]; ++x)
+                        childTris[x + kNodeBricks * (y + kNodeBricks * z)].push_back(t);
+                }
+
+                uint32_t brick = node.firstBrick;
+                for (uint32_t c = 0; c < kNodeChildren; ++c) {
+                    const uint32_t lx = c % kNodeBricks, ly = (c / kNodeBricks) % kNodeBricks, lz = c / (kNodeBricks * kNodeBricks);
+                    int8_t* lineSign = &carry[(lz * kNodeBricks + ly) * kBrickSide * kBrickSide];
+                    const uint64_t bit = uint64_t(1) << (c & 63);
+
+                    if (!(node.childMask[c >> 6] & bit)) {
+                        // Empty: one sign throughout, that of the middle line
+                        if (lineSign[(kBrickSide / 2) * kBrickSide + kBrickSide / 2] < 0)
+                            node.insideMask[c >> 6] |= bit;
+                        continue;
+                    }
+
+                    // Exact distances within the band
+                    const uint32_t s0[3] = {(bx0 + lx) * kBrickCells, (by0 + ly) * kBrickCells, (bz0 + lz) * kBrickCells};
+                    std::fill(std::begin(phi), std::end(phi), std::numeric_limits<float>::infinity());
+                    for (uint32_t t : childTris[c]) {
+                        const SampleRange& r = ranges[t];
+                        uint32_t lo[3], hi[3];
+                        for (int a = 0; a < 3; ++a) {
+                            lo[a] = std::max(r.lo[a], s0[a]) - s0[a];
+                            hi[a] = std::min(r.hi[a], s0[a] + kBrickCells) - s0[a];
+                        }
+                        for (uint32_t k = lo[2]; k <= hi[2]; ++k)
+                        for (uint32_t j = lo[1]; j <= hi[1]; ++j)
+                        for (uint32_t i = lo[0]; i <= hi[0]; ++i) {
+                            const Vec3 p = origin + Vec3{double(s0[0] + i), double(s0[1] + j), double(s0[2] + k)} * h;
+                            bool outside;
+                            const double d2 = distanceSquared(tris[t], p, outside);
+                            float& v = phi[i + kBrickSide * (j + kBrickSide * k)];
+                            if (d2 >= band2 || d2 >= double(v) * double(v))
+                                continue;
+                            const double dist = std::sqrt(d2);
+                            v = static_cast<float>(outside ? dist : -dist);
+                        }
+                    }
+
+                    // Signs beyond the band, then quantise
+                    int16_t* samples = reinterpret_cast<int16_t*>(base + bricksOffset + std::size_t(brick) * kBrickStride);
+                    for (uint32_t k = 0; k < kBrickSide; ++k)
+                    for (uint32_t j = 0; j < kBrickSide; ++j) {
+                        int8_t& sign = lineSign[k * kBrickSide + j];
+                        for (uint32_t i = 0; i < kBrickSide; ++i) {
+                            const uint32_t s = i + kBrickSide * (j + kBrickSide * k);
+                            float& v = phi[s];
+                            if (std::isinf(v))
+                                v = static_cast<float>(sign * band);
+                            else
+                                sign = v < 0.0f ? -1 : 1;
+                            samples[s] = static_cast<int16_t>(std::lround(std::clamp(v / band, -1.0, 1.0) * kQuantMax));
+                        }
+                    }
+                    const uint32_t mid = kBrickSide / 2;
+                    coarse[brick] = phi[mid + kBrickSide * (mid + kBrickSide * mid)];
+                    ++brick;
+                }
+
+                const uint32_t midLine = (kNodeBricks / 2 * kNodeBricks + kNodeBricks / 2) * kBrickSide * kBrickSide
+                                       + (kBrickSide / 2) * kBrickSide + kBrickSide / 2;
+                if (carry[midLine] < 0)
+                    node.flags |= kNodeExitsInside;
+                std::vector<uint32_t>().swap(node.tris);
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (uint32_t w = 1; w < threadCount; ++w)
+        workers.emplace_back(bakeRows);
+    bakeRows();
+    for (std::thread& w : workers)
+        w.join();
+
+    BrickSDFFileHeader hdr{};
+    std::memcpy(hdr.magic, kBrickSdfMagic, sizeof(hdr.magic));
+    hdr.version = kBrickSdfVersion;
+    hdr.key = cacheKey(mesh, cfg);
+    hdr.voxel = h;
+    hdr.band = band;
+    for (int a = 0; a < 3; ++a) {
+        hdr.origin[a] = origin[a];
+        hdr.bricksAcross[a] = bricksAcross[a];
+        hdr.boundsLo[a] = bounds.lo[a];
+        hdr.boundsHi[a] = bounds.hi[a];
+    }
+    hdr.nodeCount = nodes.size();
+    hdr.brickCount = brickCount;
+    hdr.nodesOffset = nodesOffset;
+    hdr.coarseOffset = coarseOffset;
+    hdr.bricksOffset = bricksOffset;
+    std::memcpy(base, &hdr, sizeof(hdr));
+
+    auto* records = reinterpret_cast<BrickSDFNodeRecord*>(base + nodesOffset);
+    for (std::size_t n = 0; n < nodes.size(); ++n) {
+        BrickSDFNodeRecord rec{};
+        std::memcpy(rec.coord, nodes[n].coord, sizeof(rec.coord));
+        rec.firstBrick = nodes[n].firstBrick;
+        rec.flags = nodes[n].flags;
+        std::memcpy(rec.childMask, nodes[n].childMask, sizeof(rec.childMask));
+        std::memcpy(rec.insideMask, nodes[n].insideMask, sizeof(rec.insideMask));
+        std::memcpy(&records[n], &rec, sizeof(rec));
+    }
+
+    out.flush(true);
+    out.close();
+
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        std::cerr << "BrickSDF: failed writing " << path << "\n";
+        std::filesystem::remove(tmp, ec);
+        return false;
+    }
+    return true;
+}
+
+// ------------------------------------------------------------
+// Open
+// ------------------------------------------------------------
+uint64_t BrickSDF::cacheKey(const TriMesh& mesh, const BrickSDFConfig& cfg)
+{
+    uint64_t h = fnv1a(mesh.contentHash(), &cfg.voxel, sizeof(cfg.voxel));
+    h = fnv1a(h, &cfg.bandVoxels, sizeof(cfg.bandVoxels));
+    return fnv1a(h, &kBrickSdfVersion, sizeof(kBrickSdfVersion));
+}
+
+std::shared_ptr<BrickSDF> BrickSDF::open(const std::string& path, const BrickCacheConfig& cache)
+{
+    std::shared_ptr<BrickSDF> sdf(new BrickSDF());
+    if (!sdf->file_.openRead(path))
+        return nullptr;
+
+    const auto* base = static_cast<const uint8_t*>(sdf->file_.data());
+    const std::size_t bytes = sdf->file_.size();
+    BrickSDFFileHeader hdr{};
+    if (bytes >= sizeof(hdr))
+        std::memcpy(&hdr, base, sizeof(hdr));
+    if (std::memcmp(hdr.magic, kBrickSdfMagic, sizeof(hdr.magic)) != 0 || hdr.version != kBrickSdfVersion) {
+        std::cerr << "BrickSDF: " << path << " is not a brick SDF file\n";
+        return nullptr;
+    }
+    const bool sizeOk = hdr.voxel > 0.0 && hdr.band > 0.0 &&
+                        hdr.brickCount < std::numeric_limits<uint32_t>::max() &&
+                        hdr.nodesOffset + hdr.nodeCount * sizeof(BrickSDFNodeRecord) <= hdr.coarseOffset &&
+                        hdr.coarseOffset + hdr.brickCount * sizeof(float) <= hdr.bricksOffset &&
+                        hdr.bricksOffset + hdr.brickCount * kBrickStride <= bytes;
+    if (!sizeOk) {
+        std::cerr << "BrickSDF: " << path << " is truncated or corrupt\n";
+        return nullptr;
+    }
+
+    for (int a = 0; a < 3; ++a) {
+        sdf->origin_[a] = hdr.origin[a];
+        sdf->bricksAcross_[a] = hdr.bricksAcross[a];
+        sdf->meshBounds_.lo[a] = hdr.boundsLo[a];
+        sdf->meshBounds_.hi[a] = hdr.boundsHi[a];
+    }
+    sdf->h_ = hdr.voxel;
+    sdf->invH_ = 1.0 / hdr.voxel;
+    sdf->band_ = hdr.band;
+    sdf->quantum_ = hdr.band / kQuantMax;
+    sdf->key_ = hdr.key;
+    sdf->brickCount_ = static_cast<std::size_t>(hdr.brickCount);
+    sdf->bricksOffset_ = static_cast<std::size_t>(hdr.bricksOffset);
+
+    // Nodes and coarse values stay in RAM; only bricks are paged
+    sdf->nodes_.resize(static_cast<std::size_t>(hdr.nodeCount));
+    sdf->root_.reserve(sdf->nodes_.size());
+    BrickSDFNodeRecord prev{};
+    for (std::size_t n = 0; n < sdf->nodes_.size(); ++n) {
+        BrickSDFNodeRecord rec;
+        std::memcpy(&rec, base + hdr.nodesOffset + n * sizeof(rec), sizeof(rec));
+
+        Node& node = sdf->nodes_[n];
+        std::memcpy(node.childMask, rec.childMask, sizeof(node.childMask));
+        std::memcpy(node.insideMask, rec.insideMask, sizeof(node.insideMask));
+        node.firstBrick = rec.firstBrick;
+        uint32_t count = 0;
+        for (int w = 0; w < 64; ++w) {
+            node.prefix[w] = static_cast<uint16_t>(count);
+            count += popcount64(node.childMask[w]);
+        }
+        if (rec.firstBrick + uint64_t(count) > hdr.brickCount) {
+            std::cerr << "BrickSDF: " << path << " is truncated or corrupt\n";
+            return nullptr;
+        }
+        sdf->root_[nodeKey(rec.coord[0], rec.coord[1], rec.coord[2])] = static_cast<uint32_t>(n);
+
+        // Empty nodes between this one and the previous one in its row
+        const bool sameRow = n > 0 && prev.coord[1] == rec.coord[1] && prev.coord[2] == rec.coord[2];
+        if (sameRow && (prev.flags & kNodeExitsInside))
+            for (uint32_t x = prev.coord[0] + 1; x < rec.coord[0]; ++x)
+                sdf->root_[nodeKey(x, rec.coord[1], rec.coord[2])] = kInsideTile;
+        prev = rec;
+    }
+    sdf->coarse_.resize(sdf->brickCount_);
+    std::memcpy(sdf->coarse_.data(), base + hdr.coarseOffset, sdf->brickCount_ * sizeof(float));
+    // Copied out; the mapping is not touched again (bricks use file_.read)
+    sdf->file_.release(0, sdf->bricksOffset_);
+
+    // Brick pool; none (and no prefetch thread) below one brick
+    const std::size_t slots = std::min(sdf->brickCount_, cache.residentBytes / kBrickBytes);
+    sdf->pool_.resize(slots * kBrickSamples);
+    sdf->slots_.assign(slots, Slot{kNoBrick, {0, 0, 0}});
+    sdf->freeSlots_.resize(slots);
+    for (std::size_t s = 0; s < slots; ++s)
+        sdf->freeSlots_[s] = static_cast<uint32_t>(slots - 1 - s);
+    sdf->slotOf_.reset(new std::atomic<uint32_t>[sdf->brickCount_]);
+    for (std::size_t b = 0; b < sdf->brickCount_; ++b)
+        sdf->slotOf_[b].store(kNoSlot, std::memory_order_relaxed);
+    sdf->wantedIn_.assign(sdf->brickCount_, 0);
+
+    sdf->prefetchRadius_ = cache.prefetchRadius > 0.0 ? cache.prefetchRadius : 8.0 * kBrickCells * sdf->h_;
+    for (std::atomic<double>& c : sdf->hint_)
+        c.store(0.0, std::memory_order_relaxed);
+    if (slots > 0)
+        sdf->prefetcher_ = std::thread(&BrickSDF::prefetchLoop, sdf.get());
+    return sdf;
+}
+
+std::string BrickSDF::cachePath(const TriMesh& mesh, const BrickSDFConfig& cfg, const std::string& cacheDir)
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bricksdf", static_cast<unsigned long long>(cacheKey(mesh, cfg)));
+    return (std::filesystem::path(cacheDir) / name).string();
+}
+
+std::shared_ptr<BrickSDF> BrickSDF::openOrBake(const TriMesh& mesh, const BrickSDFConfig& cfg,
+                                               const std::string& cacheDir, const BrickCacheConfig& cache)
+{
+    const uint64_t key = cacheKey(mesh, cfg);
+    const std::string path = cachePath(mesh, cfg, cacheDir);
+
+    std::error_code ec;
+    if (std::filesystem::exists(path, ec)) {
+        std::shared_ptr<BrickSDF> cached = open(path, cache);
+        if (cached && cached->key() == key)
+            return cached;
+        std::cerr << "BrickSDF: ignoring " << path << ", baking it again\n";
+    }
+
+    std::filesystem::create_directories(cacheDir, ec);
+    if (!bake(mesh, cfg, path))
+        return nullptr;
+    return open(path, cache);
+}
+
+BrickSDF::~BrickSDF()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    if (prefetcher_.joinable())
+        prefetcher_.join();
+}
+
+// ------------------------------------------------------------
+// Query
+// ------------------------------------------------------------
+uint32_t BrickSDF::findBrick(uint32_t bx, uint32_t by, uint32_t bz, bool* inside) const
+{
+    const auto it = root_.find(nodeKey(bx / kNodeBricks, by / kNodeBricks, bz / kNodeBricks));
+    if (it == root_.end() || it->second == kInsideTile) {
+        *inside = it != root_.end();
+        return kNoBrick;
+    }
+    const Node& node = nodes_[it->second];
+    const uint32_t c = childIndex(bx, by, bz);
+    const uint32_t w = c >> 6;
+    const uint64_t bit = uint64_t(1) << (c & 63);
+    if (!(node.childMask[w] & bit)) {
+        *inside = (node.insideMask[w] & bit) != 0;
+        return kNoBrick;
+    }
+    return node.firstBrick + node.prefix[w] + popcount64(node.childMask[w] & (bit - 1));
+}
+
+double BrickSDF::coarseAt(int64_t bx, int64_t by, int64_t bz) const
+{
+    if (bx < 0 || by < 0 || bz < 0 ||
+        bx >= bricksAcross_[0] || by >= bricksAcross_[1] || bz >= bricksAcross_[2])
+        return band_;
+    bool inside = false;
+    const uint32_t brick = findBrick(uint32_t(bx), uint32_t(by), uint32_t(bz), &inside);
+    if (brick != kNoBrick)
+        return coarse_[brick];
+    return inside ? -band_ : band_;
+}
+
+// Trilinear over brick centres: 8x coarser than the bricks, but always in RAM
+SDFQuery BrickSDF::coarseQuery(const Vec3& u) const
+{
+    int64_t b[3];
+    double t[3];
+    for (int a = 0; a < 3; ++a) {
+        const double v = (u[a] - 0.5 * kBrickCells) / kBrickCells;
+        b[a] = static_cast<int64_t>(std::floor(v));
+        t[a] = v - double(b[a]);
+    }
+
+    const double corner[8] = {
+        coarseAt(b[0], b[1],     b[2]),     coarseAt(b[0] + 1, b[1],     b[2]),
+        coarseAt(b[0], b[1] + 1, b[2]),     coarseAt(b[0] + 1, b[1] + 1, b[2]),
+        coarseAt(b[0], b[1],     b[2] + 1), coarseAt(b[0] + 1, b[1],     b[2] + 1),
+        coarseAt(b[0], b[1] + 1, b[2] + 1), coarseAt(b[0] + 1, b[1] + 1, b[2] + 1)
+    };
+
+    SDFQuery q{};
+    q.phi = trilinear(corner, t, &q.grad);
+    q.grad *= invH_ / kBrickCells;
+    return q;
+}
+
+void BrickSDF::prefetchAround(const Vec3& p_ls) const
+{
+    if (slots_.empty())
+        return;
+    hint_[0].store(p_ls.x, std::memory_order_relaxed);
+    hint_[1].store(p_ls.y, std::memory_order_relaxed);
+    hint_[2].store(p_ls.z, std::memory_order_relaxed);
+    hintSeq_.fetch_add(1, std::memory_order_release);
+}
+
+SDFQuery BrickSDF::queryLocal(const Vec3& p_ls) const
+{
+    prefetchAround(p_ls);
+
+    // Continuous sample coordinates, clamped into the domain
+    const Vec3 u = (p_ls - origin_) * invH_;
+    Vec3 uc;
+    uint32_t c[3];
+    double t[3];
+    for (int a = 0; a < 3; ++a) {
+        const uint32_t cells = bricksAcross_[a] * kBrickCells;
+        uc[a] = std::clamp(u[a], 0.0, double(cells));
+        c[a] = std::min(static_cast<uint32_t>(uc[a]), cells - 1);
+        t[a] = uc[a] - c[a];
+    }
+
+    SDFQuery q{};
+    bool inside = false;
+    const uint32_t brick = findBrick(c[0] / kBrickCells, c[1] / kBrickCells, c[2] / kBrickCells, &inside);
+    if (brick == kNoBrick) {
+        // Empty space: flat, like GridSDF beyond its band
+        q.phi = inside ? -band_ : band_;
+        q.grad = Vec3{0.0};
+    } else {
+        readers_.fetch_add(1, std::memory_order_seq_cst);
+        const uint32_t slot = slotOf_[brick].load(std::memory_order_seq_cst);
+        if (slot == kNoSlot) {
+            readers_.fetch_sub(1, std::memory_order_release);
+            misses_.fetch_add(1, std::memory_order_relaxed);
+            q = coarseQuery(uc);
+        } else {
+            const int16_t* s = &pool_[std::size_t(slot) * kBrickSamples] +
+                               (c[0] % kBrickCells) + kBrickSide * ((c[1] % kBrickCells) + kBrickSide * (c[2] % kBrickCells));
+            constexpr uint32_t dy = kBrickSide, dz = kBrickSide * kBrickSide;
+            const double corner[8] = {double(s[0]),       double(s[1]),
+                                      double(s[dy]),      double(s[dy + 1]),
+                                      double(s[dz]),      double(s[dz + 1]),
+                                      double(s[dz + dy]), double(s[dz + dy + 1])};
+            readers_.fetch_sub(1, std::memory_order_release);
+
+            q.phi = trilinear(corner, t, &q.grad) * quantum_;
+            q.grad *= quantum_ * invH_;
+        }
+    }
+
+    // Beyond the domain: add the distance to it
+    finishGridQuery(q, p_ls, (u - uc) * h_);
+    return q;
+}
+
+// ------------------------------------------------------------
+// Prefetch thread
+// ------------------------------------------------------------
+void BrickSDF::prefetchLoop()
+{
+    uint64_t seenSeq = 0;
+    uint64_t pass = 0;
+    Vec3 last{0.0};
+    bool settled = false;  // every brick around `last` is in the pool
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_) {
+        // Polled, so queries never have to wake anything
+        wake_.wait_for(lock, std::chrono::milliseconds(1));
+        if (stop_)
+            break;
+        const uint64_t seq = hintSeq_.load(std::memory_order_acquire);
+        if (seq == seenSeq)
+            continue;
+        seenSeq = seq;
+        const Vec3 p{hint_[0].load(std::memory_order_relaxed),
+                     hint_[1].load(std::memory_order_relaxed),
+                     hint_[2].load(std::memory_order_relaxed)};
+        if (settled && glm::length(p - last) < 0.5 * kBrickCells * h_)
+            continue;
+
+        lock.unlock();
+        settled = loadAround(p, ++pass);
+        last = p;
+        lock.lock();
+    }
+}
+
+bool BrickSDF::loadAround(const Vec3& p_ls, uint64_t pass)
+{
+    // Bricks within the radius, nearest first
+    const double width = kBrickCells * h_;
+    const double r2 = prefetchRadius_ * prefetchRadius_;
+    uint32_t lo[3], hi[3];
+    for (int a = 0; a < 3; ++a) {
+        const double l = std::floor((p_ls[a] - prefetchRadius_ - origin_[a]) / width);
+        const double u = std::floor((p_ls[a] + prefetchRadius_ - origin_[a]) / width);
+        if (u < 0.0 || l >= double(bricksAcross_[a]))
+            return true;
+        lo[a] = static_cast<uint32_t>(std::max(0.0, l));
+        hi[a] = static_cast<uint32_t>(std::min(double(bricksAcross_[a] - 1), u));
+    }
+
+    wanted_.clear();
+    for (uint32_t bz = lo[2]; bz <= hi[2]; ++bz)
+    for (uint32_t by = lo[1]; by <= hi[1]; ++by)
+    for (uint32_t bx = lo[0]; bx <= hi[0]; ++bx) {
+        const uint32_t coord[3] = {bx, by, bz};
+        const double d2 = brickDistance2(coord, p_ls);
+        if (d2 > r2)
+            continue;
+        bool inside;
+        const uint32_t brick = findBrick(bx, by, bz, &inside);
+        if (brick != kNoBrick)
+            wanted_.push_back({d2, Slot{brick, {bx, by, bz}}});
+    }
+
+    // When the pool can't hold them all, the nearest win
+    bool complete = wanted_.size() <= slots_.size();
+    if (!complete) {
+        std::nth_element(wanted_.begin(), wanted_.begin() + slots_.size(), wanted_.end(),
+                         [](const Wanted& a, const Wanted& b) { return a.d2 < b.d2; });
+        wanted_.resize(slots_.size());
+    }
+    for (const Wanted& w : wanted_)
+        wantedIn_[w.slot.brick] = pass;
+    wanted_.erase(std::remove_if(wanted_.begin(), wanted_.end(),
+                                 [this](const Wanted& w) {
+                                     return slotOf_[w.slot.brick].load(std::memory_order_relaxed) != kNoSlot;
+                                 }),
+                  wanted_.end());
+    std::sort(wanted_.begin(), wanted_.end(),
+              [](const Wanted& a, const Wanted& b) { return a.d2 < b.d2; });
+
+    if (freeSlots_.size() < wanted_.size())
+        evict(p_ls, pass, wanted_.size() - freeSlots_.size());
+
+    for (const Wanted& w : wanted_) {
+        const uint32_t slot = freeSlots_.back();
+
+        // The disk read, if the OS file cache doesn't have it. A plain read
+        // rather than a copy out of the mapping: a fault there maps the
+        // neighbouring pages too, which would pile up in the resident set.
+        const std::size_t offset = bricksOffset_ + std::size_t(w.slot.brick) * kBrickStride;
+        if (!file_.read(offset, &pool_[std::size_t(slot) * kBrickSamples], kBrickBytes)) {
+            complete = false; // stays coarse; asked for again next pass
+            continue;
+        }
+        freeSlots_.pop_back();
+        slots_[slot] = w.slot;
+        slotOf_[w.slot.brick].store(slot, std::memory_order_release);
+        resident_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return complete;
+}
+
+double BrickSDF::brickDistance2(const uint32_t coord[3], const Vec3& p_ls) const
+{
+    const double width = kBrickCells * h_;
+    double d2 = 0.0;
+    for (int a = 0; a < 3; ++a) {
+        const double lo = origin_[a] + coord[a] * width;
+        const double d = std::max({lo - p_ls[a], 0.0, p_ls[a] - lo - width});
+        d2 += d * d;
+    }
+    return d2;
+}
+
+void BrickSDF::evict(const Vec3& p_ls, uint64_t pass, std::size_t needed)
+{
+    // Farthest first, never what this pass wants; a few extra so the next
+    // passes don't each have to wait for queries to drain
+    victims_.clear();
+    for (uint32_t s = 0; s < slots_.size(); ++s)
+        if (slots_[s].brick != kNoBrick && wantedIn_[slots_[s].brick] != pass)
+            victims_.push_back({brickDistance2(slots_[s].coord, p_ls), s});
+    const std::size_t count = std::min(victims_.size(), std::max(needed, slots_.size() / 8));
+    std::partial_sort(victims_.begin(), victims_.begin() + count, victims_.end(),
+                      [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    for (std::size_t v = 0; v < count; ++v)
+        slotOf_[slots_[victims_[v].second].brick].store(kNoSlot, std::memory_order_seq_cst);
+
+    // A query that read the old slot index before the store above is still
+    // counted in readers_; once it is zero, nobody can be reading the slots
+    while (readers_.load(std::memory_order_seq_cst) != 0)
+        std::this_thread::yield();
+
+    for (std::size_t v = 0; v < count; ++v) {
+        const uint32_t slot = victims_[v].second;
+        slots_[slot].brick = kNoBrick;
+        freeSlots_.push_back(slot);
+    }
+    resident_.fetch_sub(count, std::memory_order_relaxed);
+}
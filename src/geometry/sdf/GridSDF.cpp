@@ -0,0 +1,340 @@
+#include "geometry/sdf/GridSDF.h"
+#include "geometry/sdf/MeshDistance.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+// ------------------------------------------------------------
+// Cache file
+// ------------------------------------------------------------
+//   GridSDFFileHeader, then nx * ny * nz floats (x fastest)
+
+static constexpr char     kGridSdfMagic[8] = {'G', 'R', 'I', 'D', 'S', 'D', 'F', '\0'};
+static constexpr uint32_t kGridSdfVersion  = 1;
+
+struct GridSDFFileHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t key;
+    double   origin[3];
+    double   voxel;
+    double   band;
+    uint32_t n[3];
+    uint32_t reserved2;
+    double   boundsLo[3];
+    double   boundsHi[3];
+};
+
+// Keeps a bad config from allocating the machine away (2 GiB of floats)
+static constexpr std::size_t kMaxSamples = std::size_t(1) << 29;
+
+// Default resolution when GridSDFConfig::voxel is 0
+static constexpr double kDefaultSamplesAcross = 128.0;
+
+// ------------------------------------------------------------
+// Bake
+// ------------------------------------------------------------
+std::shared_ptr<GridSDF> GridSDF::bake(const TriMesh& mesh, const GridSDFConfig& cfg)
+{
+    if (mesh.triangleCount() == 0) {
+        std::cerr << "GridSDF: mesh has no triangles\n";
+        return nullptr;
+    }
+
+    const Aabb bounds = mesh.bounds();
+    const Vec3 extent = bounds.extent();
+    const double longest = std::max({extent.x, extent.y, extent.z});
+    const double h = cfg.voxel > 0.0 ? cfg.voxel : longest / kDefaultSamplesAcross;
+    if (!(h > 0.0) || !std::isfinite(h)) {
+        std::cerr << "GridSDF: mesh has no extent\n";
+        return nullptr;
+    }
+    const uint32_t bandVoxels = std::max(1u, cfg.bandVoxels);
+
+    std::shared_ptr<GridSDF> grid(new GridSDF());
+    grid->h_ = h;
+    grid->invH_ = 1.0 / h;
+    grid->band_ = bandVoxels * h;
+    grid->meshBounds_ = bounds;
+    grid->key_ = cacheKey(mesh, cfg);
+
+    // One more voxel than the band on every side, so the border is outside
+    // the band and the flood fill can start anywhere on it
+    const double pad = (bandVoxels + 1) * h;
+    grid->origin_ = bounds.lo - Vec3{pad};
+    std::size_t total = 1;
+    for (int a = 0; a < 3; ++a) {
+        grid->n_[a] = static_cast<uint32_t>(std::ceil((extent[a] + 2.0 * pad) / h)) + 1;
+        total *= grid->n_[a];
+    }
+    if (total > kMaxSamples) {
+        std::cerr << "GridSDF: " << grid->n_[0] << "x" << grid->n_[1] << "x" << grid->n_[2]
+                  << " samples is too many; use a larger voxel\n";
+        return nullptr;
+    }
+
+    const uint32_t nx = grid->n_[0], ny = grid->n_[1], nz = grid->n_[2];
+    const float kUnset = std::numeric_limits<float>::infinity();
+    std::vector<float>& phi = grid->phi_;
+    phi.assign(total, kUnset);
+
+    // Sample index range each triangle's band covers
+    struct SampleRange { uint32_t lo[3], hi[3]; };
+    const std::vector<MeshTriangle> tris = prepareMeshTriangles(mesh);
+    std::vector<SampleRange> ranges(tris.size());
+    for (std::size_t t = 0; t < tris.size(); ++t) {
+        const MeshTriangle& tri = tris[t];
+        for (int a = 0; a < 3; ++a) {
+            const double lo = std::min({tri.a[a], tri.b[a], tri.c[a]}) - grid->origin_[a];
+            const double hi = std::max({tri.a[a], tri.b[a], tri.c[a]}) - grid->origin_[a];
+            ranges[t].lo[a] = static_cast<uint32_t>(std::max(0.0, std::floor(lo / h) - bandVoxels));
+            ranges[t].hi[a] = static_cast<uint32_t>(std::min(double(grid->n_[a] - 1), std::ceil(hi / h) + bandVoxels));
+        }
+    }
+
+    // Narrow band: threads take z slabs, so no two write the same sample
+    const double band2 = grid->band_ * grid->band_;
+    const uint32_t threadCount = cfg.threads > 0 ? cfg.threads
+                                                 : std::max(1u, std::thread::hardware_concurrency());
+    const uint32_t slabDepth = std::max(1u, nz / (threadCount * 8));
+    std::atomic<uint32_t> nextSlab{0};
+
+    auto bakeSlabs = [&] {
+        for (;;) {
+            const uint32_t z0 = nextSlab.fetch_add(slabDepth);
+            if (z0 >= nz)
+                return;
+            const uint32_t z1 = std::min(nz, z0 + slabDepth);
+
+            for (std::size_t t = 0; t < tris.size(); ++t) {
+                const SampleRange& r = ranges[t];
+                const uint32_t k0 = std::max(r.lo[2], z0);
+                const uint32_t k1 = std::min(r.hi[2] + 1, z1);
+                for (uint32_t k = k0; k < k1; ++k)
+                for (uint32_t j = r.lo[1]; j <= r.hi[1]; ++j)
+                for (uint32_t i = r.lo[0]; i <= r.hi[0]; ++i) {
+                    const Vec3 p = grid->origin_ + Vec3{double(i), double(j), double(k)} * h;
+                    bool outside;
+                    const double d2 = distanceSquared(tris[t], p, outside);
+                    float& out = phi[(std::size_t(k) * ny + j) * nx + i];
+                    if (d2 >= band2 || d2 >= double(out) * double(out))
+                        continue;
+                    const double dist = std::sqrt(d2);
+                    out = static_cast<float>(outside ? dist : -dist);
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (uint32_t w = 1; w < threadCount; ++w)
+        workers.emplace_back(bakeSlabs);
+    bakeSlabs();
+    for (std::thread& w : workers)
+        w.join();
+
+    // Outside the band: flood fill from the border marks what is outside,
+    // whatever it can't reach is inside
+    const float bandOut = static_cast<float>(grid->band_);
+    std::vector<uint32_t> queue;
+    auto visit = [&](uint32_t i, uint32_t j, uint32_t k) {
+        const std::size_t v = (std::size_t(k) * ny + j) * nx + i;
+        if (phi[v] == kUnset) {
+            phi[v] = bandOut;
+            queue.push_back(static_cast<uint32_t>(v));
+        }
+    };
+    for (uint32_t k = 0; k < nz; ++k)
+        for (uint32_t j = 0; j < ny; ++j)
+            for (uint32_t i = 0; i < nx; ++i)
+                if (i == 0 || j == 0 || k == 0 || i == nx - 1 || j == ny - 1 || k == nz - 1)
+                    visit(i, j, k);
+
+    while (!queue.empty()) {
+        const uint32_t v = queue.back();
+        queue.pop_back();
+        const uint32_t i = v % nx, j = (v / nx) % ny, k = v / (nx * ny);
+        if (i > 0)      visit(i - 1, j, k);
+        if (i + 1 < nx) visit(i + 1, j, k);
+        if (j > 0)      visit(i, j - 1, k);
+        if (j + 1 < ny) visit(i, j + 1, k);
+        if (k > 0)      visit(i, j, k - 1);
+        if (k + 1 < nz) visit(i, j, k + 1);
+    }
+
+    for (float& v : phi)
+        if (v == kUnset)
+            v = -bandOut;
+
+    return grid;
+}
+
+std::size_t GridSDF::sampleCount(const TriMesh& mesh, const GridSDFConfig& cfg)
+{
+    const Vec3 extent = mesh.bounds().extent();
+    const double longest = std::max({extent.x, extent.y, extent.z});
+    const double h = cfg.voxel > 0.0 ? cfg.voxel : longest / kDefaultSamplesAcross;
+    if (!(h > 0.0) || !std::isfinite(h))
+        return 0;
+    const double pad = (std::max(1u, cfg.bandVoxels) + 1) * h;
+    double total = 1.0;
+    for (int a = 0; a < 3; ++a)
+        total *= std::ceil((extent[a] + 2.0 * pad) / h) + 1.0;
+    return total < double(std::numeric_limits<std::size_t>::max()) ? static_cast<std::size_t>(total)
+                                                                    : std::numeric_limits<std::size_t>::max();
+}
+
+// ------------------------------------------------------------
+// Cache
+// ------------------------------------------------------------
+uint64_t GridSDF::cacheKey(const TriMesh& mesh, const GridSDFConfig& cfg)
+{
+    uint64_t h = fnv1a(mesh.contentHash(), &cfg.voxel, sizeof(cfg.voxel));
+    h = fnv1a(h, &cfg.bandVoxels, sizeof(cfg.bandVoxels));
+    return fnv1a(h, &kGridSdfVersion, sizeof(kGridSdfVersion));
+}
+
+bool GridSDF::save(const std::string& path) const
+{
+    // Write next to the target and rename, so a crash never leaves a
+    // half-written cache file that looks valid
+    const std::string tmp = path + ".tmp";
+    std::FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (!f) {
+        std::cerr << "GridSDF: cannot write " << tmp << "\n";
+        return false;
+    }
+
+    GridSDFFileHeader h{};
+    std::memcpy(h.magic, kGridSdfMagic, sizeof(h.magic));
+    h.version = kGridSdfVersion;
+    h.key = key_;
+    h.voxel = h_;
+    h.band = band_;
+    for (int a = 0; a < 3; ++a) {
+        h.origin[a] = origin_[a];
+        h.n[a] = n_[a];
+        h.boundsLo[a] = meshBounds_.lo[a];
+        h.boundsHi[a] = meshBounds_.hi[a];
+    }
+
+    bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1;
+    ok &= std::fwrite(phi_.data(), sizeof(float), phi_.size(), f) == phi_.size();
+    ok &= std::fclose(f) == 0;
+
+    std::error_code ec;
+    if (ok)
+        std::filesystem::rename(tmp, path, ec);
+    if (!ok || ec) {
+        std::cerr << "GridSDF: failed writing " << path << "\n";
+        std::filesystem::remove(tmp, ec);
+        return false;
+    }
+    return true;
+}
+
+std::shared_ptr<GridSDF> GridSDF::load(const std::string& path, uint64_t expectedKey)
+{
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f)
+        return nullptr; // not cached yet
+
+    GridSDFFileHeader h{};
+    const bool headerOk = std::fread(&h, sizeof(h), 1, f) == 1 &&
+                          std::memcmp(h.magic, kGridSdfMagic, sizeof(h.magic)) == 0 &&
+                          h.version == kGridSdfVersion;
+    if (!headerOk || h.key != expectedKey) {
+        std::cerr << "GridSDF: ignoring " << path
+                  << (headerOk ? " (baked from another mesh or config)\n" : " (not a grid SDF file)\n");
+        std::fclose(f);
+        return nullptr;
+    }
+
+    std::shared_ptr<GridSDF> grid(new GridSDF());
+    std::size_t total = 1;
+    for (int a = 0; a < 3; ++a) {
+        grid->origin_[a] = h.origin[a];
+        grid->n_[a] = h.n[a];
+        grid->meshBounds_.lo[a] = h.boundsLo[a];
+        grid->meshBounds_.hi[a] = h.boundsHi[a];
+        total *= h.n[a];
+    }
+    grid->h_ = h.voxel;
+    grid->invH_ = 1.0 / h.voxel;
+    grid->band_ = h.band;
+    grid->key_ = h.key;
+
+    const bool sizeOk = h.n[0] >= 2 && h.n[1] >= 2 && h.n[2] >= 2 && total <= kMaxSamples && h.voxel > 0.0;
+    if (sizeOk)
+        grid->phi_.resize(total);
+    if (!sizeOk || std::fread(grid->phi_.data(), sizeof(float), total, f) != total) {
+        std::cerr << "GridSDF: " << path << " is truncated or corrupt\n";
+        std::fclose(f);
+        return nullptr;
+    }
+    std::fclose(f);
+    return grid;
+}
+
+std::shared_ptr<GridSDF> GridSDF::loadOrBake(const TriMesh& mesh, const GridSDFConfig& cfg,
+                                             const std::string& cacheDir)
+{
+    const uint64_t key = cacheKey(mesh, cfg);
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.sdfgrid", static_cast<unsigned long long>(key));
+    const std::string path = (std::filesystem::path(cacheDir) / name).string();
+
+    if (std::shared_ptr<GridSDF> cached = load(path, key))
+        return cached;
+
+    std::shared_ptr<GridSDF> grid = bake(mesh, cfg);
+    if (!grid)
+        return nullptr;
+
+    std::error_code ec;
+    std::filesystem::create_directories(cacheDir, ec);
+    if (!grid->save(path))
+        std::cerr << "GridSDF: not cached, the mesh will be baked again next run\n";
+    return grid;
+}
+
+// ------------------------------------------------------------
+// Query
+// ------------------------------------------------------------
+SDFQuery GridSDF::queryLocal(const Vec3& p_ls) const
+{
+    // Continuous sample coordinates, clamped into the grid
+    const Vec3 u = (p_ls - origin_) * invH_;
+    Vec3 uc;
+    uint32_t c[3];
+    double t[3];
+    for (int a = 0; a < 3; ++a) {
+        uc[a] = std::clamp(u[a], 0.0, double(n_[a] - 1));
+        c[a] = std::min(static_cast<uint32_t>(uc[a]), n_[a] - 2);
+        t[a] = uc[a] - c[a];
+    }
+
+    const double corner[8] = {
+        at(c[0], c[1],     c[2]),     at(c[0] + 1, c[1],     c[2]),
+        at(c[0], c[1] + 1, c[2]),     at(c[0] + 1, c[1] + 1, c[2]),
+        at(c[0], c[1],     c[2] + 1), at(c[0] + 1, c[1],     c[2] + 1),
+        at(c[0], c[1] + 1, c[2] + 1), at(c[0] + 1, c[1] + 1, c[2] + 1)
+    };
+
+    // Exact gradient of the trilinear interpolant
+    SDFQuery q{};
+    q.phi = trilinear(corner, t, &q.grad);
+    q.grad *= invH_;
+
+    // Beyond the grid: add the distance to it
+    finishGridQuery(q, p_ls, (u - uc) * h_);
+    return q;
+}
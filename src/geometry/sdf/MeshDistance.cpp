@@ -0,0 +1,117 @@
+#include "geometry/sdf/MeshDistance.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+namespace {
+
+// Closest feature of a triangle to a point; indexes MeshTriangle::normal
+enum Feature : uint8_t { VertA, VertB, VertC, EdgeAB, EdgeBC, EdgeCA, Face };
+
+// Closest point on triangle abc to p (Ericson, Real-Time Collision
+// Detection, 5.1.5), and which feature it lies on
+Vec3 closestOnTriangle(const Vec3& p, const Vec3& a, const Vec3& b, const Vec3& c, Feature& f) {
+    const Vec3 ab = b - a, ac = c - a, ap = p - a;
+    const double d1 = glm::dot(ab, ap), d2 = glm::dot(ac, ap);
+    if (d1 <= 0.0 && d2 <= 0.0) { f = VertA; return a; }
+
+    const Vec3 bp = p - b;
+    const double d3 = glm::dot(ab, bp), d4 = glm::dot(ac, bp);
+    if (d3 >= 0.0 && d4 <= d3) { f = VertB; return b; }
+
+    const double vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0) {
+        f = EdgeAB;
+        return a + ab * (d1 / (d1 - d3));
+    }
+
+    const Vec3 cp = p - c;
+    const double d5 = glm::dot(ab, cp), d6 = glm::dot(ac, cp);
+    if (d6 >= 0.0 && d5 <= d6) { f = VertC; return c; }
+
+    const double vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0) {
+        f = EdgeCA;
+        return a + ac * (d2 / (d2 - d6));
+    }
+
+    const double va = d3 * d6 - d5 * d4;
+    if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0) {
+        f = EdgeBC;
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+
+    const double denom = 1.0 / (va + vb + vc);
+    f = Face;
+    return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+double angleBetween(const Vec3& u, const Vec3& v) {
+    const double l = glm::length(u) * glm::length(v);
+    return l > 0.0 ? std::acos(std::clamp(glm::dot(u, v) / l, -1.0, 1.0)) : 0.0;
+}
+
+} // namespace
+
+// Pseudonormals: face normal for faces, sum of the two face normals for
+// edges, angle-weighted sum for vertices. The sign of
+// dot(p - closest, pseudonormal) is the inside / outside test.
+std::vector<MeshTriangle> prepareMeshTriangles(const TriMesh& mesh)
+{
+    const std::size_t triCount = mesh.triangleCount();
+
+    std::vector<Vec3> faceNormal(triCount, Vec3{0.0});
+    std::vector<Vec3> vertexNormal(mesh.vertices.size(), Vec3{0.0});
+    std::unordered_map<uint64_t, Vec3> edgeNormal;
+    auto edgeKey = [](uint32_t u, uint32_t v) {
+        return (uint64_t(std::min(u, v)) << 32) | std::max(u, v);
+    };
+
+    for (std::size_t t = 0; t < triCount; ++t) {
+        const uint32_t* idx = &mesh.indices[3 * t];
+        const Vec3& a = mesh.vertices[idx[0]];
+        const Vec3& b = mesh.vertices[idx[1]];
+        const Vec3& c = mesh.vertices[idx[2]];
+        const Vec3 n = glm::cross(b - a, c - a);
+        const double len = glm::length(n);
+        if (!(len > 0.0))
+            continue; // degenerate; its neighbours cover the surface
+        faceNormal[t] = n / len;
+
+        vertexNormal[idx[0]] += angleBetween(b - a, c - a) * faceNormal[t];
+        vertexNormal[idx[1]] += angleBetween(c - b, a - b) * faceNormal[t];
+        vertexNormal[idx[2]] += angleBetween(a - c, b - c) * faceNormal[t];
+        for (int e = 0; e < 3; ++e)
+            edgeNormal[edgeKey(idx[e], idx[(e + 1) % 3])] += faceNormal[t];
+    }
+
+    std::vector<MeshTriangle> tris;
+    tris.reserve(triCount);
+    for (std::size_t t = 0; t < triCount; ++t) {
+        if (glm::dot(faceNormal[t], faceNormal[t]) == 0.0)
+            continue;
+        const uint32_t* idx = &mesh.indices[3 * t];
+        MeshTriangle mt{};
+        mt.a = mesh.vertices[idx[0]];
+        mt.b = mesh.vertices[idx[1]];
+        mt.c = mesh.vertices[idx[2]];
+        mt.normal[VertA]  = vertexNormal[idx[0]];
+        mt.normal[VertB]  = vertexNormal[idx[1]];
+        mt.normal[VertC]  = vertexNormal[idx[2]];
+        mt.normal[EdgeAB] = edgeNormal[edgeKey(idx[0], idx[1])];
+        mt.normal[EdgeBC] = edgeNormal[edgeKey(idx[1], idx[2])];
+        mt.normal[EdgeCA] = edgeNormal[edgeKey(idx[2], idx[0])];
+        mt.normal[Face]   = faceNormal[t];
+        tris.push_back(mt);
+    }
+    return tris;
+}
+
+double distanceSquared(const MeshTriangle& t, const Vec3& p, bool& outside)
+{
+    Feature f;
+    const Vec3 d = p - closestOnTriangle(p, t.a, t.b, t.c, f);
+    outside = glm::dot(d, t.normal[f]) >= 0.0;
+    return glm::dot(d, d);
+}
@@ -10,3 +10,10 @@ SDFQuery PlaneSDF::queryLocal(const Vec3& x_ls) const {
     q.grad = n_;
     return q;
 }
+
+bool PlaneSDF::primitive(SDFPrimitive& out) const {
+    out.kind = SDFPrimitive::Kind::Plane;
+    out.normal = n_;
+    out.offset = b_;
+    return true;
+}
@@ -0,0 +1,235 @@
+#include "geometry/sdf/PrimitiveBatch.h"
+#include "geometry/sdf/PrimitiveKernels.h"
+
+#include <cmath>
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PRIMITIVE_BATCH_X86 1
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace {
+
+using sdfbatch::kLanes;
+
+// ------------------------------------------------------------
+// Vector ops for the kernel (PrimitiveKernels.h)
+// ------------------------------------------------------------
+struct ScalarOps {
+    using reg = float;
+    static constexpr uint32_t kWidth = 1;
+    static reg set1(float v) { return v; }
+    static reg iota() { return 0.0f; }
+    static reg load(const float* p) { return *p; }
+    static void store(float* p, reg v) { *p = v; }
+    static reg add(reg a, reg b) { return a + b; }
+    static reg sub(reg a, reg b) { return a - b; }
+    static reg mul(reg a, reg b) { return a * b; }
+    static reg min(reg a, reg b) { return a < b ? a : b; }
+    static reg max(reg a, reg b) { return a > b ? a : b; }
+    static reg sqrt(reg a) { return std::sqrt(a); }
+    static reg abs(reg a) { return std::fabs(a); }
+    static bool lt(reg a, reg b) { return a < b; }
+    static reg select(bool m, reg a, reg b) { return m ? a : b; }
+};
+
+#if defined(PRIMITIVE_BATCH_X86)
+struct Sse2Ops {
+    using reg = __m128;
+    static constexpr uint32_t kWidth = 4;
+    static reg set1(float v) { return _mm_set1_ps(v); }
+    static reg iota() { return _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f); }
+    static reg load(const float* p) { return _mm_loadu_ps(p); }
+    static void store(float* p, reg v) { _mm_storeu_ps(p, v); }
+    static reg add(reg a, reg b) { return _mm_add_ps(a, b); }
+    static reg sub(reg a, reg b) { return _mm_sub_ps(a, b); }
+    static reg mul(reg a, reg b) { return _mm_mul_ps(a, b); }
+    static reg min(reg a, reg b) { return _mm_min_ps(a, b); }
+    static reg max(reg a, reg b) { return _mm_max_ps(a, b); }
+    static reg sqrt(reg a) { return _mm_sqrt_ps(a); }
+    static reg abs(reg a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    static reg lt(reg a, reg b) { return _mm_cmplt_ps(a, b); }
+    static reg select(reg m, reg a, reg b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+};
+
+bool cpuHasAvx2() {
+#if defined(_MSC_VER)
+    int r[4];
+    __cpuid(r, 0);
+    if (r[0] < 7)
+        return false;
+    __cpuid(r, 1);
+    const bool osxsave = (r[2] & (1 << 27)) != 0;
+    const bool avx = (r[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+        return false;
+    __cpuidex(r, 7, 0);
+    return (r[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+using Isa = PrimitiveBatch::Isa;
+
+Isa detectIsa() {
+#if defined(PRIMITIVE_BATCH_X86)
+    return cpuHasAvx2() ? Isa::Avx2 : Isa::Sse2;
+#else
+    return Isa::Scalar;
+#endif
+}
+
+const Isa kIsa = detectIsa();
+
+// Values for pad entries that make every kernel return +inf
+constexpr float kInf = std::numeric_limits<float>::infinity();
+constexpr float kSpherePad[4] = {0.0f, 0.0f, 0.0f, -kInf};
+constexpr float kBoxPad[13] = {0.0f, 0.0f, 0.0f, 0, 0, 0, 0, 0, 0, 0, 0, 0, -kInf};
+constexpr float kPlanePad[4] = {0.0f, 0.0f, 0.0f, -kInf};
+
+} // namespace
+
+const char* PrimitiveBatch::isa() {
+    switch (kIsa) {
+        case Isa::Avx2: return "avx2";
+        case Isa::Sse2: return "sse2";
+        case Isa::Scalar: return "scalar";
+    }
+    return "scalar";
+}
+
+void PrimitiveBatch::clear() {
+    for (Group* g : {&spheres_, &boxes_, &planes_}) {
+        for (auto& f : g->f)
+            f.clear();
+        g->item.clear();
+    }
+    count_ = 0;
+}
+
+bool PrimitiveBatch::add(const SDF& sdf, const Pose& T_ws, uint32_t item) {
+    SDFPrimitive prim;
+    if (!sdf.primitive(prim))
+        return false;
+
+    const double s = T_ws.s;
+    switch (prim.kind) {
+        case SDFPrimitive::Kind::Sphere: {
+            const Vec3 c = T_ws.q * (s * prim.center) + T_ws.p;
+            const float v[4] = {float(c.x), float(c.y), float(c.z), float(s * prim.size)};
+            for (int k = 0; k < 4; ++k)
+                spheres_.f[k].push_back(v[k]);
+            spheres_.item.push_back(item);
+            break;
+        }
+        case SDFPrimitive::Kind::Box: {
+            const Vec3 c = T_ws.q * (s * prim.center) + T_ws.p;
+            const glm::dmat3 R = glm::mat3_cast(T_ws.q);
+            boxes_.f[0].push_back(float(c.x));
+            boxes_.f[1].push_back(float(c.y));
+            boxes_.f[2].push_back(float(c.z));
+            for (int i = 0; i < 3; ++i)      // R^T row i = column i of R
+                for (int j = 0; j < 3; ++j)
+                    boxes_.f[3 + 3 * i + j].push_back(float(R[i][j]));
+            boxes_.f[12].push_back(float(s * prim.size));
+            boxes_.item.push_back(item);
+            break;
+        }
+        case SDFPrimitive::Kind::Plane: {
+            // phi_ws = s * (n . p_ls - b) = n_ws . (p - t) - s * b
+            const Vec3 n = T_ws.q * prim.normal;
+            const float v[4] = {float(n.x), float(n.y), float(n.z),
+                                float(glm::dot(n, T_ws.p) + s * prim.offset)};
+            for (int k = 0; k < 4; ++k)
+                planes_.f[k].push_back(v[k]);
+            planes_.item.push_back(item);
+            break;
+        }
+    }
+    ++count_;
+    return true;
+}
+
+void PrimitiveBatch::pad(Group& g, const float* padValues, uint32_t fields) {
+    while (g.item.size() % kLanes != 0) {
+        for (uint32_t k = 0; k < fields; ++k)
+            g.f[k].push_back(padValues[k]);
+        g.item.push_back(kNone);
+    }
+}
+
+void PrimitiveBatch::finish() {
+    pad(spheres_, kSpherePad, 4);
+    pad(boxes_, kBoxPad, 13);
+    pad(planes_, kPlanePad, 4);
+}
+
+bool PrimitiveBatch::supports(Isa isa) {
+    switch (isa) {
+        case Isa::Avx2: return kIsa == Isa::Avx2;
+#if defined(PRIMITIVE_BATCH_X86)
+        case Isa::Sse2: return true;
+#else
+        case Isa::Sse2: return false;
+#endif
+        case Isa::Scalar: return true;
+    }
+    return false;
+}
+
+PrimitiveBatch::Hit PrimitiveBatch::nearest(const Vec3& p_ws) const {
+    return nearest(p_ws, kIsa);
+}
+
+PrimitiveBatch::Hit PrimitiveBatch::nearest(const Vec3& p_ws, Isa isa) const {
+    // The kernel starts from a finite "far", so it would report index 0
+    if (count_ == 0)
+        return {kInf, kNone};
+
+    sdfbatch::SoA s{};
+    s.sx = spheres_.f[0].data(); s.sy = spheres_.f[1].data(); s.sz = spheres_.f[2].data();
+    s.sr = spheres_.f[3].data();
+    s.spheres = static_cast<uint32_t>(spheres_.size());
+
+    s.bx = boxes_.f[0].data(); s.by = boxes_.f[1].data(); s.bz = boxes_.f[2].data();
+    for (int k = 0; k < 9; ++k)
+        s.rt[k] = boxes_.f[3 + k].data();
+    s.bh = boxes_.f[12].data();
+    s.boxes = static_cast<uint32_t>(boxes_.size());
+
+    s.nx = planes_.f[0].data(); s.ny = planes_.f[1].data(); s.nz = planes_.f[2].data();
+    s.nd = planes_.f[3].data();
+    s.planes = static_cast<uint32_t>(planes_.size());
+
+    sdfbatch::Nearest n{kInf, 0};
+    const float px = float(p_ws.x), py = float(p_ws.y), pz = float(p_ws.z);
+    switch (isa) {
+#if defined(PRIMITIVE_BATCH_X86)
+        case Isa::Avx2: sdfbatch::nearestAvx2(s, px, py, pz, n); break;
+        case Isa::Sse2: sdfbatch::nearestKernel<Sse2Ops>(s, px, py, pz, n); break;
+#endif
+        default:        sdfbatch::nearestKernel<ScalarOps>(s, px, py, pz, n); break;
+    }
+
+    if (!(n.phi < kInf))
+        return {kInf, kNone};
+
+    // Kernel index runs over spheres, then boxes, then planes
+    uint32_t i = n.index;
+    if (i < s.spheres)
+        return {n.phi, spheres_.item[i]};
+    i -= s.spheres;
+    if (i < s.boxes)
+        return {n.phi, boxes_.item[i]};
+    i -= s.boxes;
+    return {n.phi, planes_.item[i]};
+}
@@ -0,0 +1,39 @@
+// Built with AVX2 enabled (see CMakeLists.txt) and only entered after the
+// runtime CPU check in PrimitiveBatch.cpp. Keep it to intrinsics: no std::
+// inline code, which the linker could share with non-AVX2 translation units.
+#include "geometry/sdf/PrimitiveKernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+
+namespace sdfbatch {
+
+namespace {
+
+struct Avx2Ops {
+    using reg = __m256;
+    static constexpr uint32_t kWidth = 8;
+    static reg set1(float v) { return _mm256_set1_ps(v); }
+    static reg iota() { return _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f); }
+    static reg load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(float* p, reg v) { _mm256_storeu_ps(p, v); }
+    static reg add(reg a, reg b) { return _mm256_add_ps(a, b); }
+    static reg sub(reg a, reg b) { return _mm256_sub_ps(a, b); }
+    static reg mul(reg a, reg b) { return _mm256_mul_ps(a, b); }
+    static reg min(reg a, reg b) { return _mm256_min_ps(a, b); }
+    static reg max(reg a, reg b) { return _mm256_max_ps(a, b); }
+    static reg sqrt(reg a) { return _mm256_sqrt_ps(a); }
+    static reg abs(reg a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+    static reg lt(reg a, reg b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static reg select(reg m, reg a, reg b) { return _mm256_blendv_ps(b, a, m); }
+};
+
+} // namespace
+
+void nearestAvx2(const SoA& s, float px, float py, float pz, Nearest& out) {
+    nearestKernel<Avx2Ops>(s, px, py, pz, out);
+}
+
+} // namespace sdfbatch
+
+#endif
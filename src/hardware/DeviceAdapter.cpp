@@ -1,4 +1,5 @@
 #include "hardware/DeviceAdapter.h"
+#include "trace/Trace.h"
 #include <iostream>
 #include <chrono>
 #include <cmath>
@@ -124,8 +125,8 @@ static bool shouldPauseTorqueTxForWatchdog(WatchdogTxPauseConfig& cfg, double ti
     return false;
 }
 
-DeviceAdapter::DeviceAdapter(msg::Channel<ToolStateMsg>& deviceIn, msg::Channel<HapticWrenchCmd>& deviceCmdOut, 
-                            msg::Channel<DeviceTimingLogMsg>& timingLogOut, msg::Channel<DeviceStateLogMsg>& stateLogOut)
+DeviceAdapter::DeviceAdapter(msg::MailboxChannel<ToolStateMsg>& deviceIn, msg::MailboxChannel<HapticWrenchCmd>& deviceCmdOut, 
+                            msg::SpscChannel<DeviceTimingLogMsg>& timingLogOut, msg::SpscChannel<DeviceStateLogMsg>& stateLogOut)
     : deviceIn_(deviceIn),
       deviceCmdOut_(deviceCmdOut),
       timingLogOut_(timingLogOut),
@@ -203,6 +204,8 @@ bool DeviceAdapter::parseIncoming(std::vector<uint8_t>& newData, DeviceStatePack
 }
 
 void DeviceAdapter::update(double timeNow) {
+    TRACE_SCOPE("DeviceAdapter::update");
+
     static WatchdogTxPauseConfig watchdogTxPauseCfg = loadWatchdogTxPauseConfig();
 
     static uint64_t lastUpdateNs = 0;
@@ -221,7 +224,11 @@ void DeviceAdapter::update(double timeNow) {
 
     // Read from firmware
     std::vector<uint8_t> chunk;
-    size_t n = link_.readAvailable(chunk);
+    size_t n = 0;
+    {
+        TRACE_SCOPE("DeviceAdapter::readSerial");
+        n = link_.readAvailable(chunk);
+    }
     if (n > 0) {
         lastChunkReadNs_ = nowNs();
         incomingBuffer_.insert(incomingBuffer_.end(), chunk.begin(), chunk.end());
@@ -234,6 +241,7 @@ void DeviceAdapter::update(double timeNow) {
 
     // Parse everything currently buffered, keep only newest valid packet
     int parsedCount = 0;
+    stateBatch_.clear();
     while (tryParseOnePacket(pkt)) {
         uint64_t parseNs = nowNs();
         DeviceStateLogMsg stateMsg{};
@@ -249,13 +257,23 @@ void DeviceAdapter::update(double timeNow) {
         stateMsg.sat1 = pkt.saturation_active[0];
         stateMsg.sat2 = pkt.saturation_active[1];
 
-        stateLogOut_.publish(stateMsg);
+        if (stateBatch_.full()) {
+            stateLogOut_.publishBatch(stateBatch_);
+            stateBatch_.clear();
+        }
+        stateBatch_.push_back(stateMsg);
 
         newestPkt = pkt;
         newestRxParseNs = parseNs;
         gotState = true;
         parsedCount++;
     }
+    stateLogOut_.publishBatch(stateBatch_);
+
+    if (latency_ && parsedCount > 0 && lastChunkReadNs_ != lastStateChunkNs_) {
+        latency_->record(LoopStage::StateInterArrival, lastStateChunkNs_, lastChunkReadNs_);
+        lastStateChunkNs_ = lastChunkReadNs_;
+    }
 
     uint64_t toolPublishNs = 0;
     if (parsedCount > 0 && counter % DEBUG_DEVICE_PARSE_RATE == 0 && DEBUG_DEVICE_PARSE_PRINT) {
@@ -297,15 +315,9 @@ void DeviceAdapter::update(double timeNow) {
 
     }
 
-    // Read newest haptic command
-    HapticWrenchCmd out{};
+    // Read newest haptic command (mailbox conflates anything older)
     HapticWrenchCmd newestOut{};
-    bool gotCmd = false;
-
-    while (deviceCmdOut_.tryConsume(out)) {
-        newestOut = out;
-        gotCmd = true;
-    }
+    bool gotCmd = deviceCmdOut_.tryRead(newestOut, cmdVersion_);
 
     if (gotCmd) {
         logMsg.t_wrench_consume_ns = nowNs();
@@ -336,6 +348,7 @@ void DeviceAdapter::update(double timeNow) {
 
         bool ok = true;
         if (!pauseTx) {
+            TRACE_SCOPE("DeviceAdapter::sendTorque");
             logMsg.t_tx_start_ns = nowNs();
             ok = link_.sendRaw(reinterpret_cast<uint8_t*>(&pkt_out), sizeof(TorqueCommandPacket));
             logMsg.t_tx_done_ns = nowNs();
@@ -352,7 +365,16 @@ void DeviceAdapter::update(double timeNow) {
 
         if (matchedCycle) {
             timingLogOut_.publish(logMsg);
+
+            if (latency_) {
+                latency_->record(LoopStage::RxToToolPublish, logMsg.t_rx_parse_ns, logMsg.t_tool_publish_ns);
+                latency_->record(LoopStage::ToolPublishToWrench, logMsg.t_tool_publish_ns, logMsg.t_wrench_consume_ns);
+                latency_->record(LoopStage::WrenchToTxStart, logMsg.t_wrench_consume_ns, logMsg.t_tx_start_ns);
+                latency_->record(LoopStage::TxWrite, logMsg.t_tx_start_ns, logMsg.t_tx_done_ns);
+                latency_->record(LoopStage::RxToTxDone, logMsg.t_rx_parse_ns, logMsg.t_tx_done_ns);
+            }
         }
+        TRACE_COUNTER("device.tx_cmd_seq", pkt_out.cmd_seq);
 
         lastOut_ = newestOut;
     }
@@ -0,0 +1,374 @@
+#include "logging/ColumnarLog.h"
+#include "logging/Compress.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace logging {
+
+namespace {
+
+bool isInteger(ColumnType t) {
+    return t == ColumnType::U8 || t == ColumnType::U32 || t == ColumnType::U64;
+}
+
+bool validColumns(const ColumnDesc* cols, std::size_t colCount, uint32_t recordSize) {
+    for (std::size_t c = 0; c < colCount; ++c) {
+        const ColumnDesc& d = cols[c];
+        const bool codecOk = d.codec == ColumnCodec::Plain ||
+                             (d.codec == ColumnCodec::Delta && isInteger(d.type)) ||
+                             (d.codec == ColumnCodec::XorFloat && !isInteger(d.type));
+        if (!codecOk || d.offset + columnSize(d.type) > recordSize) {
+            std::cerr << "ColumnarLog: bad column description for '" << d.name << "'\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64_t loadUnsigned(const uint8_t* p, std::size_t width) {
+    uint64_t v = 0;
+    std::memcpy(&v, p, width); // little-endian
+    return v;
+}
+
+// ---- Delta: zigzag varint of v[i] - v[i-1] ----
+
+void encodeDelta(const uint8_t* plain, std::size_t rows, std::size_t width, std::vector<uint8_t>& out) {
+    uint64_t prev = 0;
+    for (std::size_t r = 0; r < rows; ++r) {
+        const uint64_t v = loadUnsigned(plain + r * width, width);
+        const int64_t  d = static_cast<int64_t>(v - prev);
+        uint64_t z = (static_cast<uint64_t>(d) << 1) ^ static_cast<uint64_t>(d >> 63);
+        prev = v;
+
+        while (z >= 0x80) {
+            out.push_back(static_cast<uint8_t>(z | 0x80));
+            z >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(z));
+    }
+}
+
+bool decodeDelta(const uint8_t* in, std::size_t n, std::size_t rows, std::size_t width, uint8_t* plain) {
+    const uint8_t* const end = in + n;
+    uint64_t prev = 0;
+    for (std::size_t r = 0; r < rows; ++r) {
+        uint64_t z = 0;
+        for (unsigned shift = 0;; shift += 7) {
+            if (in == end || shift > 63) return false;
+            const uint8_t b = *in++;
+            z |= static_cast<uint64_t>(b & 0x7F) << shift;
+            if (!(b & 0x80)) break;
+        }
+        const int64_t d = static_cast<int64_t>(z >> 1) ^ -static_cast<int64_t>(z & 1);
+        prev += static_cast<uint64_t>(d);
+        std::memcpy(plain + r * width, &prev, width);
+    }
+    return in == end;
+}
+
+// ---- XorFloat: XOR with the previous row, then byte planes ----
+
+void encodeXor(const uint8_t* plain, std::size_t rows, std::size_t width, std::vector<uint8_t>& out) {
+    const std::size_t base = out.size();
+    out.resize(base + rows * width);
+    uint8_t* planes = out.data() + base;
+
+    uint64_t prev = 0;
+    for (std::size_t r = 0; r < rows; ++r) {
+        const uint64_t v = loadUnsigned(plain + r * width, width);
+        const uint64_t x = v ^ prev;
+        prev = v;
+        for (std::size_t b = 0; b < width; ++b)
+            planes[b * rows + r] = static_cast<uint8_t>(x >> (8 * b));
+    }
+}
+
+void decodeXor(const uint8_t* planes, std::size_t rows, std::size_t width, uint8_t* plain) {
+    uint64_t prev = 0;
+    for (std::size_t r = 0; r < rows; ++r) {
+        uint64_t x = 0;
+        for (std::size_t b = 0; b < width; ++b)
+            x |= static_cast<uint64_t>(planes[b * rows + r]) << (8 * b);
+        prev ^= x;
+        std::memcpy(plain + r * width, &prev, width);
+    }
+}
+
+} // namespace
+
+std::string columnarPath(const std::string& directory, const std::string& baseName) {
+    return directory + "/" + baseName + ".col";
+}
+
+// ------------------------------------------------------------
+// ColumnarWriter
+// ------------------------------------------------------------
+
+ColumnarWriter::~ColumnarWriter() {
+    close();
+}
+
+bool ColumnarWriter::open(const std::string& path, const char* recordType, uint32_t recordSize,
+                          const ColumnDesc* cols, std::size_t colCount, std::size_t blockRows) {
+    close();
+
+    if (!validColumns(cols, colCount, recordSize) || blockRows == 0)
+        return false;
+
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) {
+        std::cerr << "ColumnarLog: cannot create " << path << "\n";
+        return false;
+    }
+    std::setvbuf(file_, nullptr, _IOFBF, 1 << 20);
+
+    cols_ = cols;
+    colCount_ = colCount;
+    recordSize_ = recordSize;
+    blockRows_ = blockRows;
+    pending_.resize(blockRows * recordSize);
+    pendingRows_ = 0;
+    rows_ = 0;
+    bytes_ = 0;
+    ok_ = true;
+
+    ColumnarFileHeader h{};
+    std::memcpy(h.magic, kColumnarMagic, sizeof(h.magic));
+    h.version = kColumnarVersion;
+    h.recordSize = recordSize;
+    h.columnCount = static_cast<uint32_t>(colCount);
+    h.blockRows = static_cast<uint32_t>(blockRows);
+    std::strncpy(h.recordType, recordType, sizeof(h.recordType) - 1);
+    ok_ &= std::fwrite(&h, sizeof(h), 1, file_) == 1;
+    bytes_ += sizeof(h);
+
+    for (std::size_t c = 0; c < colCount; ++c) {
+        ColumnarColumnEntry e{};
+        std::strncpy(e.name, cols[c].name, sizeof(e.name) - 1);
+        e.offset = cols[c].offset;
+        e.type = static_cast<uint8_t>(cols[c].type);
+        e.codec = static_cast<uint8_t>(cols[c].codec);
+        ok_ &= std::fwrite(&e, sizeof(e), 1, file_) == 1;
+        bytes_ += sizeof(e);
+    }
+    return ok_;
+}
+
+bool ColumnarWriter::append(const void* records, std::size_t count) {
+    if (!file_)
+        return false;
+
+    const auto* src = static_cast<const uint8_t*>(records);
+    while (count > 0) {
+        const std::size_t n = std::min(count, blockRows_ - pendingRows_);
+        std::memcpy(pending_.data() + pendingRows_ * recordSize_, src, n * recordSize_);
+        pendingRows_ += n;
+        src += n * recordSize_;
+        count -= n;
+
+        if (pendingRows_ == blockRows_ && !writeBlock())
+            return false;
+    }
+    return ok_;
+}
+
+bool ColumnarWriter::writeBlock() {
+    const std::size_t rows = pendingRows_;
+    if (rows == 0)
+        return ok_;
+
+    ColumnarBlockHeader bh{static_cast<uint32_t>(rows), static_cast<uint32_t>(colCount_)};
+    ok_ &= std::fwrite(&bh, sizeof(bh), 1, file_) == 1;
+    bytes_ += sizeof(bh);
+
+    for (std::size_t c = 0; c < colCount_; ++c) {
+        const ColumnDesc& d = cols_[c];
+        const std::size_t width = columnSize(d.type);
+
+        // Gather the field out of every row
+        column_.resize(rows * width);
+        const uint8_t* rec = pending_.data() + d.offset;
+        for (std::size_t r = 0; r < rows; ++r, rec += recordSize_)
+            std::memcpy(column_.data() + r * width, rec, width);
+
+        encoded_.clear();
+        switch (d.codec) {
+            case ColumnCodec::Plain:    encoded_ = column_; break;
+            case ColumnCodec::Delta:    encodeDelta(column_.data(), rows, width, encoded_); break;
+            case ColumnCodec::XorFloat: encodeXor(column_.data(), rows, width, encoded_); break;
+        }
+
+        packed_.clear();
+        lzCompress(encoded_.data(), encoded_.size(), packed_);
+        const bool raw = packed_.size() >= encoded_.size();
+        const std::vector<uint8_t>& stored = raw ? encoded_ : packed_;
+
+        ColumnarChunkHeader ch{static_cast<uint32_t>(encoded_.size()),
+                               static_cast<uint32_t>(stored.size())};
+        ok_ &= std::fwrite(&ch, sizeof(ch), 1, file_) == 1;
+        ok_ &= std::fwrite(stored.data(), 1, stored.size(), file_) == stored.size();
+        bytes_ += sizeof(ch) + stored.size();
+    }
+
+    rows_ += rows;
+    pendingRows_ = 0;
+    if (!ok_)
+        std::cerr << "ColumnarLog: write failed (disk full?)\n";
+    return ok_;
+}
+
+bool ColumnarWriter::close() {
+    if (!file_)
+        return false;
+
+    writeBlock();
+    ok_ &= std::fclose(file_) == 0;
+    file_ = nullptr;
+    return ok_;
+}
+
+// ------------------------------------------------------------
+// ColumnarReader
+// ------------------------------------------------------------
+
+ColumnarReader::~ColumnarReader() {
+    if (file_)
+        std::fclose(file_);
+}
+
+bool ColumnarReader::open(const std::string& path, const char* recordType, uint32_t recordSize,
+                          const ColumnDesc* cols, std::size_t colCount) {
+    if (file_) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f)
+        return false;
+
+    ColumnarFileHeader h{};
+    if (std::fread(&h, sizeof(h), 1, f) != 1 ||
+        std::memcmp(h.magic, kColumnarMagic, sizeof(h.magic)) != 0 ||
+        h.version != kColumnarVersion) {
+        std::cerr << "ColumnarLog: " << path << " is not a version " << kColumnarVersion << " columnar log\n";
+        std::fclose(f);
+        return false;
+    }
+
+    h.recordType[sizeof(h.recordType) - 1] = '\0';
+    if (std::strcmp(h.recordType, recordType) != 0 || h.recordSize != recordSize ||
+        h.columnCount != colCount || h.blockRows == 0) {
+        std::cerr << "ColumnarLog: " << path << " holds " << h.recordType << " (" << h.recordSize
+                  << " bytes, " << h.columnCount << " columns), expected " << recordType << " ("
+                  << recordSize << " bytes, " << colCount << " columns)\n";
+        std::fclose(f);
+        return false;
+    }
+
+    for (std::size_t c = 0; c < colCount; ++c) {
+        ColumnarColumnEntry e{};
+        if (std::fread(&e, sizeof(e), 1, f) != 1) {
+            std::cerr << "ColumnarLog: truncated column table in " << path << "\n";
+            std::fclose(f);
+            return false;
+        }
+        e.name[sizeof(e.name) - 1] = '\0';
+        if (std::strcmp(e.name, cols[c].name) != 0 || e.offset != cols[c].offset ||
+            e.type != static_cast<uint8_t>(cols[c].type) ||
+            e.codec != static_cast<uint8_t>(cols[c].codec)) {
+            std::cerr << "ColumnarLog: column " << c << " of " << path << " is '" << e.name
+                      << "', expected '" << cols[c].name << "' (re-pack from the segments)\n";
+            std::fclose(f);
+            return false;
+        }
+    }
+
+    file_ = f;
+    cols_ = cols;
+    colCount_ = colCount;
+    recordSize_ = recordSize;
+    blockRows_ = h.blockRows;
+    return true;
+}
+
+std::size_t ColumnarReader::readBlock(std::vector<uint8_t>& records) {
+    records.clear();
+    if (!file_)
+        return 0;
+
+    ColumnarBlockHeader bh{};
+    if (std::fread(&bh, sizeof(bh), 1, file_) != 1)
+        return 0; // end of file
+
+    if (bh.rows == 0 || bh.rows > blockRows_ || bh.columnCount != colCount_) {
+        std::cerr << "ColumnarLog: corrupt block header\n";
+        return 0;
+    }
+
+    const std::size_t rows = bh.rows;
+    records.assign(rows * recordSize_, 0); // padding bytes come back as zero
+
+    for (std::size_t c = 0; c < colCount_; ++c) {
+        const ColumnDesc& d = cols_[c];
+        const std::size_t width = columnSize(d.type);
+
+        ColumnarChunkHeader ch{};
+        if (std::fread(&ch, sizeof(ch), 1, file_) != 1 ||
+            ch.storedBytes > ch.encodedBytes || ch.encodedBytes > rows * 10) { // varint <= 10 B/value
+            std::cerr << "ColumnarLog: corrupt column '" << d.name << "'\n";
+            records.clear();
+            return 0;
+        }
+
+        stored_.resize(ch.storedBytes);
+        if (std::fread(stored_.data(), 1, stored_.size(), file_) != stored_.size()) {
+            std::cerr << "ColumnarLog: truncated block\n";
+            records.clear();
+            return 0;
+        }
+
+        if (ch.storedBytes == ch.encodedBytes) {
+            encoded_.swap(stored_);
+        } else {
+            encoded_.resize(ch.encodedBytes);
+            if (!lzDecompress(stored_.data(), stored_.size(), encoded_.data(), encoded_.size())) {
+                std::cerr << "ColumnarLog: corrupt compressed column '" << d.name << "'\n";
+                records.clear();
+                return 0;
+            }
+        }
+
+        column_.resize(rows * width);
+        bool ok = true;
+        switch (d.codec) {
+            case ColumnCodec::Plain:
+                ok = encoded_.size() == column_.size();
+                if (ok) std::memcpy(column_.data(), encoded_.data(), column_.size());
+                break;
+            case ColumnCodec::Delta:
+                ok = decodeDelta(encoded_.data(), encoded_.size(), rows, width, column_.data());
+                break;
+            case ColumnCodec::XorFloat:
+                ok = encoded_.size() == column_.size();
+                if (ok) decodeXor(encoded_.data(), rows, width, column_.data());
+                break;
+        }
+        if (!ok) {
+            std::cerr << "ColumnarLog: column '" << d.name << "' does not decode to " << rows << " rows\n";
+            records.clear();
+            return 0;
+        }
+
+        // Scatter back into the records
+        uint8_t* rec = records.data() + d.offset;
+        for (std::size_t r = 0; r < rows; ++r, rec += recordSize_)
+            std::memcpy(rec, column_.data() + r * width, width);
+    }
+    return rows;
+}
+
+} // namespace logging
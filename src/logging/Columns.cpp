@@ -0,0 +1,152 @@
+#include "logging/Columns.h"
+
+#include <charconv>
+#include <cstring>
+
+namespace logging {
+
+namespace {
+
+// Longest field: a double in shortest form is at most 24 characters
+constexpr std::size_t kMaxFieldChars = 32;
+
+template<typename T>
+T load(const uint8_t* p) {
+    T v;
+    std::memcpy(&v, p, sizeof(T));
+    return v;
+}
+
+char* formatField(char* out, char* end, const uint8_t* rec, const ColumnDesc& c) {
+    const uint8_t* p = rec + c.offset;
+    switch (c.type) {
+        case ColumnType::U8:  return std::to_chars(out, end, static_cast<unsigned>(*p)).ptr;
+        case ColumnType::U32: return std::to_chars(out, end, load<uint32_t>(p)).ptr;
+        case ColumnType::U64: return std::to_chars(out, end, load<uint64_t>(p)).ptr;
+        case ColumnType::F32: return std::to_chars(out, end, load<float>(p)).ptr;
+        case ColumnType::F64: return std::to_chars(out, end, load<double>(p)).ptr;
+    }
+    return out;
+}
+
+template<typename T>
+bool parseInto(const char* first, const char* last, uint8_t* p) {
+    T v{};
+    const auto r = std::from_chars(first, last, v);
+    if (r.ec != std::errc() || r.ptr != last)
+        return false;
+    std::memcpy(p, &v, sizeof(T));
+    return true;
+}
+
+bool parseField(const char* first, const char* last, uint8_t* rec, const ColumnDesc& c) {
+    uint8_t* p = rec + c.offset;
+    switch (c.type) {
+        case ColumnType::U8: {
+            unsigned v = 0;
+            const auto r = std::from_chars(first, last, v);
+            if (r.ec != std::errc() || r.ptr != last || v > 0xFF)
+                return false;
+            *p = static_cast<uint8_t>(v);
+            return true;
+        }
+        case ColumnType::U32: return parseInto<uint32_t>(first, last, p);
+        case ColumnType::U64: return parseInto<uint64_t>(first, last, p);
+        case ColumnType::F32: return parseInto<float>(first, last, p);
+        case ColumnType::F64: return parseInto<double>(first, last, p);
+    }
+    return false;
+}
+
+// Calls fn(first, last) for each comma-separated field; a trailing \r is dropped
+template<typename Fn>
+void forEachField(std::string_view line, Fn&& fn) {
+    if (!line.empty() && line.back() == '\r')
+        line.remove_suffix(1);
+
+    const char* p = line.data();
+    const char* const end = p + line.size();
+    for (;;) {
+        const char* comma = static_cast<const char*>(std::memchr(p, ',', static_cast<std::size_t>(end - p)));
+        const char* fieldEnd = comma ? comma : end;
+        if (!fn(p, fieldEnd) || !comma)
+            return;
+        p = comma + 1;
+    }
+}
+
+} // namespace
+
+std::string csvHeader(const ColumnDesc* cols, std::size_t count) {
+    std::string h;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (i > 0) h += ',';
+        h += cols[i].name;
+    }
+    return h;
+}
+
+void appendCsvRows(const void* records, std::size_t count, std::size_t recordSize,
+                   const ColumnDesc* cols, std::size_t colCount, std::string& out) {
+    const auto* rec = static_cast<const uint8_t*>(records);
+    const std::size_t rowMax = colCount * (kMaxFieldChars + 1);
+
+    std::size_t used = out.size();
+    out.resize(used + count * rowMax);
+    char* p = &out[used];
+    char* const end = out.data() + out.size();
+
+    for (std::size_t r = 0; r < count; ++r, rec += recordSize) {
+        for (std::size_t c = 0; c < colCount; ++c) {
+            p = formatField(p, end, rec, cols[c]);
+            *p++ = (c + 1 < colCount) ? ',' : '\n';
+        }
+    }
+    out.resize(static_cast<std::size_t>(p - out.data()));
+}
+
+bool CsvRowReader::setHeader(std::string_view header) {
+    fileToCol_.clear();
+    bool any = false;
+    forEachField(header, [&](const char* first, const char* last) {
+        const std::string_view name(first, static_cast<std::size_t>(last - first));
+        int col = kSkip;
+        for (std::size_t c = 0; c < colCount_; ++c) {
+            if (name == cols_[c].name) {
+                col = static_cast<int>(c);
+                any = true;
+                break;
+            }
+        }
+        fileToCol_.push_back(col);
+        return true;
+    });
+    return any;
+}
+
+std::vector<std::string> CsvRowReader::missingColumns() const {
+    std::vector<std::string> missing;
+    for (std::size_t c = 0; c < colCount_; ++c) {
+        bool found = false;
+        for (int m : fileToCol_)
+            found |= (m == static_cast<int>(c));
+        if (!found)
+            missing.emplace_back(cols_[c].name);
+    }
+    return missing;
+}
+
+bool CsvRowReader::parse(std::string_view line, void* record) const {
+    auto* rec = static_cast<uint8_t*>(record);
+    std::size_t field = 0;
+    bool ok = true;
+    forEachField(line, [&](const char* first, const char* last) {
+        if (field < fileToCol_.size() && fileToCol_[field] != kSkip)
+            ok = parseField(first, last, rec, cols_[fileToCol_[field]]);
+        ++field;
+        return ok;
+    });
+    return ok && field == fileToCol_.size();
+}
+
+} // namespace logging
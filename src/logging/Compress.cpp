@@ -0,0 +1,131 @@
+#include "logging/Compress.h"
+
+#include <cstring>
+
+namespace logging {
+
+namespace {
+
+constexpr std::size_t kMinMatch  = 4;
+constexpr std::size_t kMaxOffset = 65535;
+constexpr unsigned    kHashBits  = 13;
+
+uint32_t read32(const uint8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+uint32_t hash4(uint32_t v) {
+    return (v * 2654435761u) >> (32 - kHashBits);
+}
+
+// 15 in the token nibble, then 255-runs plus a final byte
+void putLength(std::vector<uint8_t>& out, std::size_t len) {
+    while (len >= 255) {
+        out.push_back(255);
+        len -= 255;
+    }
+    out.push_back(static_cast<uint8_t>(len));
+}
+
+void emitSequence(std::vector<uint8_t>& out, const uint8_t* lit, std::size_t litLen,
+                  std::size_t offset, std::size_t matchLen) {
+    const std::size_t m = matchLen ? matchLen - kMinMatch : 0;
+    const uint8_t token = static_cast<uint8_t>(((litLen < 15 ? litLen : 15) << 4) | (m < 15 ? m : 15));
+    out.push_back(token);
+    if (litLen >= 15)
+        putLength(out, litLen - 15);
+    out.insert(out.end(), lit, lit + litLen);
+
+    if (matchLen == 0)
+        return; // last sequence: literals only
+
+    out.push_back(static_cast<uint8_t>(offset & 0xFF));
+    out.push_back(static_cast<uint8_t>(offset >> 8));
+    if (m >= 15)
+        putLength(out, m - 15);
+}
+
+bool getLength(const uint8_t*& ip, const uint8_t* iend, std::size_t& len) {
+    for (;;) {
+        if (ip >= iend) return false;
+        const uint8_t b = *ip++;
+        len += b;
+        if (b != 255) return true;
+    }
+}
+
+} // namespace
+
+void lzCompress(const uint8_t* in, std::size_t n, std::vector<uint8_t>& out) {
+    std::vector<uint32_t> table(std::size_t(1) << kHashBits, UINT32_MAX);
+
+    std::size_t anchor = 0;
+    std::size_t i = 0;
+    while (i + kMinMatch <= n) {
+        const uint32_t seq = read32(in + i);
+        const uint32_t h = hash4(seq);
+        const uint32_t cand = table[h];
+        table[h] = static_cast<uint32_t>(i);
+
+        if (cand != UINT32_MAX && i - cand <= kMaxOffset && read32(in + cand) == seq) {
+            std::size_t len = kMinMatch;
+            while (i + len < n && in[cand + len] == in[i + len])
+                ++len;
+
+            emitSequence(out, in + anchor, i - anchor, i - cand, len);
+            i += len;
+            anchor = i;
+        } else {
+            ++i;
+        }
+    }
+    emitSequence(out, in + anchor, n - anchor, 0, 0);
+}
+
+bool lzDecompress(const uint8_t* in, std::size_t n, uint8_t* out, std::size_t rawSize) {
+    const uint8_t* ip = in;
+    const uint8_t* const iend = in + n;
+    uint8_t* op = out;
+    uint8_t* const oend = out + rawSize;
+
+    while (ip < iend) {
+        const uint8_t token = *ip++;
+
+        std::size_t litLen = token >> 4;
+        if (litLen == 15 && !getLength(ip, iend, litLen))
+            return false;
+        if (litLen > static_cast<std::size_t>(iend - ip) || litLen > static_cast<std::size_t>(oend - op))
+            return false;
+        std::memcpy(op, ip, litLen);
+        ip += litLen;
+        op += litLen;
+
+        if (ip == iend)
+            break; // last sequence
+
+        if (iend - ip < 2)
+            return false;
+        const std::size_t offset = static_cast<std::size_t>(ip[0]) | (static_cast<std::size_t>(ip[1]) << 8);
+        ip += 2;
+
+        std::size_t matchLen = token & 0xF;
+        if (matchLen == 15 && !getLength(ip, iend, matchLen))
+            return false;
+        matchLen += kMinMatch;
+
+        if (offset == 0 || offset > static_cast<std::size_t>(op - out) ||
+            matchLen > static_cast<std::size_t>(oend - op))
+            return false;
+
+        // Byte copy: matches may overlap their own output (runs)
+        const uint8_t* src = op - offset;
+        for (std::size_t k = 0; k < matchLen; ++k)
+            op[k] = src[k];
+        op += matchLen;
+    }
+    return op == oend;
+}
+
+} // namespace logging
@@ -0,0 +1,51 @@
+#include "logging/FlightRecorder.h"
+
+#include <iostream>
+
+namespace logging {
+
+FlightRecorderGroup::FlightRecorderGroup(const FlightRecorderConfig& cfg)
+    : cfg_(cfg) {
+    if (cfg_.ringRecords == 0)
+        cfg_.ringRecords = 1;
+}
+
+FlightRecorderGroup::~FlightRecorderGroup() {
+    if (triggerLog_)
+        std::fclose(triggerLog_);
+}
+
+bool FlightRecorderGroup::openTriggerLog(const std::string& directory) {
+    const std::string path = directory + "/flight_triggers.csv";
+    triggerLog_ = std::fopen(path.c_str(), "w");
+    if (!triggerLog_) {
+        std::cerr << "FlightRecorder: cannot write " << path << "\n";
+        return false;
+    }
+    std::fputs("t_ns,reason,window_opened\n", triggerLog_);
+    return true;
+}
+
+void FlightRecorderGroup::trigger(const char* reason, uint64_t nowNs) {
+    ++triggers_;
+
+    const bool opened = !capturing(nowNs);
+    if (opened) {
+        ++windows_;
+        const uint64_t fromNs = nowNs > cfg_.preNs ? nowNs - cfg_.preNs : 0;
+        for (FlightRecorderMember* m : members_)
+            m->flushPreTrigger(fromNs);
+    }
+
+    const uint64_t until = nowNs + cfg_.postNs;
+    if (until > captureUntilNs_)
+        captureUntilNs_ = until;
+
+    if (triggerLog_) {
+        std::fprintf(triggerLog_, "%llu,%s,%d\n",
+                     static_cast<unsigned long long>(nowNs), reason, opened ? 1 : 0);
+        std::fflush(triggerLog_); // a handful of lines; keep them if the run dies
+    }
+}
+
+} // namespace logging
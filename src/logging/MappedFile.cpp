@@ -0,0 +1,274 @@
+#include "logging/MappedFile.h"
+
+#include <algorithm>
+#include <iostream>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace logging {
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+#if defined(_WIN32)
+
+bool MappedFile::create(const std::string& path, std::size_t bytes) {
+    close();
+
+    HANDLE f = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ,
+                           nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (f == INVALID_HANDLE_VALUE) {
+        std::cerr << "MappedFile: cannot create " << path << " (error " << GetLastError() << ")\n";
+        return false;
+    }
+
+    const unsigned long long size = bytes;
+    HANDLE m = CreateFileMappingA(f, nullptr, PAGE_READWRITE,
+                                  static_cast<DWORD>(size >> 32),
+                                  static_cast<DWORD>(size & 0xFFFFFFFFull), nullptr);
+    if (!m) {
+        std::cerr << "MappedFile: CreateFileMapping failed for " << path << "\n";
+        CloseHandle(f);
+        return false;
+    }
+
+    void* p = MapViewOfFile(m, FILE_MAP_ALL_ACCESS, 0, 0, bytes);
+    if (!p) {
+        std::cerr << "MappedFile: MapViewOfFile failed for " << path << "\n";
+        CloseHandle(m);
+        CloseHandle(f);
+        return false;
+    }
+
+    file_ = f;
+    mapping_ = m;
+    data_ = p;
+    size_ = bytes;
+    path_ = path;
+    return true;
+}
+
+bool MappedFile::openRead(const std::string& path) {
+    close();
+
+    HANDLE f = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                           nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (f == INVALID_HANDLE_VALUE) {
+        std::cerr << "MappedFile: cannot open " << path << " (error " << GetLastError() << ")\n";
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(f, &size) || size.QuadPart == 0) {
+        std::cerr << "MappedFile: " << path << " is empty\n";
+        CloseHandle(f);
+        return false;
+    }
+
+    HANDLE m = CreateFileMappingA(f, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m) {
+        std::cerr << "MappedFile: CreateFileMapping failed for " << path << "\n";
+        CloseHandle(f);
+        return false;
+    }
+
+    void* p = MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0);
+    if (!p) {
+        std::cerr << "MappedFile: MapViewOfFile failed for " << path << "\n";
+        CloseHandle(m);
+        CloseHandle(f);
+        return false;
+    }
+
+    file_ = f;
+    mapping_ = m;
+    data_ = p;
+    size_ = static_cast<std::size_t>(size.QuadPart);
+    path_ = path;
+    return true;
+}
+
+void MappedFile::release(std::size_t offset, std::size_t bytes) {
+    if (!data_ || offset >= size_) return;
+    static const std::size_t page = [] {
+        SYSTEM_INFO si;
+        GetSystemInfo(&si);
+        return static_cast<std::size_t>(si.dwPageSize);
+    }();
+    const std::size_t first = offset / page * page;
+    const std::size_t last = std::min(size_, offset + bytes);
+    // Nothing here is locked, so this fails with ERROR_NOT_LOCKED, but it
+    // still takes the pages out of the working set
+    VirtualUnlock(static_cast<char*>(data_) + first, last - first);
+}
+
+bool MappedFile::read(std::size_t offset, void* dst, std::size_t bytes) const {
+    if (!file_ || offset + bytes > size_) return false;
+    auto* out = static_cast<char*>(dst);
+    while (bytes > 0) {
+        OVERLAPPED at{};
+        at.Offset = static_cast<DWORD>(offset & 0xFFFFFFFFull);
+        at.OffsetHigh = static_cast<DWORD>(static_cast<unsigned long long>(offset) >> 32);
+        DWORD got = 0;
+        const DWORD want = static_cast<DWORD>(std::min<std::size_t>(bytes, 1u << 30));
+        if (!ReadFile(static_cast<HANDLE>(file_), out, want, &got, &at) || got == 0)
+            return false;
+        out += got;
+        offset += got;
+        bytes -= got;
+    }
+    return true;
+}
+
+void MappedFile::flush(bool sync) {
+    if (!data_) return;
+    FlushViewOfFile(data_, 0);
+    if (sync)
+        FlushFileBuffers(static_cast<HANDLE>(file_));
+}
+
+void MappedFile::close(std::size_t finalSize) {
+    if (data_)
+        UnmapViewOfFile(data_);
+    if (mapping_)
+        CloseHandle(static_cast<HANDLE>(mapping_));
+
+    if (file_) {
+        if (finalSize != kKeepSize) {
+            LARGE_INTEGER end;
+            end.QuadPart = static_cast<LONGLONG>(finalSize);
+            SetFilePointerEx(static_cast<HANDLE>(file_), end, nullptr, FILE_BEGIN);
+            SetEndOfFile(static_cast<HANDLE>(file_));
+        }
+        CloseHandle(static_cast<HANDLE>(file_));
+    }
+
+    data_ = nullptr;
+    mapping_ = nullptr;
+    file_ = nullptr;
+    size_ = 0;
+    path_.clear();
+}
+
+#else
+
+bool MappedFile::create(const std::string& path, std::size_t bytes) {
+    close();
+
+    const int fd = ::open(path.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0644);
+    if (fd < 0) {
+        std::cerr << "MappedFile: cannot create " << path << "\n";
+        return false;
+    }
+
+    if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+        std::cerr << "MappedFile: ftruncate failed for " << path << "\n";
+        ::close(fd);
+        return false;
+    }
+
+    void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+        std::cerr << "MappedFile: mmap failed for " << path << "\n";
+        ::close(fd);
+        return false;
+    }
+
+    fd_ = fd;
+    data_ = p;
+    size_ = bytes;
+    path_ = path;
+    return true;
+}
+
+bool MappedFile::openRead(const std::string& path) {
+    close();
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "MappedFile: cannot open " << path << "\n";
+        return false;
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        std::cerr << "MappedFile: " << path << " is empty\n";
+        ::close(fd);
+        return false;
+    }
+    const std::size_t bytes = static_cast<std::size_t>(st.st_size);
+
+    void* p = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+        std::cerr << "MappedFile: mmap failed for " << path << "\n";
+        ::close(fd);
+        return false;
+    }
+
+    fd_ = fd;
+    data_ = p;
+    size_ = bytes;
+    path_ = path;
+    return true;
+}
+
+void MappedFile::release(std::size_t offset, std::size_t bytes) {
+    if (!data_ || offset >= size_) return;
+    static const std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    const std::size_t first = offset / page * page;
+    const std::size_t last = std::min(size_, offset + bytes);
+    madvise(static_cast<char*>(data_) + first, last - first, MADV_DONTNEED);
+}
+
+bool MappedFile::read(std::size_t offset, void* dst, std::size_t bytes) const {
+    if (fd_ < 0 || offset + bytes > size_) return false;
+    auto* out = static_cast<char*>(dst);
+    while (bytes > 0) {
+        const ssize_t got = pread(fd_, out, bytes, static_cast<off_t>(offset));
+        if (got <= 0) {
+            if (got < 0 && errno == EINTR) continue;
+            return false;
+        }
+        out += got;
+        offset += static_cast<std::size_t>(got);
+        bytes -= static_cast<std::size_t>(got);
+    }
+    return true;
+}
+
+void MappedFile::flush(bool sync) {
+    if (!data_) return;
+    msync(data_, size_, sync ? MS_SYNC : MS_ASYNC);
+}
+
+void MappedFile::close(std::size_t finalSize) {
+    if (data_)
+        munmap(data_, size_);
+
+    if (fd_ >= 0) {
+        if (finalSize != kKeepSize && ftruncate(fd_, static_cast<off_t>(finalSize)) != 0)
+            std::cerr << "MappedFile: could not trim " << path_ << "\n";
+        ::close(fd_);
+    }
+
+    data_ = nullptr;
+    fd_ = -1;
+    size_ = 0;
+    path_.clear();
+}
+
+#endif
+
+} // namespace logging
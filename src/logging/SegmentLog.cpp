@@ -0,0 +1,199 @@
+#include "logging/SegmentLog.h"
+
+#include <cstring>
+#include <iostream>
+#include <new>
+
+namespace logging {
+
+std::string segmentPath(const std::string& directory, const std::string& baseName, uint32_t index) {
+    char suffix[16];
+    std::snprintf(suffix, sizeof(suffix), ".%04u.seg", index);
+    return directory + "/" + baseName + suffix;
+}
+
+// ------------------------------------------------------------
+// SegmentWriter
+// ------------------------------------------------------------
+
+SegmentWriter::~SegmentWriter() {
+    close();
+}
+
+bool SegmentWriter::open(const SegmentLogConfig& cfg, const char* recordType, uint32_t recordSize) {
+    close();
+
+    cfg_ = cfg;
+    recordType_ = recordType;
+    recordSize_ = recordSize;
+    index_ = 0;
+    total_ = 0;
+
+    if (recordSize_ == 0 || cfg_.segmentBytes < kSegmentHeaderBytes + recordSize_) {
+        std::cerr << "SegmentWriter: segment size too small for " << recordType_ << "\n";
+        return false;
+    }
+    return openSegment();
+}
+
+bool SegmentWriter::openSegment() {
+    const std::string path = segmentPath(cfg_.directory, cfg_.baseName, index_);
+    if (!file_.create(path, cfg_.segmentBytes))
+        return false;
+
+    auto* base = static_cast<uint8_t*>(file_.data());
+    hdr_ = new (base) SegmentHeader{};
+    std::memcpy(hdr_->magic, kSegmentMagic, sizeof(hdr_->magic));
+    hdr_->version = kSegmentVersion;
+    hdr_->recordSize = recordSize_;
+    hdr_->capacity = (cfg_.segmentBytes - kSegmentHeaderBytes) / recordSize_;
+    hdr_->segmentIndex = index_;
+    std::strncpy(hdr_->recordType, recordType_.c_str(), sizeof(hdr_->recordType) - 1);
+    hdr_->committed.store(0, std::memory_order_release);
+
+    records_ = base + kSegmentHeaderBytes;
+    capacity_ = hdr_->capacity;
+    count_ = 0;
+    return true;
+}
+
+void SegmentWriter::sealSegment() {
+    if (!hdr_) return;
+
+    hdr_->sealed = 1;
+    file_.flush();
+    file_.close(kSegmentHeaderBytes + static_cast<std::size_t>(count_) * recordSize_);
+
+    hdr_ = nullptr;
+    records_ = nullptr;
+}
+
+bool SegmentWriter::append(const void* records, std::size_t count) {
+    if (!hdr_) return false;
+
+    const auto* src = static_cast<const uint8_t*>(records);
+    while (count > 0) {
+        if (count_ == capacity_) {
+            sealSegment();
+            ++index_;
+            if (!openSegment())
+                return false;
+        }
+
+        const std::size_t n = static_cast<std::size_t>(
+            count < capacity_ - count_ ? count : capacity_ - count_);
+        std::memcpy(records_ + count_ * recordSize_, src, n * recordSize_);
+
+        count_ += n;
+        total_ += n;
+        hdr_->committed.store(count_, std::memory_order_release); // record bytes land first
+
+        src += n * recordSize_;
+        count -= n;
+    }
+    return true;
+}
+
+void SegmentWriter::flush() {
+    file_.flush();
+}
+
+void SegmentWriter::close() {
+    sealSegment();
+}
+
+// ------------------------------------------------------------
+// SegmentReader
+// ------------------------------------------------------------
+
+SegmentReader::~SegmentReader() {
+    if (file_)
+        std::fclose(file_);
+}
+
+bool SegmentReader::open(const std::string& directory, const std::string& baseName,
+                         const char* recordType, uint32_t recordSize) {
+    directory_ = directory;
+    baseName_ = baseName;
+    recordType_ = recordType;
+    recordSize_ = recordSize;
+    unsealed_ = 0;
+    return openSegment(0);
+}
+
+bool SegmentReader::openSegment(uint32_t index) {
+    if (file_) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+    remaining_ = 0;
+
+    const std::string path = segmentPath(directory_, baseName_, index);
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f)
+        return false; // normal end of the series
+
+    // Read field by field: the header holds an atomic, so don't fread into one
+    char magic[8];
+    uint32_t version = 0, recSize = 0, segIndex = 0, sealed = 0;
+    uint64_t capacity = 0, committed = 0;
+    char type[sizeof(SegmentHeader::recordType)];
+
+    const bool ok =
+        std::fread(magic, sizeof(magic), 1, f) == 1 &&
+        std::fseek(f, offsetof(SegmentHeader, version), SEEK_SET) == 0 &&
+        std::fread(&version, sizeof(version), 1, f) == 1 &&
+        std::fread(&recSize, sizeof(recSize), 1, f) == 1 &&
+        std::fseek(f, offsetof(SegmentHeader, capacity), SEEK_SET) == 0 &&
+        std::fread(&capacity, sizeof(capacity), 1, f) == 1 &&
+        std::fseek(f, offsetof(SegmentHeader, segmentIndex), SEEK_SET) == 0 &&
+        std::fread(&segIndex, sizeof(segIndex), 1, f) == 1 &&
+        std::fread(&sealed, sizeof(sealed), 1, f) == 1 &&
+        std::fseek(f, offsetof(SegmentHeader, recordType), SEEK_SET) == 0 &&
+        std::fread(type, sizeof(type), 1, f) == 1 &&
+        std::fseek(f, offsetof(SegmentHeader, committed), SEEK_SET) == 0 &&
+        std::fread(&committed, sizeof(committed), 1, f) == 1;
+
+    type[sizeof(type) - 1] = '\0';
+    if (!ok || std::memcmp(magic, kSegmentMagic, sizeof(magic)) != 0 ||
+        version != kSegmentVersion || recSize != recordSize_ || recordType_ != type) {
+        std::cerr << "SegmentReader: " << path << " is not a " << recordType_
+                  << " segment log (version " << kSegmentVersion << ")\n";
+        std::fclose(f);
+        return false;
+    }
+
+    if (!sealed)
+        ++unsealed_;
+
+    std::fseek(f, static_cast<long>(kSegmentHeaderBytes), SEEK_SET);
+    file_ = f;
+    index_ = index;
+    remaining_ = committed < capacity ? committed : capacity;
+    return true;
+}
+
+std::size_t SegmentReader::read(void* out, std::size_t maxRecords) {
+    auto* dst = static_cast<uint8_t*>(out);
+    std::size_t total = 0;
+
+    while (total < maxRecords && file_) {
+        if (remaining_ == 0) {
+            if (!openSegment(index_ + 1))
+                break;
+            continue;
+        }
+
+        std::size_t want = maxRecords - total;
+        if (want > remaining_) want = static_cast<std::size_t>(remaining_);
+
+        const std::size_t got = std::fread(dst + total * recordSize_, recordSize_, want, file_);
+        total += got;
+        remaining_ -= got;
+        if (got < want)
+            remaining_ = 0; // file shorter than the header claims (crash mid-trim)
+    }
+    return total;
+}
+
+} // namespace logging
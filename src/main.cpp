@@ -32,27 +32,53 @@
 #include "data/Commands.h"
 #include "messaging/Channel.h"
 #include "messaging/SnapshotChannel.h"
+#include "messaging/SpscChannel.h"
+#include "messaging/MailboxChannel.h"
+#include "messaging/MpscChannel.h"
+#include "messaging/BroadcastChannel.h"
 #include "messaging/MessageBus.h"
+#include "messaging/Topics.h"
+#include "messaging/Selector.h"
+#include "messaging/ShmBridge.h"
+#include "messaging/Journal.h"
+#include "messaging/Telemetry.h"
 #include "engines/HapticEngine.h"
 #include "engines/PhysicsEnginePhysX.h"
 #include "hardware/DeviceAdapter.h"
 #include "data/LogMessages.h"
+#include "logging/SegmentLog.h"
+#include "logging/LogRecords.h"
+#include "logging/FlightRecorder.h"
+#include "logging/FlightTriggers.h"
+#include "trace/Trace.h"
 
 #include <thread>
 #include <atomic>
-#include <fstream>
 #include <vector>
 #include <chrono>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <ctime>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
 #pragma endregion
 
 
 void simulationLoop(
     WorldManager& wm,
     PhysicsEnginePhysX& physics,
+    msg::MpscChannel<WorldCommand>& worldCmds,
     msg::SnapshotChannel<WorldSnapshot>& worldSnaps,
     std::atomic<bool>& running
 ) {
+    trace::setThreadName("sim");
+
     const double maxDt = 1.0 / 30.0;
     auto prev = std::chrono::steady_clock::now();
 
@@ -69,44 +95,222 @@ void simulationLoop(
         WorldSnapshot snapshot = wm.buildSnapshot();
         worldSnaps.publish(snapshot);
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        // ~1 kHz tick, but wake straight away when a command arrives
+        worldCmds.waitFor(std::chrono::milliseconds(1));
     }
 }
 
-int main() {
+// logs/session_YYYYmmdd_HHMMSS, so runs never overwrite each other
+std::string sessionLogDir() {
+    char stamp[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(stamp, sizeof(stamp), "session_%Y%m%d_%H%M%S", std::localtime(&now));
+    return std::string("logs/") + stamp;
+}
+
+// Whole string as a decimal integer in [lo, hi]
+bool parseUnsigned(const char* s, unsigned long lo, unsigned long hi, unsigned long& out) {
+    if (!std::isdigit(static_cast<unsigned char>(s[0])))
+        return false; // strtoul would take "-1" and wrap it
+    errno = 0;
+    char* end = nullptr;
+    out = std::strtoul(s, &end, 10);
+    return errno == 0 && *end == '\0' && out >= lo && out <= hi;
+}
+
+// Whole string as a finite number
+bool parseNumber(const char* s, double& out) {
+    char* end = nullptr;
+    out = std::strtod(s, &end);
+    return end != s && *end == '\0' && std::isfinite(out);
+}
+
+template<typename T>
+bool openLogSink(logging::SegmentLog<T>& sink, const std::string& dir) {
+    logging::SegmentLogConfig cfg;
+    cfg.directory = dir;
+    cfg.baseName = logging::LogRecordTraits<T>::baseName;
+    return sink.open(cfg, logging::LogRecordTraits<T>::typeName);
+}
+
+int main(int argc, char** argv) {
+    // --headless: no window / GL. world.snapshots, haptics.snapshots, world.commands
+    // and haptics.tool_in are exported over shared memory for the separate
+    // `renderer` process (src/main_renderer.cpp) instead.
+    //
+    // --record <file>: journal device / world inputs and haptic outputs (messaging/Journal.h)
+    // --replay <file>: feed a recorded session back instead of the device;
+    //                  add --replay-fast to publish as fast as possible
+    // --log-dir <dir>: where the segment logs go (default logs/session_<time>)
+    // --flight-recorder: keep logs in memory and only write the seconds around
+    //                    watchdog / saturation / contact onset / deadline-miss
+    //                    triggers (logging/FlightRecorder.h)
+    // --trace <file>: record hot-path spans (trace/Trace.h), written as Chrome
+    //                 trace JSON on exit; open in ui.perfetto.dev
+    // --telemetry [port]: stream the log topics and haptics.snapshots to
+    //                     127.0.0.1:<port> (default 47800) over UDP while running;
+    //                     watch with `telemetry_recv` (messaging/Telemetry.h)
+    // --telemetry-decimate <topic>=<N>: send every Nth message of <topic>
+    // --mesh <file.obj|file.stl>: add a static triangle mesh to the scene,
+    //                             touchable through a baked SDF grid
+    //                             (geometry/sdf/GridSDF.h, cached in cache/sdf)
+    //                             or a .bricksdf baked by `sdf_bake`
+    // --mesh-scale <s>: uniform scale for --mesh, e.g. 0.001 for mm models
+    // --mesh-voxel <h>: SDF sample spacing for --mesh, in mesh units; fine
+    //                   enough for a dense grid to pass 256 MiB, the mesh gets
+    //                   a sparse BrickSDF paged from disk instead
+    bool headless = false;
+    std::string recordPath;
+    std::string replayPath;
+    bool replayFast = false;
+    std::string logDir;
+    std::string tracePath;
+    bool flightRecorder = false;
+    bool telemetry = false;
+    uint16_t telemetryPort = msg::kTelemetryDefaultPort;
+    std::string meshPath;
+    double meshScale = 1.0;
+    GridSDFConfig meshSdf;
+    std::map<std::string, uint32_t> telemetryDecimation = {
+        {msg::topics::DeviceTimingLog::name, 1},
+        {msg::topics::DeviceStateLog::name, 1},
+        {msg::topics::SimValidationLog::name, 10},
+        {msg::topics::HapticsSnapshots::name, 10},
+    };
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--headless")
+            headless = true;
+        else if (arg == "--record" && i + 1 < argc)
+            recordPath = argv[++i];
+        else if (arg == "--replay" && i + 1 < argc)
+            replayPath = argv[++i];
+        else if (arg == "--replay-fast")
+            replayFast = true;
+        else if (arg == "--log-dir" && i + 1 < argc)
+            logDir = argv[++i];
+        else if (arg == "--trace" && i + 1 < argc)
+            tracePath = argv[++i];
+        else if (arg == "--flight-recorder")
+            flightRecorder = true;
+        else if (arg == "--telemetry") {
+            telemetry = true;
+            if (i + 1 < argc && std::isdigit(static_cast<unsigned char>(argv[i + 1][0]))) {
+                unsigned long port = 0;
+                if (parseUnsigned(argv[++i], 1, 65535, port))
+                    telemetryPort = static_cast<uint16_t>(port);
+                else
+                    std::cerr << "Ignoring --telemetry " << argv[i] << " (expected a port, 1-65535)\n";
+            }
+        }
+        else if (arg == "--mesh" && i + 1 < argc)
+            meshPath = argv[++i];
+        else if (arg == "--mesh-scale" && i + 1 < argc) {
+            double s = 0.0;
+            if (parseNumber(argv[++i], s) && s > 0.0)
+                meshScale = s;
+            else
+                std::cerr << "Ignoring --mesh-scale " << argv[i] << " (expected a number > 0)\n";
+        }
+        else if (arg == "--mesh-voxel" && i + 1 < argc) {
+            double h = 0.0;
+            if (parseNumber(argv[++i], h) && h >= 0.0)
+                meshSdf.voxel = h; // 0: the bakers' default
+            else
+                std::cerr << "Ignoring --mesh-voxel " << argv[i] << " (expected a number >= 0)\n";
+        }
+        else if (arg == "--telemetry-decimate" && i + 1 < argc) {
+            const std::string spec = argv[++i];
+            const auto eq = spec.find('=');
+            unsigned long n = 0;
+            if (eq == std::string::npos || !telemetryDecimation.count(spec.substr(0, eq)) ||
+                !parseUnsigned(spec.c_str() + eq + 1, 1, UINT32_MAX, n))
+                std::cerr << "Ignoring --telemetry-decimate " << spec << " (expected <topic>=<N>)\n";
+            else
+                telemetryDecimation[spec.substr(0, eq)] = static_cast<uint32_t>(n);
+        }
+    }
+
+    trace::setThreadName(headless ? "main" : "render");
+    if (!tracePath.empty())
+        trace::enable();
+
     // ------------------------------------------------------------
     // Core systems
     // ------------------------------------------------------------
     GeometryDatabase geomDb;
     RenderMeshRegistry meshRegistry;
-    GeometryFactory geomFactory(geomDb, meshRegistry);
+    GeometryFactory geomFactory = headless ? GeometryFactory(geomDb)
+                                           : GeometryFactory(geomDb, meshRegistry);
 
     msg::MessageBus bus;
 
-    auto& worldCmds     = bus.channel<WorldCommand>("world.commands");
-    auto& worldSnaps    = bus.snapshot<WorldSnapshot>("world.snapshots");
-    auto& toolIn        = bus.channel<ToolStateMsg>("haptics.tool_in");
-    auto& hapticOut     = bus.channel<HapticSnapshotMsg>("haptics.snapshots");
-    auto& wrenchOut     = bus.channel<HapticWrenchCmd>("haptics.wrenches");
-    auto& deviceIn      = bus.channel<ToolStateMsg>("device.tool_in");
-    auto& deviceCmdOut  = bus.channel<HapticWrenchCmd>("device.wrench_cmd");
-    auto& timingLog     = bus.channel<DeviceTimingLogMsg>("logging.device_timing");
-    auto& stateLog      = bus.channel<DeviceStateLogMsg>("logging.device_state");
-    auto& simLog        = bus.channel<SimulationValidationLogMsg>("logging.sim_validation");
-
-    std::vector<DeviceTimingLogMsg> timingLogs;
-    std::vector<DeviceStateLogMsg> stateLogs;
-    std::vector<SimulationValidationLogMsg> simLogs;
+    // Channel types, names and capacities live in messaging/Topics.h
+    auto& worldCmds     = bus.get<msg::topics::WorldCommands>();
+    auto& worldSnaps    = bus.get<msg::topics::WorldSnapshots>();
+    auto& toolIn        = bus.get<msg::topics::HapticsToolIn>();
+    auto& hapticOut     = bus.get<msg::topics::HapticsSnapshots>();
+    auto& wrenchOut     = bus.get<msg::topics::HapticsWrenches>();
+    auto& deviceIn      = bus.get<msg::topics::DeviceToolIn>();
+    auto& deviceCmdOut  = bus.get<msg::topics::DeviceWrenchCmd>();
+    auto& timingLog     = bus.get<msg::topics::DeviceTimingLog>();
+    auto& stateLog      = bus.get<msg::topics::DeviceStateLog>();
+    auto& simLog        = bus.get<msg::topics::SimValidationLog>();
+
+    // ------------------------------------------------------------
+    // Log sinks: records stream into mmap'd segment files during the run
+    // (constant memory, survives a crash). `log_export <dir>` makes the CSVs.
+    // ------------------------------------------------------------
+    if (logDir.empty())
+        logDir = sessionLogDir();
+
+    std::error_code logDirErr;
+    std::filesystem::create_directories(logDir, logDirErr);
+
+    logging::SegmentLog<DeviceTimingLogMsg> timingSink;
+    logging::SegmentLog<DeviceStateLogMsg> stateSink;
+    logging::SegmentLog<SimulationValidationLogMsg> simSink;
+    if (logDirErr ||
+        !openLogSink(timingSink, logDir) ||
+        !openLogSink(stateSink, logDir) ||
+        !openLogSink(simSink, logDir)) {
+        std::cerr << "Logging to " << logDir << " failed, logs will be discarded\n";
+    }
+
+    // Flight-recorder mode: the sinks only receive the windows around triggers
+    logging::FlightRecorderGroup flight;
+    logging::FlightRecorder<DeviceTimingLogMsg> timingFlight(flight, timingSink);
+    logging::FlightRecorder<DeviceStateLogMsg> stateFlight(flight, stateSink);
+    logging::FlightRecorder<SimulationValidationLogMsg> simFlight(flight, simSink);
+    logging::FlightTriggers flightTriggers;
+    if (flightRecorder)
+        flight.openTriggerLog(logDir);
 
     WorldManager wm(geomDb, geomFactory, worldCmds);
 
-    Window win({});
-    GlSceneRenderer renderer(win, geomDb, meshRegistry, worldCmds, toolIn, hapticOut, worldSnaps);
+    std::unique_ptr<Window> win;
+    std::unique_ptr<GlSceneRenderer> renderer;
+    if (!headless) {
+        win = std::make_unique<Window>(Window::Config{});
+        renderer = std::make_unique<GlSceneRenderer>(
+            *win, geomDb, meshRegistry, worldCmds, toolIn, hapticOut, worldSnaps);
+        renderer->setChannelStatsSource(&bus); // "Channels" panel
+    }
+
+    // Headless: the renderer process attaches through shared memory. Set up
+    // before any thread starts, so a failure can still return from main.
+    std::unique_ptr<msg::ShmExporter> exporter;
+    if (headless) {
+        exporter = std::make_unique<msg::ShmExporter>(worldSnaps, hapticOut, worldCmds, toolIn);
+        if (!exporter->create()) {
+            return 1;
+        }
+    }
 
     HapticEngine haptics(
         geomDb,
         worldSnaps,
-        deviceIn,       // use toolIn for mouse control, deviceIn for real device input
+        deviceIn,       // real device input (mailbox, device thread -> haptics thread)
         hapticOut,
         wrenchOut,
         deviceCmdOut,
@@ -115,12 +319,18 @@ int main() {
 
     DeviceAdapter deviceAdapter(deviceIn, deviceCmdOut, timingLog, stateLog);
 
+    // Live closed-loop latency percentiles ("Loop latency" panel)
+    LoopLatency loopLatency;
+    deviceAdapter.setLatencyStats(&loopLatency);
+    if (renderer)
+        renderer->setLatencySource(&loopLatency);
+
     PhysicsEnginePhysX physics(
         wm,
         geomDb,
         wrenchOut,
         toolIn,
-        bus.channel<HapticWrenchCmd>("physics.haptics_wrenches")
+        bus.get<msg::topics::PhysicsHapticsWrenches>()
     );
     physics.setFixedDt(1.0 / 240.0);
 
@@ -147,6 +357,70 @@ int main() {
         1.0,
         false
     }});
+    if (!meshPath.empty()) {
+        // Static, resting on the ground plane next to the cube
+        if (GeometryID mesh = geomFactory.getMesh(meshPath, meshSdf)) {
+            const Aabb& b = geomDb.get(mesh).localBounds;
+            wm.apply(WorldCommand{CreateObjectCommand{
+                mesh,
+                Pose{{0.6, -b.lo.y * meshScale, 0.0}, {1, 0, 0, 0}, meshScale},
+                {0.7f, 0.7f, 0.6f},
+                Role::None,
+                1.0,
+                false
+            }});
+        }
+    }
+
+    // ------------------------------------------------------------
+    // Session journal (taps must be wired before threads publish)
+    // ------------------------------------------------------------
+    msg::JournalRecorder recorder;
+    if (!recordPath.empty()) {
+        // Inputs, needed for replay
+        recorder.record<msg::topics::DeviceToolIn>(bus);
+        recorder.record<msg::topics::WorldCommands>(bus);
+        recorder.record<msg::topics::HapticsToolIn>(bus);
+        // Outputs, kept to diff a replay against the original run
+        recorder.record<msg::topics::DeviceWrenchCmd>(bus);
+        recorder.record<msg::topics::HapticsWrenches>(bus);
+
+        if (!recorder.start(recordPath)) {
+            std::cerr << "Recording disabled\n";
+        }
+    }
+
+    // ------------------------------------------------------------
+    // Live telemetry (taps as above; the log topics are never journaled)
+    // ------------------------------------------------------------
+    msg::TelemetryPublisher telemetryOut;
+    if (telemetry) {
+        telemetryOut.stream<msg::topics::DeviceTimingLog>(bus, telemetryDecimation[msg::topics::DeviceTimingLog::name]);
+        telemetryOut.stream<msg::topics::DeviceStateLog>(bus, telemetryDecimation[msg::topics::DeviceStateLog::name]);
+        telemetryOut.stream<msg::topics::SimValidationLog>(bus, telemetryDecimation[msg::topics::SimValidationLog::name]);
+        telemetryOut.stream<msg::topics::HapticsSnapshots>(bus, telemetryDecimation[msg::topics::HapticsSnapshots::name]);
+
+        msg::TelemetryConfig cfg;
+        cfg.port = telemetryPort;
+        if (telemetryOut.start(cfg))
+            std::cout << "Telemetry on udp://" << cfg.host << ":" << cfg.port << "\n";
+        else
+            std::cerr << "Telemetry disabled\n";
+    }
+
+    // Sleeps until any log ring has data instead of polling every 1 ms
+    msg::Selector logSelect;
+    logSelect.add(timingLog);
+    logSelect.add(stateLog);
+    logSelect.add(simLog);
+
+    msg::JournalReplayer replayer;
+    const bool replaying = !replayPath.empty() && replayer.open(replayPath);
+    if (replaying) {
+        replayer.route<msg::topics::DeviceToolIn>(bus);
+        replayer.route<msg::topics::WorldCommands>(bus);
+        replayer.route<msg::topics::HapticsToolIn>(bus);
+    }
 
     // ------------------------------------------------------------
     // Thread running flags
@@ -162,71 +436,131 @@ int main() {
         simulationLoop,
         std::ref(wm),
         std::ref(physics),
+        std::ref(worldCmds),
         std::ref(worldSnaps),
         std::ref(simRunning)
     );
 
     std::thread hapticsThread(&HapticEngine::run, &haptics);
 
-    if (!deviceAdapter.connect("COM4", 460800)) {
-        std::cerr << "Failed to connect device on COM4\n";
+    std::thread deviceThread;
+    if (replaying) {
+        // The journal stands in for the device (device.tool_in has one producer)
+        deviceThread = std::thread([&]() {
+            trace::setThreadName("replay");
+            const std::size_t n = replayer.run(
+                replayFast ? msg::ReplayTiming::AsFastAsPossible : msg::ReplayTiming::Original,
+                appRunning);
+            std::cout << "Replay finished: " << n << " messages\n";
+        });
     }
+    else {
+        if (!deviceAdapter.connect("COM4", 460800)) {
+            std::cerr << "Failed to connect device on COM4\n";
+        }
 
-    std::thread deviceThread([&]() {
-        using clock = std::chrono::steady_clock;
+        deviceThread = std::thread([&]() {
+            using clock = std::chrono::steady_clock;
+            trace::setThreadName("device");
 
-        constexpr auto targetPeriod = std::chrono::microseconds(1000); // 1 kHz
-        auto nextWake = clock::now();
+            constexpr auto targetPeriod = std::chrono::microseconds(1000); // 1 kHz
+            auto nextWake = clock::now();
 
-        while (appRunning.load(std::memory_order_relaxed)) {
-            auto now = clock::now();
+            while (appRunning.load(std::memory_order_relaxed)) {
+                auto now = clock::now();
 
-            deviceAdapter.update(
-                std::chrono::duration<double>(now.time_since_epoch()).count()
-            );
+                deviceAdapter.update(
+                    std::chrono::duration<double>(now.time_since_epoch()).count()
+                );
 
-            nextWake += targetPeriod;
-            std::this_thread::sleep_until(nextWake);
-        }
-    });
+                nextWake += targetPeriod;
+                std::this_thread::sleep_until(nextWake);
+            }
+        });
+    }
 
     std::thread logThread([&]() {
+        trace::setThreadName("log");
+        auto lastFlush = std::chrono::steady_clock::now();
+
         while (logRunning.load(std::memory_order_relaxed) ||
             timingLog.size() > 0 ||
             stateLog.size() > 0 ||
             simLog.size() > 0) {
 
-            bool gotAny = false;
-
-            DeviceTimingLogMsg timingMsg;
-            while (timingLog.tryConsume(timingMsg)) {
-                timingLogs.push_back(timingMsg);
-                gotAny = true;
+            // One acquire/release per ring per wake, messages copied out in place
+            if (!flightRecorder) {
+                timingLog.consumeUpTo(timingLog.capacity(), [&](const DeviceTimingLogMsg& m) {
+                    timingSink.append(m);
+                });
+                stateLog.consumeUpTo(stateLog.capacity(), [&](const DeviceStateLogMsg& m) {
+                    stateSink.append(m);
+                });
+                simLog.consumeUpTo(simLog.capacity(), [&](const SimulationValidationLogMsg& m) {
+                    simSink.append(m);
+                });
             }
-
-            DeviceStateLogMsg stateMsg;
-            while (stateLog.tryConsume(stateMsg)) {
-                stateLogs.push_back(stateMsg);
-                gotAny = true;
+            else {
+                // Check each record first so a trigger's own record is inside its window
+                const uint64_t nowNs = static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch()).count());
+                auto feed = [&](auto& recorder, const auto& m) {
+                    if (const char* why = flightTriggers.check(m))
+                        flight.trigger(why, nowNs);
+                    recorder.push(m, nowNs);
+                };
+
+                timingLog.consumeUpTo(timingLog.capacity(), [&](const DeviceTimingLogMsg& m) {
+                    feed(timingFlight, m);
+                });
+                stateLog.consumeUpTo(stateLog.capacity(), [&](const DeviceStateLogMsg& m) {
+                    feed(stateFlight, m);
+                });
+                simLog.consumeUpTo(simLog.capacity(), [&](const SimulationValidationLogMsg& m) {
+                    feed(simFlight, m);
+                });
             }
 
-            SimulationValidationLogMsg simMsg;
-            while (simLog.tryConsume(simMsg)) {
-                simLogs.push_back(simMsg);
-                gotAny = true;
+            // Already crash-safe once appended; this only bounds loss on power failure
+            const auto now = std::chrono::steady_clock::now();
+            if (now - lastFlush > std::chrono::seconds(1)) {
+                timingSink.flush();
+                stateSink.flush();
+                simSink.flush();
+                lastFlush = now;
             }
 
-            if (!gotAny) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(1));
-            }
+            // Timeout only bounds how long shutdown takes to be noticed
+            logSelect.wait(std::chrono::milliseconds(100));
         }
     });
 
     // ------------------------------------------------------------
-    // Render loop (main thread)
+    // Render loop (main thread), or shared-memory export when headless
     // ------------------------------------------------------------
-    while (win.isOpen()) {
-        renderer.render();
+    if (!headless) {
+        while (win->isOpen()) {
+            renderer->render();
+        }
+    }
+    else {
+        std::atomic<bool> exportRunning{true};
+
+        std::thread exportThread([&]() {
+            trace::setThreadName("shm export");
+            while (exportRunning.load(std::memory_order_relaxed)) {
+                if (!exporter->pump())
+                    exporter->waitFor(std::chrono::milliseconds(1));
+            }
+        });
+
+        std::cout << "Headless: start the renderer process, press Enter to quit\n";
+        std::string line;
+        std::getline(std::cin, line);
+
+        exportRunning.store(false, std::memory_order_relaxed);
+        exportThread.join();
     }
 
     // ------------------------------------------------------------
@@ -254,82 +588,35 @@ int main() {
         logThread.join();
     }
 
-    // ------------------------------------------------------------
-    // Write timing CSV after logger has finished
-    // ------------------------------------------------------------
-    {
-        std::ofstream csv("device_timing.csv");
-        csv << "rx_state_seq,state_mcu_us,tx_cmd_seq,ref_state_seq,"
-            "t_rx_parse_ns,t_tool_publish_ns,t_wrench_consume_ns,"
-            "t_tx_start_ns,t_tx_done_ns,q1,q2,fx,fy,tau1_raw,tau1,tau2_raw,tau2,host_sat1,host_sat2\n";
-
-        for (const auto& x : timingLogs) {
-            csv << x.rx_state_seq << ","
-                << x.state_mcu_us << ","
-                << x.tx_cmd_seq << ","
-                << x.ref_state_seq << ","
-                << x.t_rx_parse_ns << ","
-                << x.t_tool_publish_ns << ","
-                << x.t_wrench_consume_ns << ","
-                << x.t_tx_start_ns << ","
-                << x.t_tx_done_ns << ","
-                << x.q1 << ","
-                << x.q2 << ","
-                << x.fx << ","
-                << x.fy << ","
-                << x.tau1_raw << ","
-                << x.tau1 << ","
-                << x.tau2_raw << ","
-                << x.tau2 << ","
-                << static_cast<int>(x.host_sat1) << ","
-                << static_cast<int>(x.host_sat2) << "\n";
-        }
+    recorder.stop();
+
+    if (telemetryOut.isRunning()) {
+        telemetryOut.stop();
+        std::cout << "Telemetry: " << telemetryOut.recordsSent() << " messages in "
+                  << telemetryOut.datagramsSent() << " datagrams\n";
     }
 
-    {
-        std::ofstream csv("device_state_log.csv");
-        csv << "t_chunk_read_ns,t_rx_parse_ns,rx_state_seq,state_mcu_us,q1,q2,applied_tau1,applied_tau2,watchdog_active,sat1,sat2\n";
-        for (const auto& x : stateLogs) {
-            csv << x.t_chunk_read_ns << ","
-                << x.t_rx_parse_ns << ","
-                << x.rx_state_seq << ","
-                << x.state_mcu_us << ","
-                << x.q1 << ","
-                << x.q2 << ","
-                << x.applied_tau1 << ","
-                << x.applied_tau2 << ","
-                << static_cast<int>(x.watchdog_active) << ","
-                << static_cast<int>(x.sat1) << ","
-                << static_cast<int>(x.sat2) << "\n";
-        }
+    if (!tracePath.empty()) {
+        trace::disable();
+        trace::writeChromeJson(tracePath);
     }
 
-    {
-        std::ofstream csv("simulation_validation_log.csv");
-        csv << "t_sec,device_x,device_y,device_z,"
-            "proxy_x,proxy_y,proxy_z,"
-            "force_x,force_y,force_z,"
-            "normal_x,normal_y,normal_z,"
-            "penetration_depth_m,signed_phi_m,contact_active\n";
-        for (const auto& x : simLogs) {
-            csv << x.t_sec << ","
-                << x.device_x << ","
-                << x.device_y << ","
-                << x.device_z << ","
-                << x.proxy_x << ","
-                << x.proxy_y << ","
-                << x.proxy_z << ","
-                << x.force_x << ","
-                << x.force_y << ","
-                << x.force_z << ","
-                << x.normal_x << ","
-                << x.normal_y << ","
-                << x.normal_z << ","
-                << x.penetration_depth_m << ","
-                << x.signed_phi_m << ","
-                << x.contact_active << "\n";
-        }
+    // ------------------------------------------------------------
+    // Seal the segment logs (trims the last segment to its contents)
+    // ------------------------------------------------------------
+    std::cout << "Logged " << timingSink.recordsWritten() << " timing, "
+              << stateSink.recordsWritten() << " state and "
+              << simSink.recordsWritten() << " simulation records to " << logDir
+              << " (CSV: log_export " << logDir << ")\n";
+
+    if (flightRecorder) {
+        std::cout << "Flight recorder: " << flight.triggers() << " triggers, "
+                  << flight.windows() << " windows written\n";
     }
 
+    timingSink.close();
+    stateSink.close();
+    simSink.close();
+
     return 0;
 }
\ No newline at end of file
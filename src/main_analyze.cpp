@@ -0,0 +1,208 @@
+#include "analysis/CsvTable.h"
+#include "analysis/Reports.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ------------------------------------------------------------
+// analyze [options] <data dir> [out dir]
+//
+// Native replacement for the MATLAB scripts in Test Data/. Reads the CSVs that
+// log_export / serial_tests write and produces the same summaries:
+//   device_timing.csv + device_state_log.csv
+//       -> device_timing_summary.csv, device_state_summary.csv, latency_cdf.csv   (End_to_End.m)
+//       -> results_combined_summary.txt, slew_histogram.csv   (device_safety_validation_analysis.m)
+//   simulation_validation_log.csv -> console                  (simulation_validation_analysis.m)
+//   rate_<N>hz.csv / rtt_<N>ms.csv
+//       -> rate_summary.csv, rtt_summary.csv, *_cdf.csv       (CommAnalysis.m)
+//
+// Each report runs if its inputs are in <data dir>. Files are parsed by
+// several threads each, and the reports run concurrently; console output is
+// printed per report, in the order above.
+// ------------------------------------------------------------
+
+namespace {
+
+namespace fs = std::filesystem;
+
+void printUsage() {
+    std::cerr << "usage: analyze [options] <data dir> [out dir]\n"
+              << "  --prefix <name>    read <name>_device_timing.csv etc. (archived runs)\n"
+              << "  --ignore <s>       skip the first s seconds (safety and simulation reports)\n"
+              << "  --hold <t0> <t1>   hold region for the simulation force statistics (s)\n"
+              << "  --torque-cap <Nm>  firmware torque cap (default 6.5)\n"
+              << "  --slew-limit <Nm/s> firmware torque slew limit (default 55)\n"
+              << "  --threads <n>      parser threads per file (default: all cores)\n";
+}
+
+bool parseNumber(const char* s, double& out) {
+    char* end = nullptr;
+    out = std::strtod(s, &end);
+    return end != s && *end == '\0';
+}
+
+// rate_<N>hz.csv / rtt_<N>ms.csv in dir
+std::vector<std::string> listMatching(const std::string& dir, const char* prefix, const char* suffix) {
+    std::vector<std::string> files;
+    std::error_code ec;
+    for (const auto& e : fs::directory_iterator(dir, ec)) {
+        const std::string name = e.path().filename().string();
+        const std::size_t pl = std::strlen(prefix), sl = std::strlen(suffix);
+        if (name.size() > pl + sl && name.compare(0, pl, prefix) == 0 &&
+            name.compare(name.size() - sl, sl, suffix) == 0 &&
+            std::isdigit(static_cast<unsigned char>(name[pl])))
+            files.push_back(e.path().string());
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string prefix;
+    analysis::SafetyConfig safety;
+    analysis::SimConfig sim;
+    unsigned threads = 0;
+    std::vector<std::string> positional;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        const bool hasArg = i + 1 < argc;
+        double v = 0;
+
+        if (a == "--prefix" && hasArg) {
+            prefix = std::string(argv[++i]) + "_";
+        } else if (a == "--ignore" && hasArg && parseNumber(argv[i + 1], v)) {
+            safety.ignoreStartS = sim.ignoreStartS = v;
+            ++i;
+        } else if (a == "--hold" && i + 2 < argc && parseNumber(argv[i + 1], sim.holdStartS) &&
+                   parseNumber(argv[i + 2], sim.holdEndS)) {
+            i += 2;
+        } else if (a == "--torque-cap" && hasArg && parseNumber(argv[i + 1], safety.torqueCapNm)) {
+            ++i;
+        } else if (a == "--slew-limit" && hasArg && parseNumber(argv[i + 1], safety.slewLimitNmPerS)) {
+            ++i;
+        } else if (a == "--threads" && hasArg && parseNumber(argv[i + 1], v) && v >= 1) {
+            threads = static_cast<unsigned>(v);
+            ++i;
+        } else if (!a.empty() && a[0] == '-') {
+            printUsage();
+            return 1;
+        } else {
+            positional.push_back(a);
+        }
+    }
+
+    if (positional.empty() || positional.size() > 2) {
+        printUsage();
+        return 1;
+    }
+    const std::string dataDir = positional[0];
+    const std::string outDir = positional.size() > 1 ? positional[1] : dataDir;
+
+    std::error_code ec;
+    fs::create_directories(outDir, ec);
+
+    const auto t0 = std::chrono::steady_clock::now();
+
+    const auto input = [&](const char* name) { return (fs::path(dataDir) / (prefix + name)).string(); };
+    const std::string timingPath = input("device_timing.csv");
+    const std::string statePath  = input("device_state_log.csv");
+    const std::string simPath    = input("simulation_validation_log.csv");
+
+    // Load everything up front, concurrently
+    const auto loadAsync = [&](const std::string& path) {
+        return std::async(std::launch::async, [path, threads] {
+            analysis::CsvTable t;
+            if (fs::exists(path) && !t.load(path, threads))
+                std::cerr << "analyze: skipping " << path << "\n";
+            return t;
+        });
+    };
+    auto timingJob = loadAsync(timingPath);
+    auto stateJob  = loadAsync(statePath);
+    auto simJob    = loadAsync(simPath);
+
+    const analysis::CsvTable timing = timingJob.get();
+    const analysis::CsvTable state  = stateJob.get();
+    const analysis::CsvTable simLog = simJob.get();
+
+    const auto loaded = std::chrono::steady_clock::now();
+
+    // One task per report, each writing into its own buffer
+    struct Task {
+        std::string                title;
+        std::ostringstream         text;
+        std::future<bool>          result;
+    };
+    std::vector<std::unique_ptr<Task>> tasks;
+    const auto launch = [&](const char* title, auto fn) {
+        auto task = std::make_unique<Task>();
+        task->title = title;
+        std::ostream& os = task->text;
+        task->result = std::async(std::launch::async, [fn, &os] { return fn(os); });
+        tasks.push_back(std::move(task));
+    };
+
+    const bool haveSession = !timing.names().empty() && !state.names().empty();
+    if (haveSession) {
+        launch("End-to-end timing", [&](std::ostream& os) {
+            return analysis::timingReport(timing, state, outDir, os);
+        });
+        // Logs from before the torque/safety fields were added only get timing
+        if (timing.has("tau1_raw") && state.has("applied_tau1")) {
+            launch("Device safety", [&](std::ostream& os) {
+                return analysis::safetyReport(timing, state, safety, outDir, os);
+            });
+        } else {
+            std::cout << "analyze: " << timingPath << " has no torque/safety columns; skipping the safety report\n";
+        }
+    }
+    if (!simLog.names().empty()) {
+        launch("Simulation validation", [&](std::ostream& os) {
+            return analysis::simReport(simLog, sim, os);
+        });
+    }
+
+    const std::vector<std::string> rateFiles = listMatching(dataDir, "rate_", "hz.csv");
+    const std::vector<std::string> rttFiles = listMatching(dataDir, "rtt_", "ms.csv");
+    if (!rateFiles.empty() || !rttFiles.empty()) {
+        launch("Serial communication", [&](std::ostream& os) {
+            return analysis::commReport(rateFiles, rttFiles, outDir, os);
+        });
+    }
+
+    if (tasks.empty()) {
+        std::cerr << "analyze: nothing to do in " << dataDir << " (expected "
+                  << prefix << "device_timing.csv + " << prefix << "device_state_log.csv, "
+                  << prefix << "simulation_validation_log.csv, rate_*hz.csv or rtt_*ms.csv)\n";
+        return 1;
+    }
+
+    int failed = 0;
+    for (auto& t : tasks) {
+        const bool ok = t->result.get();
+        std::cout << "\n#### " << t->title << " ####\n" << t->text.str();
+        if (!ok) {
+            std::cerr << "analyze: " << t->title << " report failed\n";
+            ++failed;
+        }
+    }
+
+    const auto done = std::chrono::steady_clock::now();
+    using ms = std::chrono::duration<double, std::milli>;
+    std::cout << "\nanalyze: loaded in " << ms(loaded - t0).count() << " ms, analysed in "
+              << ms(done - loaded).count() << " ms\n";
+    return failed ? 1 : 0;
+}
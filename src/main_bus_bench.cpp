@@ -0,0 +1,192 @@
+#include "messaging/Channel.h"
+#include "messaging/MpscChannel.h"
+#include "data/Commands.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+// ------------------------------------------------------------
+// Utility
+// ------------------------------------------------------------
+
+uint64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        Clock::now().time_since_epoch()).count();
+}
+
+double mean(const std::vector<double>& v) {
+    if (v.empty()) return 0.0;
+    double s = std::accumulate(v.begin(), v.end(), 0.0);
+    return s / static_cast<double>(v.size());
+}
+
+double percentile(std::vector<double> v, double p) {
+    if (v.empty()) return 0.0;
+    if (p <= 0.0) return *std::min_element(v.begin(), v.end());
+    if (p >= 100.0) return *std::max_element(v.begin(), v.end());
+
+    std::sort(v.begin(), v.end());
+    double pos = (p / 100.0) * static_cast<double>(v.size() - 1);
+    size_t idx = static_cast<size_t>(std::floor(pos));
+    double frac = pos - static_cast<double>(idx);
+
+    if (idx + 1 < v.size()) {
+        return v[idx] * (1.0 - frac) + v[idx + 1] * frac;
+    }
+    return v[idx];
+}
+
+void printUsage() {
+    std::cout << "\nUsage:\n"
+              << "  bus_bench [duration_sec] [producers] [drain_period_us]\n\n"
+              << "Example:\n"
+              << "  bus_bench 5 4 1000\n\n";
+}
+
+WorldCommand makeEdit(uint32_t producer, uint32_t n) {
+    EditObjectCommand cmd;
+    cmd.id = producer + 1;
+    cmd.newPose.p = {0.001 * n, 0.0, 0.0};
+    cmd.newColour = {0.5f, 0.5f, 0.5f};
+    return WorldCommand{cmd};
+}
+
+// ------------------------------------------------------------
+// Benchmark: N producers spam EditObjectCommand, one consumer drains
+// on a fixed period (like WorldManager::step) and times each drain.
+// ------------------------------------------------------------
+
+struct BenchResult {
+    uint64_t published = 0;
+    uint64_t dropped = 0;
+    uint64_t consumed = 0;
+    std::vector<double> drainNs;       // time for one whole drain
+    std::vector<double> perMessageNs;  // drain time / messages in that drain
+};
+
+template<typename PublishFn, typename DrainFn>
+BenchResult runBench(int durationSec, int producers, int drainPeriodUs,
+                     PublishFn publish, DrainFn drain)
+{
+    BenchResult r;
+    std::atomic<bool> running{true};
+    std::atomic<uint64_t> published{0};
+    std::atomic<uint64_t> dropped{0};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p]() {
+            uint64_t ok = 0, fail = 0;
+            uint32_t n = 0;
+            while (running.load(std::memory_order_relaxed)) {
+                if (publish(makeEdit(static_cast<uint32_t>(p), n++))) ++ok;
+                else ++fail;
+            }
+            published += ok;
+            dropped += fail;
+        });
+    }
+
+    const uint64_t endNs = nowNs() + static_cast<uint64_t>(durationSec) * 1000000000ULL;
+    auto nextWake = Clock::now();
+
+    while (nowNs() < endNs) {
+        uint64_t t0 = nowNs();
+        size_t n = drain();
+        uint64_t t1 = nowNs();
+
+        if (n > 0) {
+            r.consumed += n;
+            r.drainNs.push_back(static_cast<double>(t1 - t0));
+            r.perMessageNs.push_back(static_cast<double>(t1 - t0) / static_cast<double>(n));
+        }
+
+        nextWake += std::chrono::microseconds(drainPeriodUs);
+        std::this_thread::sleep_until(nextWake);
+    }
+
+    running.store(false);
+    for (auto& t : threads) t.join();
+
+    r.consumed += drain();
+    r.published = published.load();
+    r.dropped = dropped.load();
+    return r;
+}
+
+void printResult(const std::string& name, const BenchResult& r, int durationSec) {
+    std::cout << "\n=== " << name << " ===\n";
+    std::cout << "Published:              " << r.published << "\n";
+    std::cout << "Dropped (full):         " << r.dropped << "\n";
+    std::cout << "Consumed:               " << r.consumed << "\n";
+    std::cout << "Publish rate (msg/s):   " << (r.published / static_cast<double>(durationSec)) << "\n";
+    std::cout << "Drains:                 " << r.drainNs.size() << "\n";
+    std::cout << "Mean drain (us):        " << mean(r.drainNs) / 1e3 << "\n";
+    std::cout << "p50 drain (us):         " << percentile(r.drainNs, 50.0) / 1e3 << "\n";
+    std::cout << "p99 drain (us):         " << percentile(r.drainNs, 99.0) / 1e3 << "\n";
+    std::cout << "Max drain (us):         " << percentile(r.drainNs, 100.0) / 1e3 << "\n";
+    std::cout << "Mean per message (ns):  " << mean(r.perMessageNs) << "\n";
+    std::cout << "p99 per message (ns):   " << percentile(r.perMessageNs, 99.0) << "\n";
+}
+
+// ------------------------------------------------------------
+// Main
+// ------------------------------------------------------------
+
+int main(int argc, char* argv[]) {
+    int durationSec = 5;
+    int producers = 4;
+    int drainPeriodUs = 1000;
+
+    try {
+        if (argc > 1) durationSec = std::stoi(argv[1]);
+        if (argc > 2) producers = std::stoi(argv[2]);
+        if (argc > 3) drainPeriodUs = std::stoi(argv[3]);
+    } catch (...) {
+        printUsage();
+        return 1;
+    }
+
+    std::cout << "Running world.commands drain benchmark: " << producers
+              << " producers, " << durationSec << " s, drain every "
+              << drainPeriodUs << " us\n";
+
+    // Mutex + std::queue channel (previous world.commands implementation)
+    {
+        msg::Channel<WorldCommand> ch;
+        std::vector<WorldCommand> batch;
+        BenchResult r = runBench(durationSec, producers, drainPeriodUs,
+            [&](WorldCommand&& c) { ch.publish(std::move(c)); return true; },
+            [&]() {
+                batch.clear();
+                ch.drain(batch);
+                return batch.size();
+            });
+        printResult("Channel<WorldCommand> (mutex)", r, durationSec);
+    }
+
+    // Lock-free bounded MPSC ring (current world.commands implementation)
+    {
+        msg::MpscChannel<WorldCommand> ch(4096);
+        uint64_t sink = 0;
+        BenchResult r = runBench(durationSec, producers, drainPeriodUs,
+            [&](WorldCommand&& c) { return ch.publish(std::move(c)); },
+            [&]() {
+                return ch.consumeAll([&](const WorldCommand& c) { sink += c.index(); });
+            });
+        printResult("MpscChannel<WorldCommand> (lock-free)", r, durationSec);
+        (void)sink;
+    }
+
+    return 0;
+}
@@ -0,0 +1,403 @@
+#include "engines/HapticScene.h"
+#include "geometry/GeometryDatabase.h"
+#include "geometry/GeometryEntry.h"
+#include "geometry/sdf/PrimitiveBatch.h"
+#include "geometry/sdf/PlaneSDF.h"
+#include "geometry/sdf/SphereSDF.h"
+#include "geometry/sdf/UnitCubeSDF.h"
+#include "geometry/sdf/UnitSphereSDF.h"
+
+#include <glm/gtc/quaternion.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// ------------------------------------------------------------
+// haptic_check [seed]
+//
+// Checks the haptic contact search against a brute-force scan through
+// SDF::queryLocal:
+//  - PrimitiveBatch with every kernel this CPU can run (scalar, SSE2, AVX2),
+//    at counts that are and aren't multiples of the lane width (padding)
+//  - HapticScene::nearest (the haptic engine's contact search: primitive
+//    batch, BVH, unbounded objects) against a scan of WorldSnapshot::objects,
+//    across object moves (BVH refit), adds / removes (rebuild) and the
+//    primitive count crossing the batch threshold
+//
+// Prints the mismatches and exits with 1 if there are any.
+// ------------------------------------------------------------
+
+// Found phi may exceed the true nearest by float rounding of world coordinates
+static constexpr double kTolerance = 1e-4; // m
+
+using Rng = std::mt19937_64;
+
+double uniform(Rng& rng, double lo, double hi) {
+    return std::uniform_real_distribution<double>(lo, hi)(rng);
+}
+
+Quat randomRotation(Rng& rng) {
+    std::normal_distribution<double> n;
+    return glm::normalize(Quat{n(rng), n(rng), n(rng), n(rng)});
+}
+
+// Signed distance in world units, the way the haptic engine computes it
+double worldPhi(const SDF& sdf, const Pose& T_ws, const Vec3& p_ws) {
+    const glm::dmat3 R = glm::mat3_cast(T_ws.q);
+    const Vec3 p_ls = glm::transpose(R) * (p_ws - T_ws.p) * (1.0 / T_ws.s);
+    return sdf.queryLocal(p_ls).phi * T_ws.s;
+}
+
+const char* isaName(PrimitiveBatch::Isa isa) {
+    switch (isa) {
+        case PrimitiveBatch::Isa::Avx2: return "avx2";
+        case PrimitiveBatch::Isa::Sse2: return "sse2";
+        case PrimitiveBatch::Isa::Scalar: return "scalar";
+    }
+    return "?";
+}
+
+struct Placed {
+    std::shared_ptr<const SDF> sdf;
+    Pose                       T_ws;
+};
+
+// Spheres, rotated cubes and a few planes inside +-extent
+std::vector<Placed> randomPrimitives(Rng& rng, std::size_t count, double extent) {
+    static const auto unitCube = std::make_shared<UnitCubeSDF>();
+    std::vector<Placed> out;
+    for (std::size_t i = 0; i < count; ++i) {
+        Placed o;
+        o.T_ws.p = {uniform(rng, -extent, extent), uniform(rng, -extent, extent), uniform(rng, -extent, extent)};
+        o.T_ws.q = randomRotation(rng);
+        o.T_ws.s = uniform(rng, 0.05, 1.0);
+        const double pick = uniform(rng, 0.0, 1.0);
+        if (pick < 0.02) {
+            const Vec3 n = glm::normalize(Vec3{uniform(rng, -1, 1), uniform(rng, -1, 1), uniform(rng, -1, 1)});
+            o.sdf = std::make_shared<PlaneSDF>(n, uniform(rng, -extent, extent));
+        } else if (pick < 0.5) {
+            o.sdf = std::make_shared<SphereSDF>(Vec3{uniform(rng, -0.5, 0.5), 0.0, 0.0}, uniform(rng, 0.05, 0.5));
+        } else {
+            o.sdf = unitCube;
+        }
+        out.push_back(o);
+    }
+    return out;
+}
+
+// A point near a random object (often inside it) or anywhere in the volume
+Vec3 randomPoint(Rng& rng, const std::vector<Placed>& objects, double extent) {
+    if (!objects.empty() && uniform(rng, 0.0, 1.0) < 0.5) {
+        const Placed& o = objects[std::uniform_int_distribution<std::size_t>(0, objects.size() - 1)(rng)];
+        const double r = o.T_ws.s;
+        return o.T_ws.p + Vec3{uniform(rng, -r, r), uniform(rng, -r, r), uniform(rng, -r, r)};
+    }
+    const double e = 1.2 * extent;
+    return {uniform(rng, -e, e), uniform(rng, -e, e), uniform(rng, -e, e)};
+}
+
+// ------------------------------------------------------------
+// PrimitiveBatch kernels vs brute force
+// ------------------------------------------------------------
+
+std::size_t checkPrimitiveBatch(Rng& rng) {
+    std::vector<PrimitiveBatch::Isa> kernels;
+    for (PrimitiveBatch::Isa isa : {PrimitiveBatch::Isa::Scalar, PrimitiveBatch::Isa::Sse2, PrimitiveBatch::Isa::Avx2})
+        if (PrimitiveBatch::supports(isa))
+            kernels.push_back(isa);
+
+    std::cout << "PrimitiveBatch kernels:";
+    for (PrimitiveBatch::Isa isa : kernels)
+        std::cout << " " << isaName(isa);
+    std::cout << " (runtime pick: " << PrimitiveBatch::isa() << ")\n";
+
+    std::size_t failures = 0;
+    PrimitiveBatch batch;
+
+    // Empty batch: nothing found
+    batch.clear();
+    batch.finish();
+    for (PrimitiveBatch::Isa isa : kernels) {
+        if (batch.nearest(Vec3{0.0}, isa).item != PrimitiveBatch::kNone) {
+            std::cout << "  " << isaName(isa) << ": empty batch returned an item\n";
+            ++failures;
+        }
+    }
+
+    constexpr int kPoints = 500;
+    for (std::size_t count : {1, 3, 7, 8, 9, 17, 100, 1001, 4099}) {
+        const double extent = 0.5 * std::cbrt(double(count)) + 1.0;
+        const std::vector<Placed> objects = randomPrimitives(rng, count, extent);
+
+        batch.clear();
+        for (uint32_t i = 0; i < objects.size(); ++i)
+            batch.add(*objects[i].sdf, objects[i].T_ws, i);
+        batch.finish();
+
+        std::size_t bad = 0;
+        for (int k = 0; k < kPoints; ++k) {
+            const Vec3 p = randomPoint(rng, objects, extent);
+            double truePhi = 1e30;
+            for (const Placed& o : objects)
+                truePhi = std::min(truePhi, worldPhi(*o.sdf, o.T_ws, p));
+
+            for (PrimitiveBatch::Isa isa : kernels) {
+                const PrimitiveBatch::Hit hit = batch.nearest(p, isa);
+                if (hit.item >= objects.size()) {
+                    if (bad++ < 5)
+                        std::cout << "  " << isaName(isa) << ", " << count << " primitives: no item\n";
+                    continue;
+                }
+                const double hitPhi = worldPhi(*objects[hit.item].sdf, objects[hit.item].T_ws, p);
+                if (hitPhi - truePhi > kTolerance || std::abs(hit.phi - hitPhi) > kTolerance) {
+                    if (bad++ < 5)
+                        std::cout << "  " << isaName(isa) << ", " << count << " primitives: item "
+                                  << hit.item << " phi " << hitPhi << " (kernel " << hit.phi
+                                  << "), nearest is " << truePhi << "\n";
+                }
+            }
+        }
+        std::cout << "  " << count << " primitives, " << kPoints << " points: "
+                  << (bad ? "FAILED" : "ok") << "\n";
+        failures += bad;
+    }
+    return failures;
+}
+
+// ------------------------------------------------------------
+// HapticScene vs a scan of the world
+// ------------------------------------------------------------
+
+// Bounded but not analytic, so it goes to the BVH like a mesh SDF
+class OpaqueSphereSDF : public SDF {
+public:
+    SDFQuery queryLocal(const Vec3& p_ls) const override {
+        SDFQuery q{};
+        const double r = glm::length(p_ls);
+        q.phi = r - 1.0;
+        q.grad = r > 1e-12 ? p_ls / r : Vec3{1, 0, 0};
+        return q;
+    }
+    Aabb localBounds() const override { return Aabb::around(Vec3{0.0}, 1.0); }
+};
+
+struct SceneGeometry {
+    GeometryDatabase db;
+    GeometryID plane = 1, sphere = 2, cube = 3, opaque = 4;
+
+    SceneGeometry() {
+        auto add = [&](GeometryID id, SurfaceType type, std::shared_ptr<const SDF> sdf) {
+            GeometryEntry e;
+            e.id = id;
+            e.type = type;
+            e.sdf = std::move(sdf);
+            db.registerGeometry(e);
+        };
+        add(plane, SurfaceType::Plane, std::make_shared<PlaneSDF>(Vec3{0, 1, 0}, 0.0));
+        add(sphere, SurfaceType::Sphere, std::make_shared<UnitSphereSDF>());
+        add(cube, SurfaceType::Cube, std::make_shared<UnitCubeSDF>());
+        add(opaque, SurfaceType::TriMesh, std::make_shared<OpaqueSphereSDF>());
+    }
+};
+
+struct SceneBuilder {
+    const SceneGeometry& geom;
+    Rng&                 rng;
+    double               extent;
+    ObjectID             nextId = 1;
+
+    // analytic: sphere or cube, otherwise the BVH-only sphere; a few tools
+    // and proxies, which the scene must skip
+    ObjectState make(bool analytic) {
+        ObjectState o;
+        o.id = nextId++;
+        o.geom = analytic ? (uniform(rng, 0, 1) < 0.5 ? geom.sphere : geom.cube) : geom.opaque;
+        o.T_ws.p = {uniform(rng, -extent, extent), uniform(rng, 0.0, extent), uniform(rng, -extent, extent)};
+        o.T_ws.q = randomRotation(rng);
+        o.T_ws.s = uniform(rng, 0.02, 0.3);
+        const double role = uniform(rng, 0, 1);
+        o.role = role < 0.01 ? Role::Tool : role < 0.02 ? Role::Proxy : Role::None;
+        return o;
+    }
+
+    ObjectState ground() {
+        ObjectState o;
+        o.id = nextId++;
+        o.geom = geom.plane;
+        o.T_ws.p = {0.0, -0.05, 0.0};
+        return o;
+    }
+};
+
+// Compare nearest() with a brute-force scan of the world at random points.
+// Within the radius the result must be the nearest object; beyond it it may
+// only be farther, never nearer than the true surface.
+std::size_t checkSceneAgainstWorld(const HapticScene& scene, const WorldSnapshot& world,
+                                   const SceneGeometry& geom, Rng& rng, int points,
+                                   const char* stage)
+{
+    constexpr double kRadius = 0.02; // HapticEngine::kContactSearchRadius
+
+    std::vector<Placed> touchable;
+    for (const ObjectState& o : world.objects) {
+        if (o.role == Role::Tool || o.role == Role::Proxy)
+            continue;
+        touchable.push_back({geom.db.get(o.geom).sdf, o.T_ws});
+    }
+
+    std::size_t bad = 0;
+    std::size_t inRange = 0;
+    for (int k = 0; k < points; ++k) {
+        // Mostly within a few cm of some surface, so the radius matters
+        Vec3 p = randomPoint(rng, touchable, 1.0);
+        if (!touchable.empty() && uniform(rng, 0, 1) < 0.7) {
+            const Placed& o = touchable[std::uniform_int_distribution<std::size_t>(0, touchable.size() - 1)(rng)];
+            const Vec3 dir = glm::normalize(Vec3{uniform(rng, -1, 1), uniform(rng, -1, 1), uniform(rng, -1, 1)});
+            p = o.T_ws.p + dir * (o.T_ws.s * uniform(rng, 0.3, 1.2) + uniform(rng, -0.03, 0.03));
+        }
+
+        double truePhi = 1e30;
+        ObjectID trueId = 0;
+        for (std::size_t i = 0, t = 0; i < world.objects.size(); ++i) {
+            const ObjectState& o = world.objects[i];
+            if (o.role == Role::Tool || o.role == Role::Proxy)
+                continue;
+            const double phi = worldPhi(*touchable[t++].sdf, o.T_ws, p);
+            if (phi < truePhi) {
+                truePhi = phi;
+                trueId = o.id;
+            }
+        }
+
+        const HapticScene::Nearest n = scene.nearest(p, kRadius);
+        const bool ok = truePhi <= kRadius
+            ? (n.obj && n.phi - truePhi <= kTolerance && n.phi >= truePhi - kTolerance)
+            : n.phi >= truePhi - kTolerance;
+        inRange += truePhi <= kRadius;
+        if (!ok && bad++ < 5)
+            std::cout << "    " << stage << ": found " << (n.obj ? n.obj->id : 0) << " phi " << n.phi
+                      << ", nearest is " << trueId << " phi " << truePhi << "\n";
+    }
+    if (bad)
+        std::cout << "    " << stage << ": " << bad << " of " << points << " points wrong\n";
+    return bad + (inRange == 0); // points that never hit the radius test nothing
+}
+
+// Move every object a little (same ids and order: the BVH is refit)
+void jitter(WorldSnapshot& world, const SceneGeometry& geom, Rng& rng) {
+    for (ObjectState& o : world.objects)
+        if (o.geom != geom.plane)
+            o.T_ws.p += Vec3{uniform(rng, -0.01, 0.01), uniform(rng, -0.01, 0.01), uniform(rng, -0.01, 0.01)};
+}
+
+// Remove `removed` random non-ground objects and add `added` new ones
+void addRemove(WorldSnapshot& world, SceneBuilder& build, std::size_t removed, std::size_t added, bool analytic) {
+    for (std::size_t r = 0; r < removed && world.objects.size() > 1; ++r) {
+        const std::size_t i = std::uniform_int_distribution<std::size_t>(1, world.objects.size() - 1)(build.rng);
+        world.objects.erase(world.objects.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+    for (std::size_t a = 0; a < added; ++a)
+        world.objects.push_back(build.make(analytic));
+}
+
+std::size_t checkHapticScene(Rng& rng) {
+    std::cout << "HapticScene::nearest vs world scan:\n";
+    const SceneGeometry geom;
+    std::size_t failures = 0;
+
+    for (std::size_t count : {10, 300, 2000, 20000}) {
+        SceneBuilder build{geom, rng, 0.15 * std::cbrt(double(count)) + 0.2};
+        WorldSnapshot world;
+        world.objects.push_back(build.ground());
+        for (std::size_t i = 0; i < count; ++i)
+            world.objects.push_back(build.make(uniform(rng, 0, 1) < 0.7));
+
+        HapticScene scene;
+        std::size_t bad = 0;
+        scene.prepare(world, geom.db);
+        bad += checkSceneAgainstWorld(scene, world, geom, rng, 500, "initial");
+
+        // Past the refit limit, so the periodic rebuild runs too
+        for (int step = 0; step < 105; ++step) {
+            jitter(world, geom, rng);
+            scene.prepare(world, geom.db);
+            bad += checkSceneAgainstWorld(scene, world, geom, rng, 20, "moved");
+        }
+
+        addRemove(world, build, count / 10 + 1, count / 10 + 2, true);
+        scene.prepare(world, geom.db);
+        bad += checkSceneAgainstWorld(scene, world, geom, rng, 500, "added / removed");
+
+        addRemove(world, build, count / 5 + 1, 0, true);
+        jitter(world, geom, rng);
+        scene.prepare(world, geom.db);
+        bad += checkSceneAgainstWorld(scene, world, geom, rng, 500, "removed, moved");
+
+        std::cout << "  " << count << " objects: " << (bad ? "FAILED" : "ok") << "\n";
+        failures += bad;
+    }
+
+    // Ground + 14 primitives (15: no batch), add one (16: batch), remove two
+    {
+        SceneBuilder build{geom, rng, 0.3};
+        WorldSnapshot world;
+        world.objects.push_back(build.ground());
+        for (int i = 0; i < 14; ++i) {
+            world.objects.push_back(build.make(true));
+            world.objects.back().role = Role::None;
+        }
+        world.objects.push_back(build.make(false));
+        world.objects.back().role = Role::None;
+
+        HapticScene scene;
+        std::size_t bad = 0;
+        scene.prepare(world, geom.db);
+        bad += checkSceneAgainstWorld(scene, world, geom, rng, 500, "15 primitives");
+
+        addRemove(world, build, 0, 1, true);
+        world.objects.back().role = Role::None;
+        scene.prepare(world, geom.db);
+        bad += checkSceneAgainstWorld(scene, world, geom, rng, 500, "16 primitives");
+
+        addRemove(world, build, 2, 0, true);
+        scene.prepare(world, geom.db);
+        bad += checkSceneAgainstWorld(scene, world, geom, rng, 500, "after removing two");
+
+        std::cout << "  batch threshold (15 -> 16 -> 14 primitives): " << (bad ? "FAILED" : "ok") << "\n";
+        failures += bad;
+    }
+    return failures;
+}
+
+// ------------------------------------------------------------
+// Main
+// ------------------------------------------------------------
+
+int main(int argc, char* argv[]) {
+    uint64_t seed = 1;
+    if (argc > 1) {
+        char* end = nullptr;
+        seed = std::strtoull(argv[1], &end, 10);
+        if (end == argv[1] || *end != '\0') {
+            std::cout << "\nUsage:\n  haptic_check [seed]\n\n";
+            return 1;
+        }
+    }
+    Rng rng(seed);
+
+    std::size_t failures = 0;
+    failures += checkPrimitiveBatch(rng);
+    failures += checkHapticScene(rng);
+
+    std::cout << (failures ? "FAILED: " : "All checks passed") ;
+    if (failures)
+        std::cout << failures << " mismatches";
+    std::cout << "\n";
+    return failures ? 1 : 0;
+}
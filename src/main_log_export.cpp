@@ -0,0 +1,337 @@
+#include "logging/ColumnarLog.h"
+#include "logging/Columns.h"
+#include "logging/SegmentLog.h"
+#include "logging/LogRecords.h"
+#include "data/LogMessages.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <future>
+#include <iterator>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// ------------------------------------------------------------
+// log_export <log dir> [out dir]
+// log_export --pack <log dir>
+// log_export --import <log dir> <csv file>...
+//
+// Default: converts a session's logs into the CSV files the MATLAB scripts in
+// Test Data/ read. Uses the packed <base>.col file when present, otherwise the
+// raw segments written by the app (logs/session_*).
+//
+// --pack: re-encodes the segments into the columnar format (<base>.col, see
+// logging/ColumnarLog.h), typically ~10x smaller. The segments are left in
+// place; delete them once the .col files are archived.
+//
+// --import: reads CSVs written by this tool or by older builds (the series is
+// chosen by file name suffix, e.g. "MultiDepth_device_timing.csv") into
+// <log dir>/<base>.col, so existing captures can be archived and exported
+// like new sessions. Columns are matched by name; missing ones become 0.
+//
+// Memory use does not depend on the length of the run: records stream through
+// in blocks, and CSV formatting (std::to_chars) runs on a small rolling window
+// of worker threads while the main thread writes finished blocks in order.
+// ------------------------------------------------------------
+
+namespace {
+
+constexpr std::size_t kChunkRows = logging::kColumnarBlockRows;
+
+// Next block of records from either source; 0 at the end
+template<typename T>
+class RecordSource {
+public:
+    bool open(const std::string& logDir) {
+        using Traits = logging::LogRecordTraits<T>;
+
+        if (columnar_.open(logging::columnarPath(logDir, Traits::baseName), Traits::typeName, Traits::columns)) {
+            packed_ = true;
+            return true;
+        }
+        return segments_.open(logDir, Traits::baseName, Traits::typeName);
+    }
+
+    std::size_t read(std::vector<T>& out) {
+        if (packed_)
+            return columnar_.readBlock(out);
+
+        out.resize(kChunkRows);
+        const std::size_t n = segments_.read(out.data(), out.size());
+        out.resize(n);
+        return n;
+    }
+
+    bool packed() const { return packed_; }
+    uint32_t unsealedSegments() const { return packed_ ? 0 : segments_.unsealedSegments(); }
+
+private:
+    bool                            packed_ = false;
+    logging::ColumnarLogReader<T>   columnar_;
+    logging::SegmentLogReader<T>    segments_;
+};
+
+template<typename T>
+bool exportCsv(const std::string& logDir, const std::string& outDir) {
+    using Traits = logging::LogRecordTraits<T>;
+    constexpr std::size_t colCount = std::size(Traits::columns);
+
+    RecordSource<T> source;
+    if (!source.open(logDir)) {
+        std::cout << "  " << Traits::baseName << ": no log, skipped\n";
+        return false;
+    }
+
+    const std::string outPath = outDir + "/" + Traits::csvFile;
+    std::FILE* csv = std::fopen(outPath.c_str(), "wb");
+    if (!csv) {
+        std::cerr << "Cannot write " << outPath << "\n";
+        return false;
+    }
+    std::setvbuf(csv, nullptr, _IOFBF, 1 << 20);
+
+    const std::string header = logging::csvHeader(Traits::columns, colCount) + "\n";
+    std::fwrite(header.data(), 1, header.size(), csv);
+
+    // Format blocks in parallel, write them in order
+    const std::size_t workers = std::max(2u, std::thread::hardware_concurrency());
+    std::deque<std::future<std::string>> inFlight;
+    bool ok = true;
+
+    auto writeOldest = [&] {
+        const std::string text = inFlight.front().get();
+        inFlight.pop_front();
+        ok &= std::fwrite(text.data(), 1, text.size(), csv) == text.size();
+    };
+
+    uint64_t rows = 0;
+    for (;;) {
+        std::vector<T> block;
+        const std::size_t n = source.read(block);
+        if (n == 0)
+            break;
+        rows += n;
+
+        inFlight.push_back(std::async(std::launch::async, [block = std::move(block)] {
+            std::string text;
+            logging::appendCsvRows(block.data(), block.size(), sizeof(T),
+                                   Traits::columns, colCount, text);
+            return text;
+        }));
+
+        if (inFlight.size() >= workers)
+            writeOldest();
+    }
+    while (!inFlight.empty())
+        writeOldest();
+
+    ok &= std::fclose(csv) == 0;
+    if (!ok) {
+        std::cerr << "Write failed for " << outPath << "\n";
+        return false;
+    }
+
+    std::cout << "  " << outPath << ": " << rows << " rows" << (source.packed() ? " (packed)" : "");
+    if (source.unsealedSegments() > 0)
+        std::cout << " (" << source.unsealedSegments() << " unsealed segment(s): run ended abnormally)";
+    std::cout << "\n";
+    return true;
+}
+
+template<typename T>
+bool packColumnar(const std::string& logDir) {
+    using Traits = logging::LogRecordTraits<T>;
+
+    logging::SegmentLogReader<T> reader;
+    if (!reader.open(logDir, Traits::baseName, Traits::typeName)) {
+        std::cout << "  " << Traits::baseName << ": no segments, skipped\n";
+        return false;
+    }
+
+    const std::string outPath = logging::columnarPath(logDir, Traits::baseName);
+    logging::ColumnarLog<T> out;
+    if (!out.open(outPath, Traits::typeName, Traits::columns))
+        return false;
+
+    std::vector<T> chunk(kChunkRows);
+    uint64_t rawBytes = 0;
+    while (std::size_t n = reader.read(chunk.data(), chunk.size())) {
+        if (!out.append(chunk.data(), n))
+            return false;
+        rawBytes += n * sizeof(T);
+    }
+    if (!out.close())
+        return false;
+
+    const double ratio = out.bytesWritten() > 0 ? static_cast<double>(rawBytes) / out.bytesWritten() : 0.0;
+    std::cout << "  " << outPath << ": " << out.rowsWritten() << " rows, "
+              << rawBytes / 1024 << " KB -> " << out.bytesWritten() / 1024 << " KB ("
+              << ratio << "x)\n";
+    return true;
+}
+
+bool endsWith(const std::string& s, const char* suffix) {
+    const std::size_t n = std::strlen(suffix);
+    return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+template<typename T>
+bool importCsv(const std::string& csvPath, const std::string& logDir) {
+    using Traits = logging::LogRecordTraits<T>;
+
+    std::FILE* csv = std::fopen(csvPath.c_str(), "rb");
+    if (!csv) {
+        std::cerr << "Cannot read " << csvPath << "\n";
+        return false;
+    }
+
+    logging::CsvRowReader parser(Traits::columns, std::size(Traits::columns));
+    const std::string outPath = logging::columnarPath(logDir, Traits::baseName);
+    logging::ColumnarLog<T> out;
+    bool ok = true;
+    bool haveHeader = false;
+    uint64_t lineNo = 0, badRows = 0;
+
+    std::vector<T> block;
+    block.reserve(kChunkRows);
+
+    // Read in large chunks; a line split across chunks is carried over
+    std::vector<char> buf(1 << 20);
+    std::string carry;
+    auto onLine = [&](std::string_view line) {
+        ++lineNo;
+        if (!haveHeader) {
+            if (!parser.setHeader(line)) {
+                std::cerr << csvPath << ": header has no " << Traits::typeName << " columns\n";
+                return false;
+            }
+            for (const std::string& m : parser.missingColumns())
+                std::cout << "  " << csvPath << ": no column " << m << ", stored as 0\n";
+            haveHeader = true;
+            return out.open(outPath, Traits::typeName, Traits::columns);
+        }
+        if (line.empty() || (line.size() == 1 && line[0] == '\r'))
+            return true;
+
+        T rec{};
+        if (!parser.parse(line, &rec)) {
+            if (badRows++ == 0)
+                std::cerr << csvPath << ":" << lineNo << ": malformed row skipped\n";
+            return true;
+        }
+        block.push_back(rec);
+        if (block.size() == kChunkRows) {
+            if (!out.append(block.data(), block.size()))
+                return false;
+            block.clear();
+        }
+        return true;
+    };
+
+    while (ok) {
+        const std::size_t n = std::fread(buf.data(), 1, buf.size(), csv);
+        if (n == 0)
+            break;
+
+        const char* p = buf.data();
+        const char* const end = p + n;
+        while (ok) {
+            const char* nl = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+            if (!nl) {
+                carry.append(p, end);
+                break;
+            }
+            if (carry.empty()) {
+                ok = onLine(std::string_view(p, static_cast<std::size_t>(nl - p)));
+            } else {
+                carry.append(p, nl);
+                ok = onLine(carry);
+                carry.clear();
+            }
+            p = nl + 1;
+        }
+    }
+    if (ok && !carry.empty())
+        ok = onLine(carry);
+    std::fclose(csv);
+
+    if (!ok || !haveHeader)
+        return false;
+    if (!block.empty() && !out.append(block.data(), block.size()))
+        return false;
+    if (!out.close())
+        return false;
+
+    std::cout << "  " << csvPath << " -> " << outPath << ": " << out.rowsWritten() << " rows";
+    if (badRows > 0)
+        std::cout << " (" << badRows << " malformed rows skipped)";
+    std::cout << "\n";
+    return true;
+}
+
+// Picks the record type from the CSV file name
+bool importAny(const std::string& csvPath, const std::string& logDir) {
+    using logging::LogRecordTraits;
+    if (endsWith(csvPath, LogRecordTraits<DeviceTimingLogMsg>::csvFile))
+        return importCsv<DeviceTimingLogMsg>(csvPath, logDir);
+    if (endsWith(csvPath, LogRecordTraits<DeviceStateLogMsg>::csvFile))
+        return importCsv<DeviceStateLogMsg>(csvPath, logDir);
+    if (endsWith(csvPath, LogRecordTraits<SimulationValidationLogMsg>::csvFile))
+        return importCsv<SimulationValidationLogMsg>(csvPath, logDir);
+
+    std::cerr << csvPath << ": not a device_timing.csv, device_state_log.csv or "
+                            "simulation_validation_log.csv, skipped\n";
+    return false;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc >= 3 && std::strcmp(argv[1], "--pack") == 0) {
+        const std::string logDir = argv[2];
+
+        std::cout << "Packing " << logDir << "\n";
+        bool any = false;
+        any |= packColumnar<DeviceTimingLogMsg>(logDir);
+        any |= packColumnar<DeviceStateLogMsg>(logDir);
+        any |= packColumnar<SimulationValidationLogMsg>(logDir);
+        return any ? 0 : 1;
+    }
+
+    if (argc >= 4 && std::strcmp(argv[1], "--import") == 0) {
+        const std::string logDir = argv[2];
+        std::error_code ec;
+        std::filesystem::create_directories(logDir, ec);
+
+        std::cout << "Importing into " << logDir << "\n";
+        bool all = true;
+        for (int i = 3; i < argc; ++i)
+            all &= importAny(argv[i], logDir);
+        return all ? 0 : 1;
+    }
+
+    if (argc < 2 || argv[1][0] == '-') {
+        std::cerr << "usage: log_export <log dir> [out dir]\n"
+                  << "       log_export --pack <log dir>\n"
+                  << "       log_export --import <log dir> <csv file>...\n";
+        return 1;
+    }
+
+    const std::string logDir = argv[1];
+    const std::string outDir = argc > 2 ? argv[2] : logDir;
+
+    std::cout << "Exporting " << logDir << "\n";
+    bool any = false;
+    any |= exportCsv<DeviceTimingLogMsg>(logDir, outDir);
+    any |= exportCsv<DeviceStateLogMsg>(logDir, outDir);
+    any |= exportCsv<SimulationValidationLogMsg>(logDir, outDir);
+
+    return any ? 0 : 1;
+}
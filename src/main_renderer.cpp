@@ -0,0 +1,73 @@
+// Standalone renderer process. Run the simulation with `app --headless` first;
+// this process mirrors its world / haptic snapshots over shared memory and
+// sends world commands and tool input back (see messaging/ShmBridge.h).
+
+#include "geometry/GeometryDatabase.h"
+#include "geometry/GeometryFactory.h"
+#include "platform/Window.h"
+#include "render/GlSceneRenderer.h"
+#include "render/RenderMeshRegistry.h"
+#include "messaging/MessageBus.h"
+#include "messaging/Topics.h"
+#include "messaging/ShmBridge.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+int main(int argc, char** argv) {
+    const std::string prefix = argc > 1 ? argv[1] : msg::kShmDefaultPrefix;
+
+    GeometryDatabase geomDb;
+    RenderMeshRegistry meshRegistry;
+    GeometryFactory geomFactory(geomDb, meshRegistry);
+
+    // Local copies of the exported topics; same types as in the sim process
+    msg::MessageBus bus;
+    auto& worldCmds  = bus.get<msg::topics::WorldCommands>();
+    auto& worldSnaps = bus.get<msg::topics::WorldSnapshots>();
+    auto& toolIn     = bus.get<msg::topics::HapticsToolIn>();
+    auto& hapticOut  = bus.get<msg::topics::HapticsSnapshots>();
+
+    msg::ShmImporter importer(worldSnaps, hapticOut, worldCmds, toolIn);
+
+    std::cout << "Waiting for the simulation process (app --headless)...\n";
+    while (!importer.open(prefix)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    }
+
+    Window win({});
+
+    // Same creation order as src/main.cpp, so GeometryIDs in the snapshots match
+    geomFactory.getPlane();
+    geomFactory.getSphere();
+    geomFactory.getCube();
+
+    GlSceneRenderer renderer(win, geomDb, meshRegistry, worldCmds, toolIn, hapticOut, worldSnaps);
+    renderer.setChannelStatsSource(&bus);
+
+    std::atomic<bool> running{true};
+
+    // Shared memory can't signal across processes: poll at ~2 kHz, cheap when idle
+    std::thread importThread([&]() {
+        while (running.load(std::memory_order_relaxed)) {
+            if (!importer.pump())
+                std::this_thread::sleep_for(std::chrono::microseconds(500));
+        }
+    });
+
+    while (win.isOpen()) {
+        renderer.render();
+    }
+
+    running.store(false, std::memory_order_relaxed);
+    importThread.join();
+
+    if (importer.hapticOverruns() > 0) {
+        std::cerr << "renderer: lost " << importer.hapticOverruns()
+                  << " haptic snapshots (ring overrun)\n";
+    }
+    return 0;
+}
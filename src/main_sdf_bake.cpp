@@ -0,0 +1,86 @@
+#include "geometry/sdf/BrickSDF.h"
+#include "geometry/TriMesh.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+// ------------------------------------------------------------
+// sdf_bake <mesh.obj|mesh.stl> [--voxel h] [--band n] [--threads n]
+//          [--out file.bricksdf | --cache dir]
+//
+// Bakes a triangle mesh into a sparse BrickSDF (geometry/sdf/BrickSDF.h)
+// ahead of time, for meshes that take minutes to bake. By default the file
+// goes where `app --mesh <mesh> --mesh-voxel <h>` looks for it
+// (cache/sdf/<key>.bricksdf), so the app opens it instead of baking; with
+// --out it can be passed to --mesh directly, without the mesh (not drawn).
+//
+// --voxel is in mesh units (default: longest side / 1024); --band is the
+// depth, in voxels, up to which distances are exact (default 4).
+// ------------------------------------------------------------
+
+int main(int argc, char** argv) {
+    std::string meshPath;
+    std::string outPath;
+    std::string cacheDir = "cache/sdf";
+    BrickSDFConfig cfg;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--voxel" && i + 1 < argc) {
+            char* end = nullptr;
+            cfg.voxel = std::strtod(argv[++i], &end);
+            if (end == argv[i] || *end != '\0' || !std::isfinite(cfg.voxel) || cfg.voxel < 0.0) {
+                std::cerr << "sdf_bake: --voxel expects a number >= 0, got " << argv[i] << "\n";
+                return 2;
+            }
+        }
+        else if (arg == "--band" && i + 1 < argc)
+            cfg.bandVoxels = static_cast<uint32_t>(std::atoi(argv[++i]));
+        else if (arg == "--threads" && i + 1 < argc)
+            cfg.threads = static_cast<uint32_t>(std::atoi(argv[++i]));
+        else if (arg == "--out" && i + 1 < argc)
+            outPath = argv[++i];
+        else if (arg == "--cache" && i + 1 < argc)
+            cacheDir = argv[++i];
+        else if (meshPath.empty() && arg[0] != '-')
+            meshPath = arg;
+        else {
+            std::cerr << "sdf_bake: unknown argument " << arg << "\n";
+            return 2;
+        }
+    }
+    if (meshPath.empty()) {
+        std::cerr << "usage: sdf_bake <mesh.obj|mesh.stl> [--voxel h] [--band n] [--threads n] "
+                     "[--out file.bricksdf | --cache dir]\n";
+        return 2;
+    }
+
+    TriMesh mesh;
+    if (!loadTriMesh(meshPath, mesh))
+        return 1;
+
+    if (outPath.empty()) {
+        std::error_code ec;
+        std::filesystem::create_directories(cacheDir, ec);
+        outPath = BrickSDF::cachePath(mesh, cfg, cacheDir);
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+    if (!BrickSDF::bake(mesh, cfg, outPath))
+        return 1;
+    const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    BrickCacheConfig noPool;
+    noPool.residentBytes = 0;
+    std::shared_ptr<BrickSDF> sdf = BrickSDF::open(outPath, noPool);
+    if (!sdf)
+        return 1;
+    std::cout << meshPath << ": " << mesh.triangleCount() << " triangles, voxel " << sdf->voxel()
+              << ", " << sdf->nodeCount() << " nodes, " << sdf->brickCount() << " bricks, "
+              << std::filesystem::file_size(outPath) / (1024 * 1024) << " MiB in " << s << " s\n"
+              << "  -> " << outPath << "\n";
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include "messaging/TelemetryWire.h"
+#include "messaging/UdpSocket.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <string>
+
+// ------------------------------------------------------------
+// telemetry_recv [port] [seconds]
+//
+// Reference receiver for `app --telemetry`: listens on 127.0.0.1:<port>
+// (default 47800) and prints, once a second, each stream's message rate,
+// datagram rate, bandwidth and lost datagrams. Runs until killed, or for
+// <seconds> if given. Decoding the records themselves is left to the
+// plotting tool: they are the raw structs from data/*.h.
+// ------------------------------------------------------------
+
+namespace {
+
+struct StreamStats {
+    std::string name;
+    uint32_t    decimation = 0;
+    uint32_t    nextSeq = 0;
+    bool        seenAny = false;
+
+    uint64_t records = 0;
+    uint64_t datagrams = 0;
+    uint64_t bytes = 0;
+    uint64_t lost = 0;
+    uint64_t totalRecords = 0;
+    uint64_t totalLost = 0;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const uint16_t port = argc > 1 ? static_cast<uint16_t>(std::atoi(argv[1])) : msg::kTelemetryDefaultPort;
+    const double seconds = argc > 2 ? std::atof(argv[2]) : 0.0;
+
+    msg::UdpSocket sock;
+    if (!sock.bind("127.0.0.1", port))
+        return 1;
+    std::cout << "Listening on 127.0.0.1:" << port << "\n";
+
+    using clock = std::chrono::steady_clock;
+    const auto start = clock::now();
+    auto nextReport = start + std::chrono::seconds(1);
+
+    std::map<uint16_t, StreamStats> streams;
+    uint64_t malformed = 0;
+    uint8_t buf[65536];
+
+    for (;;) {
+        const int n = sock.receive(buf, sizeof(buf), 100);
+        if (n < 0) {
+            std::cerr << "telemetry_recv: receive failed\n";
+            return 1;
+        }
+
+        msg::TelemetryDatagramHeader h{};
+        if (n >= static_cast<int>(sizeof(h))) {
+            std::memcpy(&h, buf, sizeof(h));
+            const std::size_t body = static_cast<std::size_t>(n) - sizeof(h);
+            if (std::memcmp(h.magic, msg::kTelemetryMagic, sizeof(h.magic)) != 0 ||
+                h.version != msg::kTelemetryVersion ||
+                body != std::size_t(h.count) * h.elemSize) {
+                ++malformed;
+            } else if (h.stream == msg::kTelemetrySchemaStream) {
+                for (uint16_t i = 0; i < h.count && h.elemSize == sizeof(msg::TelemetryStreamEntry); ++i) {
+                    msg::TelemetryStreamEntry e{};
+                    std::memcpy(&e, buf + sizeof(h) + i * sizeof(e), sizeof(e));
+                    e.name[sizeof(e.name) - 1] = '\0';
+                    streams[e.id].name = e.name;
+                    streams[e.id].decimation = e.decimation;
+                }
+            } else {
+                StreamStats& s = streams[h.stream];
+                if (s.seenAny && h.seq > s.nextSeq)
+                    s.lost += h.seq - s.nextSeq;
+                s.seenAny = true;
+                s.nextSeq = h.seq + 1;
+                s.records += h.count;
+                s.datagrams += 1;
+                s.bytes += static_cast<uint64_t>(n);
+            }
+        } else if (n > 0) {
+            ++malformed;
+        }
+
+        const auto now = clock::now();
+        if (now < nextReport)
+            continue;
+
+        const double dt = std::chrono::duration<double>(now - nextReport + std::chrono::seconds(1)).count();
+        nextReport = now + std::chrono::seconds(1);
+
+        std::printf("\n%-26s %5s %10s %9s %9s %8s %10s\n",
+                    "stream", "decim", "msg/s", "dgram/s", "KB/s", "lost", "total msgs");
+        for (auto& [id, s] : streams) {
+            s.totalRecords += s.records;
+            s.totalLost += s.lost;
+            const std::string name = s.name.empty() ? "stream " + std::to_string(id) : s.name;
+            std::printf("%-26s %5u %10.1f %9.1f %9.1f %8llu %10llu\n",
+                        name.c_str(), s.decimation,
+                        s.records / dt, s.datagrams / dt, s.bytes / dt / 1024.0,
+                        static_cast<unsigned long long>(s.totalLost),
+                        static_cast<unsigned long long>(s.totalRecords));
+            s.records = s.datagrams = s.bytes = s.lost = 0;
+        }
+        if (malformed > 0)
+            std::printf("(%llu malformed datagrams)\n", static_cast<unsigned long long>(malformed));
+        std::fflush(stdout);
+
+        if (seconds > 0.0 && std::chrono::duration<double>(now - start).count() >= seconds)
+            break;
+    }
+    return 0;
+}
@@ -0,0 +1,198 @@
+#include "messaging/Journal.h"
+
+#include <chrono>
+#include <iostream>
+
+namespace msg {
+
+namespace {
+
+uint64_t steadyNowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Records written per wake of the writer thread
+constexpr std::size_t kWriteBatch = 1024;
+
+} // namespace
+
+// ------------------------------------------------------------
+// JournalRecorder
+// ------------------------------------------------------------
+
+JournalRecorder::JournalRecorder(std::size_t queueCapacity)
+    : queue_(queueCapacity) {}
+
+JournalRecorder::~JournalRecorder() {
+    stop();
+}
+
+bool JournalRecorder::start(const std::string& path) {
+    if (file_)
+        return false;
+
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) {
+        std::cerr << "JournalRecorder: cannot open " << path << "\n";
+        return false;
+    }
+    std::setvbuf(file_, nullptr, _IOFBF, 1 << 20);
+
+    JournalFileHeader h{};
+    std::memcpy(h.magic, kJournalMagic, sizeof(h.magic));
+    h.version = kJournalVersion;
+    h.topicCount = static_cast<uint32_t>(topics_.size());
+    std::fwrite(&h, sizeof(h), 1, file_);
+    std::fwrite(topics_.data(), sizeof(JournalTopicEntry), topics_.size(), file_);
+
+    t0Ns_ = steadyNowNs();
+    active_.store(true, std::memory_order_release);
+    writer_ = std::thread(&JournalRecorder::writerLoop, this);
+    return true;
+}
+
+void JournalRecorder::stop() {
+    if (!file_)
+        return;
+
+    active_.store(false, std::memory_order_release);
+    if (writer_.joinable())
+        writer_.join();
+
+    writeQueued(); // whatever arrived while the writer was exiting
+    std::fclose(file_);
+    file_ = nullptr;
+
+    if (dropped() > 0)
+        std::cerr << "JournalRecorder: " << dropped() << " messages dropped (writer fell behind)\n";
+}
+
+void JournalRecorder::onTap(void* ctx, const void* msg, std::size_t size) {
+    auto* tap = static_cast<TapContext*>(ctx);
+    JournalRecorder* self = tap->self;
+    if (!self->active_.load(std::memory_order_relaxed))
+        return;
+
+    JournalRecord rec;
+    rec.header.tNs = steadyNowNs() - self->t0Ns_;
+    rec.header.topic = tap->topic;
+    rec.header.size = static_cast<uint16_t>(size);
+    rec.header.reserved = 0;
+    std::memcpy(rec.payload, msg, size);
+
+    self->queue_.publish(rec); // full: counted as a drop, publisher never waits
+}
+
+void JournalRecorder::writerLoop() {
+    while (active_.load(std::memory_order_acquire)) {
+        if (writeQueued() == 0)
+            queue_.waitFor(std::chrono::milliseconds(50));
+    }
+}
+
+std::size_t JournalRecorder::writeQueued() {
+    const std::size_t n = queue_.consumeUpTo(kWriteBatch, [&](const JournalRecord& r) {
+        std::fwrite(&r.header, sizeof(r.header), 1, file_);
+        std::fwrite(r.payload, 1, r.header.size, file_);
+    });
+    written_.fetch_add(n, std::memory_order_relaxed);
+    return n;
+}
+
+// ------------------------------------------------------------
+// JournalReplayer
+// ------------------------------------------------------------
+
+JournalReplayer::~JournalReplayer() {
+    if (file_)
+        std::fclose(file_);
+}
+
+bool JournalReplayer::open(const std::string& path) {
+    if (file_) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+
+    file_ = std::fopen(path.c_str(), "rb");
+    if (!file_) {
+        std::cerr << "JournalReplayer: cannot open " << path << "\n";
+        return false;
+    }
+
+    JournalFileHeader h{};
+    if (std::fread(&h, sizeof(h), 1, file_) != 1 ||
+        std::memcmp(h.magic, kJournalMagic, sizeof(h.magic)) != 0 ||
+        h.version != kJournalVersion) {
+        std::cerr << "JournalReplayer: " << path << " is not a version "
+                  << kJournalVersion << " bus journal\n";
+        std::fclose(file_);
+        file_ = nullptr;
+        return false;
+    }
+
+    topics_.resize(h.topicCount);
+    if (std::fread(topics_.data(), sizeof(JournalTopicEntry), h.topicCount, file_) != h.topicCount) {
+        std::cerr << "JournalReplayer: truncated topic table in " << path << "\n";
+        std::fclose(file_);
+        file_ = nullptr;
+        return false;
+    }
+    return true;
+}
+
+bool JournalReplayer::checkTopic(std::size_t id, const char* name, std::size_t size) const {
+    for (const auto& t : topics_) {
+        if (t.id != id)
+            continue;
+
+        if (std::strncmp(t.name, name, sizeof(t.name)) != 0 || t.elemSize != size) {
+            std::cerr << "JournalReplayer: topic " << id << " was recorded as '" << t.name
+                      << "' (" << t.elemSize << " bytes), expected '" << name << "' ("
+                      << size << " bytes); skipped\n";
+            return false;
+        }
+        return true;
+    }
+
+    std::cerr << "JournalReplayer: journal has no '" << name << "' records\n";
+    return false;
+}
+
+std::size_t JournalReplayer::run(ReplayTiming timing, const std::atomic<bool>& running, double speed) {
+    if (!file_)
+        return 0;
+
+    using clock = std::chrono::steady_clock;
+    const auto start = clock::now();
+    std::size_t published = 0;
+
+    JournalRecordHeader rh{};
+    uint8_t payload[kJournalMaxPayload];
+
+    while (running.load(std::memory_order_relaxed)) {
+        if (std::fread(&rh, sizeof(rh), 1, file_) != 1)
+            break; // end of journal
+
+        if (rh.size > kJournalMaxPayload || std::fread(payload, 1, rh.size, file_) != rh.size) {
+            std::cerr << "JournalReplayer: corrupt record after " << published << " messages\n";
+            break;
+        }
+
+        if (rh.topic >= routes_.size() || !routes_[rh.topic])
+            continue; // recorded but not routed (e.g. outputs kept for comparison)
+
+        if (timing == ReplayTiming::Original) {
+            const auto due = start + std::chrono::nanoseconds(
+                static_cast<int64_t>(static_cast<double>(rh.tNs) / speed));
+            std::this_thread::sleep_until(due);
+        }
+
+        routes_[rh.topic](payload);
+        ++published;
+    }
+    return published;
+}
+
+} // namespace msg
@@ -0,0 +1,179 @@
+#include "messaging/SharedMemory.h"
+
+#include <cstring>
+#include <iostream>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace msg {
+
+SharedMemoryRegion::~SharedMemoryRegion() {
+    close();
+}
+
+#if defined(_WIN32)
+
+bool SharedMemoryRegion::create(const std::string& name, std::size_t bytes) {
+    close();
+
+    const std::string full = "Local\\" + name;
+    const unsigned long long size = bytes;
+
+    HANDLE h = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                  static_cast<DWORD>(size >> 32),
+                                  static_cast<DWORD>(size & 0xFFFFFFFFull),
+                                  full.c_str());
+    if (!h) {
+        std::cerr << "SharedMemory: CreateFileMapping failed for " << full
+                  << " (error " << GetLastError() << ")\n";
+        return false;
+    }
+
+    void* p = MapViewOfFile(h, FILE_MAP_ALL_ACCESS, 0, 0, bytes);
+    if (!p) {
+        std::cerr << "SharedMemory: MapViewOfFile failed for " << full << "\n";
+        CloseHandle(h);
+        return false;
+    }
+
+    // A stale mapping from a crashed run may still exist: start clean
+    std::memset(p, 0, bytes);
+
+    handle_ = h;
+    data_ = p;
+    size_ = bytes;
+    owner_ = true;
+    name_ = full;
+    return true;
+}
+
+bool SharedMemoryRegion::open(const std::string& name, std::size_t bytes) {
+    close();
+
+    const std::string full = "Local\\" + name;
+    HANDLE h = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, full.c_str());
+    if (!h) {
+        std::cerr << "SharedMemory: " << full << " does not exist (is the producer running?)\n";
+        return false;
+    }
+
+    void* p = MapViewOfFile(h, FILE_MAP_ALL_ACCESS, 0, 0, bytes);
+    if (!p) {
+        std::cerr << "SharedMemory: MapViewOfFile failed for " << full << "\n";
+        CloseHandle(h);
+        return false;
+    }
+
+    handle_ = h;
+    data_ = p;
+    size_ = bytes;
+    owner_ = false;
+    name_ = full;
+    return true;
+}
+
+void SharedMemoryRegion::close() {
+    if (data_)
+        UnmapViewOfFile(data_);
+    if (handle_)
+        CloseHandle(static_cast<HANDLE>(handle_));
+
+    data_ = nullptr;
+    handle_ = nullptr;
+    size_ = 0;
+    owner_ = false;
+    name_.clear();
+}
+
+#else
+
+bool SharedMemoryRegion::create(const std::string& name, std::size_t bytes) {
+    close();
+
+    const std::string full = "/" + name;
+    shm_unlink(full.c_str()); // drop a stale region from a crashed run
+
+    const int fd = shm_open(full.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        std::cerr << "SharedMemory: shm_open failed for " << full << "\n";
+        return false;
+    }
+
+    if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+        std::cerr << "SharedMemory: ftruncate failed for " << full << "\n";
+        ::close(fd);
+        shm_unlink(full.c_str());
+        return false;
+    }
+
+    void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd); // the mapping keeps the object alive
+    if (p == MAP_FAILED) {
+        std::cerr << "SharedMemory: mmap failed for " << full << "\n";
+        shm_unlink(full.c_str());
+        return false;
+    }
+
+    data_ = p;
+    size_ = bytes;
+    owner_ = true;
+    name_ = full;
+    return true;
+}
+
+bool SharedMemoryRegion::open(const std::string& name, std::size_t bytes) {
+    close();
+
+    const std::string full = "/" + name;
+    const int fd = shm_open(full.c_str(), O_RDWR, 0600);
+    if (fd < 0) {
+        std::cerr << "SharedMemory: " << full << " does not exist (is the producer running?)\n";
+        return false;
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < bytes) {
+        std::cerr << "SharedMemory: " << full << " is smaller than expected\n";
+        ::close(fd);
+        return false;
+    }
+
+    void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        std::cerr << "SharedMemory: mmap failed for " << full << "\n";
+        return false;
+    }
+
+    data_ = p;
+    size_ = bytes;
+    owner_ = false;
+    name_ = full;
+    return true;
+}
+
+void SharedMemoryRegion::close() {
+    if (data_)
+        munmap(data_, size_);
+    if (owner_)
+        shm_unlink(name_.c_str());
+
+    data_ = nullptr;
+    size_ = 0;
+    owner_ = false;
+    name_.clear();
+}
+
+#endif
+
+} // namespace msg
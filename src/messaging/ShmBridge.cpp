@@ -0,0 +1,127 @@
+#include "messaging/ShmBridge.h"
+
+#include <iostream>
+
+namespace msg {
+
+namespace {
+
+// Commands and tool states cross the process boundary in bursts of this size
+constexpr std::size_t kPumpBatch = 256;
+
+} // namespace
+
+// ------------------------------------------------------------
+// ShmExporter (simulation / haptics process)
+// ------------------------------------------------------------
+
+ShmExporter::ShmExporter(SnapshotChannel<WorldSnapshot>& worldSnaps,
+                         BroadcastChannel<HapticSnapshotMsg>& hapticSnaps,
+                         MpscChannel<WorldCommand>& worldCmds,
+                         Channel<ToolStateMsg>& toolIn)
+    : worldSnaps_(worldSnaps)
+    , worldCmds_(worldCmds)
+    , toolIn_(toolIn)
+    , hapticSub_(hapticSnaps.subscribe()) {}
+
+bool ShmExporter::create(const std::string& prefix) {
+    const bool ok =
+        worldRing_.create(prefix + ".world", kShmWorldSlots) &&
+        hapticRing_.create(prefix + ".haptic", kShmHapticSlots) &&
+        cmdRing_.create(prefix + ".cmds", kShmCommandSlots) &&
+        toolRing_.create(prefix + ".tool", kShmToolSlots);
+
+    if (!ok)
+        std::cerr << "ShmExporter: failed to create shared memory for '" << prefix << "'\n";
+    return ok;
+}
+
+bool ShmExporter::pump() {
+    bool moved = false;
+
+    // world.snapshots: only the newest one matters to the renderer
+    {
+        SnapshotChannel<WorldSnapshot>::ReadHandle h;
+        if (worldSnaps_.tryAcquire(h, worldVersion_)) {
+            toWire(*h, wire_);
+            worldRing_.publish(wire_);
+            moved = true;
+        }
+    }
+
+    // haptics.snapshots: forward every sample (the renderer may plot history)
+    HapticSnapshotMsg hs;
+    while (hapticSub_.tryConsume(hs)) {
+        hapticRing_.publish(hs);
+        moved = true;
+    }
+
+    // Back channel: renderer input into the local queues
+    moved |= cmdRing_.consumeUpTo(kPumpBatch, [&](const WorldCommand& c) {
+        worldCmds_.publish(c);
+    }) > 0;
+
+    moved |= toolRing_.consumeUpTo(kPumpBatch, [&](const ToolStateMsg& t) {
+        toolIn_.publish(t);
+    }) > 0;
+
+    return moved;
+}
+
+// ------------------------------------------------------------
+// ShmImporter (renderer process)
+// ------------------------------------------------------------
+
+ShmImporter::ShmImporter(SnapshotChannel<WorldSnapshot>& worldSnaps,
+                         BroadcastChannel<HapticSnapshotMsg>& hapticSnaps,
+                         MpscChannel<WorldCommand>& worldCmds,
+                         Channel<ToolStateMsg>& toolIn)
+    : worldSnaps_(worldSnaps)
+    , hapticSnaps_(hapticSnaps)
+    , worldCmds_(worldCmds)
+    , toolIn_(toolIn) {}
+
+bool ShmImporter::open(const std::string& prefix) {
+    const bool ok =
+        worldRing_.open(prefix + ".world", kShmWorldSlots) &&
+        hapticRing_.open(prefix + ".haptic", kShmHapticSlots) &&
+        cmdRing_.open(prefix + ".cmds", kShmCommandSlots) &&
+        toolRing_.open(prefix + ".tool", kShmToolSlots);
+
+    if (!ok)
+        return false;
+
+    worldReader_ = worldRing_.reader();
+    hapticReader_ = hapticRing_.reader();
+    return true;
+}
+
+bool ShmImporter::pump() {
+    bool moved = false;
+
+    if (worldReader_.tryLatest(wire_)) {
+        fromWire(wire_, snapshot_);
+        worldSnaps_.publish(snapshot_);
+        moved = true;
+    }
+
+    HapticSnapshotMsg hs;
+    while (hapticReader_.tryConsume(hs)) {
+        hapticSnaps_.publish(hs);
+        moved = true;
+    }
+
+    // Full rings drop: the sim process is not pumping, nothing to wait for
+    moved |= worldCmds_.consumeUpTo(kPumpBatch, [&](const WorldCommand& c) {
+        if (!cmdRing_.publish(c))
+            std::cerr << "ShmImporter: world.commands ring full, command dropped\n";
+    }) > 0;
+
+    moved |= toolIn_.consumeUpTo(kPumpBatch, [&](const ToolStateMsg& t) {
+        toolRing_.publish(t);
+    }) > 0;
+
+    return moved;
+}
+
+} // namespace msg
@@ -0,0 +1,164 @@
+#include "messaging/Telemetry.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace msg {
+
+namespace {
+
+uint64_t steadyNowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Records taken off the queue per pass of the sender thread
+constexpr std::size_t kDrainBatch = 1024;
+
+// How often the stream table is repeated for late receivers
+constexpr auto kSchemaInterval = std::chrono::seconds(1);
+
+TelemetryDatagramHeader makeHeader(uint16_t stream, uint32_t seq, uint16_t count, uint16_t elemSize) {
+    TelemetryDatagramHeader h{};
+    std::memcpy(h.magic, kTelemetryMagic, sizeof(h.magic));
+    h.version = kTelemetryVersion;
+    h.stream = stream;
+    h.seq = seq;
+    h.count = count;
+    h.elemSize = elemSize;
+    h.sendNs = steadyNowNs();
+    return h;
+}
+
+} // namespace
+
+TelemetryPublisher::TelemetryPublisher(std::size_t queueCapacity)
+    : queue_(queueCapacity) {}
+
+TelemetryPublisher::~TelemetryPublisher() {
+    stop();
+}
+
+bool TelemetryPublisher::start(const TelemetryConfig& cfg) {
+    if (active_.load(std::memory_order_relaxed))
+        return false;
+
+    cfg_ = cfg;
+    if (!socket_.connect(cfg_.host, cfg_.port))
+        return false;
+
+    // One datagram buffer per stream, sized to whole records
+    batches_.assign(MessageBus::kMaxTopics, Batch{});
+    const std::size_t room = cfg_.maxDatagramBytes > sizeof(TelemetryDatagramHeader)
+                                 ? cfg_.maxDatagramBytes - sizeof(TelemetryDatagramHeader)
+                                 : 0;
+    for (const auto& s : streams_) {
+        Batch& b = batches_[s.id];
+        b.elemSize = s.elemSize;
+        b.capacity = static_cast<uint16_t>(std::max<std::size_t>(1, room / s.elemSize));
+        b.buf.resize(sizeof(TelemetryDatagramHeader) + std::size_t(b.capacity) * s.elemSize);
+    }
+
+    active_.store(true, std::memory_order_release);
+    sender_ = std::thread(&TelemetryPublisher::senderLoop, this);
+    return true;
+}
+
+void TelemetryPublisher::stop() {
+    if (!active_.load(std::memory_order_relaxed) && !sender_.joinable())
+        return;
+
+    active_.store(false, std::memory_order_release);
+    if (sender_.joinable())
+        sender_.join();
+
+    while (drainQueue() > 0) {}
+    flushAll();
+    socket_.close();
+
+    if (dropped() > 0)
+        std::cerr << "Telemetry: " << dropped() << " messages dropped (sender fell behind)\n";
+}
+
+void TelemetryPublisher::onTap(void* ctx, const void* msg, std::size_t size) {
+    auto* tap = static_cast<TapContext*>(ctx);
+    TelemetryPublisher* self = tap->self;
+    if (!self->active_.load(std::memory_order_relaxed))
+        return;
+    if (tap->seen.fetch_add(1, std::memory_order_relaxed) % tap->decimation != 0)
+        return;
+
+    TelemetryRecord rec;
+    rec.stream = tap->stream;
+    rec.size = static_cast<uint16_t>(size);
+    std::memcpy(rec.payload, msg, size);
+
+    self->queue_.publish(rec); // full: counted as a drop, publisher never waits
+}
+
+void TelemetryPublisher::senderLoop() {
+    using clock = std::chrono::steady_clock;
+    auto nextFlush = clock::now() + cfg_.flushInterval;
+    auto nextSchema = clock::now();
+
+    while (active_.load(std::memory_order_acquire)) {
+        if (drainQueue() == 0)
+            queue_.waitFor(cfg_.flushInterval);
+
+        const auto now = clock::now();
+        if (now >= nextSchema) {
+            sendSchema();
+            nextSchema = now + kSchemaInterval;
+        }
+        if (now >= nextFlush) {
+            flushAll(); // bounds the latency of slow or decimated streams
+            nextFlush = now + cfg_.flushInterval;
+        }
+    }
+}
+
+std::size_t TelemetryPublisher::drainQueue() {
+    return queue_.consumeUpTo(kDrainBatch, [&](const TelemetryRecord& r) { append(r); });
+}
+
+void TelemetryPublisher::append(const TelemetryRecord& r) {
+    Batch& b = batches_[r.stream];
+    std::memcpy(b.buf.data() + sizeof(TelemetryDatagramHeader) + std::size_t(b.count) * b.elemSize,
+                r.payload, b.elemSize);
+    if (++b.count == b.capacity)
+        flush(r.stream, b);
+}
+
+void TelemetryPublisher::flush(uint16_t stream, Batch& b) {
+    if (b.count == 0)
+        return;
+
+    const TelemetryDatagramHeader h = makeHeader(stream, b.seq++, b.count, b.elemSize);
+    std::memcpy(b.buf.data(), &h, sizeof(h));
+
+    if (socket_.send(b.buf.data(), sizeof(h) + std::size_t(b.count) * b.elemSize)) {
+        recordsSent_.fetch_add(b.count, std::memory_order_relaxed);
+        datagramsSent_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        datagramsFailed_.fetch_add(1, std::memory_order_relaxed); // no receiver is not an error
+    }
+    b.count = 0;
+}
+
+void TelemetryPublisher::flushAll() {
+    for (const auto& s : streams_)
+        flush(s.id, batches_[s.id]);
+}
+
+void TelemetryPublisher::sendSchema() {
+    std::vector<uint8_t> buf(sizeof(TelemetryDatagramHeader) + streams_.size() * sizeof(TelemetryStreamEntry));
+    const TelemetryDatagramHeader h = makeHeader(kTelemetrySchemaStream, schemaSeq_++,
+                                                 static_cast<uint16_t>(streams_.size()),
+                                                 static_cast<uint16_t>(sizeof(TelemetryStreamEntry)));
+    std::memcpy(buf.data(), &h, sizeof(h));
+    if (!streams_.empty())
+        std::memcpy(buf.data() + sizeof(h), streams_.data(), streams_.size() * sizeof(TelemetryStreamEntry));
+    socket_.send(buf.data(), buf.size());
+}
+
+} // namespace msg
@@ -0,0 +1,142 @@
+#include "messaging/UdpSocket.h"
+
+#include <iostream>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace msg {
+
+namespace {
+
+#if defined(_WIN32)
+using NativeSocket = SOCKET;
+
+bool startup() {
+    static const bool ok = [] {
+        WSADATA wsa;
+        return WSAStartup(MAKEWORD(2, 2), &wsa) == 0;
+    }();
+    return ok;
+}
+
+void closeNative(NativeSocket s) { closesocket(s); }
+
+bool setNonBlocking(NativeSocket s) {
+    u_long on = 1;
+    return ioctlsocket(s, FIONBIO, &on) == 0;
+}
+#else
+using NativeSocket = int;
+
+bool startup() { return true; }
+
+void closeNative(NativeSocket s) { ::close(s); }
+
+bool setNonBlocking(NativeSocket s) {
+    const int flags = fcntl(s, F_GETFL, 0);
+    return flags >= 0 && fcntl(s, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+#endif
+
+NativeSocket native(intptr_t s) { return static_cast<NativeSocket>(s); }
+
+bool makeAddress(const std::string& host, uint16_t port, sockaddr_in& addr) {
+    addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    return inet_pton(AF_INET, host.c_str(), &addr.sin_addr) == 1;
+}
+
+} // namespace
+
+UdpSocket::~UdpSocket() {
+    close();
+}
+
+void UdpSocket::close() {
+    if (sock_ == kInvalid)
+        return;
+    closeNative(native(sock_));
+    sock_ = kInvalid;
+}
+
+bool UdpSocket::connect(const std::string& host, uint16_t port) {
+    close();
+
+    sockaddr_in addr;
+    if (!startup() || !makeAddress(host, port, addr)) {
+        std::cerr << "UdpSocket: bad address " << host << ":" << port << "\n";
+        return false;
+    }
+
+    const NativeSocket s = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    sock_ = static_cast<intptr_t>(s);
+    if (sock_ == kInvalid ||
+        ::connect(s, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        !setNonBlocking(s)) {
+        std::cerr << "UdpSocket: cannot open a socket to " << host << ":" << port << "\n";
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool UdpSocket::bind(const std::string& host, uint16_t port) {
+    close();
+
+    sockaddr_in addr;
+    if (!startup() || !makeAddress(host, port, addr)) {
+        std::cerr << "UdpSocket: bad address " << host << ":" << port << "\n";
+        return false;
+    }
+
+    const NativeSocket s = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    sock_ = static_cast<intptr_t>(s);
+    if (sock_ == kInvalid || ::bind(s, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+        std::cerr << "UdpSocket: cannot listen on " << host << ":" << port << "\n";
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool UdpSocket::send(const void* data, std::size_t bytes) {
+    if (sock_ == kInvalid)
+        return false;
+    const auto n = ::send(native(sock_), static_cast<const char*>(data), static_cast<int>(bytes), 0);
+    return n >= 0 && static_cast<std::size_t>(n) == bytes;
+}
+
+int UdpSocket::receive(void* buf, std::size_t capacity, int timeoutMs) {
+    if (sock_ == kInvalid)
+        return -1;
+
+#if defined(_WIN32)
+    WSAPOLLFD pfd{native(sock_), POLLIN, 0};
+    const int ready = WSAPoll(&pfd, 1, timeoutMs);
+#else
+    pollfd pfd{native(sock_), POLLIN, 0};
+    const int ready = ::poll(&pfd, 1, timeoutMs);
+#endif
+    if (ready <= 0)
+        return ready == 0 ? 0 : -1;
+
+    const auto n = ::recv(native(sock_), static_cast<char*>(buf), static_cast<int>(capacity), 0);
+    return n < 0 ? -1 : static_cast<int>(n);
+}
+
+} // namespace msg
@@ -0,0 +1,85 @@
+#include "messaging/WaitSignal.h"
+
+#include <climits>
+#include <thread>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <ctime>
+#endif
+
+namespace msg {
+
+namespace {
+
+// Futex-style word wait/wake on the epoch counter
+#if defined(_WIN32)
+
+void waitOnWord(std::atomic<uint32_t>& word, uint32_t seen, std::chrono::nanoseconds timeout) {
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(timeout).count();
+    if (ms <= 0) ms = 1; // WaitOnAddress has millisecond resolution; round up
+
+    WaitOnAddress(reinterpret_cast<volatile VOID*>(&word), &seen, sizeof(seen),
+                  static_cast<DWORD>(ms));
+}
+
+void wakeWord(std::atomic<uint32_t>& word) {
+    WakeByAddressAll(reinterpret_cast<PVOID>(&word));
+}
+
+#elif defined(__linux__)
+
+void waitOnWord(std::atomic<uint32_t>& word, uint32_t seen, std::chrono::nanoseconds timeout) {
+    timespec ts{};
+    ts.tv_sec  = static_cast<time_t>(timeout.count() / 1000000000LL);
+    ts.tv_nsec = static_cast<long>(timeout.count() % 1000000000LL);
+
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE,
+            seen, &ts, nullptr, 0);
+}
+
+void wakeWord(std::atomic<uint32_t>& word) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE,
+            INT_MAX, nullptr, nullptr, 0);
+}
+
+#else
+
+// No kernel wait primitive: short sleeps bounded by the timeout
+void waitOnWord(std::atomic<uint32_t>& word, uint32_t seen, std::chrono::nanoseconds timeout) {
+    const auto step = std::chrono::microseconds(100);
+    if (word.load() == seen)
+        std::this_thread::sleep_for(timeout < step ? timeout : step);
+}
+
+void wakeWord(std::atomic<uint32_t>&) {}
+
+#endif
+
+} // namespace
+
+bool WaitSignal::waitFor(uint32_t seen, std::chrono::nanoseconds timeout) const {
+    if (timeout.count() <= 0)
+        return epoch_.load(std::memory_order_seq_cst) != seen;
+
+    // Register before the final check so notify() can't miss us
+    waiters_.fetch_add(1, std::memory_order_seq_cst);
+    if (epoch_.load(std::memory_order_seq_cst) == seen)
+        waitOnWord(epoch_, seen, timeout);
+    waiters_.fetch_sub(1, std::memory_order_seq_cst);
+
+    return epoch_.load(std::memory_order_seq_cst) != seen;
+}
+
+void WaitSignal::wakeAll() {
+    wakeWord(epoch_);
+}
+
+} // namespace msg
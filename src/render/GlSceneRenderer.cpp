@@ -6,7 +6,12 @@
 #include <glm/gtc/matrix_access.hpp>
 #include "geometry/GeometryDatabase.h"
 #include "util/RobotUtils.h"
+#include "trace/Trace.h"
 #include <iostream>
+#include <chrono>
+
+// Used until the first world snapshot arrives
+static const WorldSnapshot kEmptyWorld{};
 
 // --- utils ---
 // build model matrix from Pose
@@ -31,9 +36,9 @@ GlSceneRenderer::GlSceneRenderer(
     Window& window,
     const GeometryDatabase& geomDb,
     RenderMeshRegistry& meshRegistry,
-    msg::Channel<WorldCommand>& worldCmds,
+    msg::MpscChannel<WorldCommand>& worldCmds,
     msg::Channel<ToolStateMsg>& toolState,
-    msg::Channel<HapticSnapshotMsg>& hapticSnaps,
+    msg::BroadcastChannel<HapticSnapshotMsg>& hapticSnaps,
     msg::SnapshotChannel<WorldSnapshot>& worldSnaps
 )
     : window_(window)
@@ -45,7 +50,7 @@ GlSceneRenderer::GlSceneRenderer(
     , meshRegistry_(meshRegistry)
     , worldCmds_(worldCmds)
     , toolState_(toolState)
-    , hapticSnaps_(hapticSnaps)
+    , hapticSub_(hapticSnaps.subscribe())
     , worldSnaps_(worldSnaps)
     , shader_("shaders/general.vert", "shaders/general.frag")
 {
@@ -110,6 +115,8 @@ void GlSceneRenderer::setViewProj(const glm::mat4& V, const glm::mat4& P) {
 
 
 void GlSceneRenderer::render() {
+    TRACE_SCOPE("GlSceneRenderer::render");
+
     // -- Handle resize --
     int fbw = 0, fbh = 0;
     window_.getFramebufferSize(fbw, fbh);
@@ -119,8 +126,9 @@ void GlSceneRenderer::render() {
         fbh_ = fbh;
     }
 
-    // ---- Drain latest world snapshot ----
-    worldSnaps_.tryRead(latestWorld_, worldSnapVersion_);
+    // ---- Latest world snapshot (pinned in place, no copy) ----
+    worldSnaps_.tryAcquire(latestWorld_, worldSnapVersion_);
+    const WorldSnapshot& world = latestWorld_ ? *latestWorld_ : kEmptyWorld;
 
     // basic Gl state
     glEnable(GL_DEPTH_TEST);
@@ -129,11 +137,12 @@ void GlSceneRenderer::render() {
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     
 
-    for (const ObjectState& obj : latestWorld_.objects) {
+    for (const ObjectState& obj : world.objects) {
 
         // --- Geometry lookup ---
+        // (a renderer process doesn't know geometry the app loaded from files)
+        if (!geometryDb_.contains(obj.geom)) continue;
         const GeometryEntry* geom = &geometryDb_.get(obj.geom);
-        if (!geom) continue;
 
         // --- Mesh lookup ---
         const MeshGPU* mesh = meshRegistry_.get(geom->renderMesh);
@@ -152,10 +161,7 @@ void GlSceneRenderer::render() {
         r.render(camera_, compose(obj.T_ws));
     }
 
-    HapticSnapshotMsg hs;
-    while (hapticSnaps_.tryConsume(hs)) {
-        latestHaptics_ = std::move(hs);
-    }
+    hapticSub_.tryLatest(latestHaptics_);
 
     // Need to Clean this COde Up Later
 
@@ -190,10 +196,18 @@ void GlSceneRenderer::render() {
 
 ;
     imguiLayer_.begin();
-    buildUIState(latestWorld_);
+    buildUIState(world);
     // ui_.drawBodyPanel(bodyState_);
     imguiLayer_.getFps(stats_.fps);
     ui_.drawDebugPanel(stats_);
+    if (statsBus_) {
+        refreshChannelStats();
+        ui_.drawChannelPanel(channelStats_);
+    }
+    if (latency_) {
+        refreshLatencyStats();
+        ui_.drawLatencyPanel(latencyStats_);
+    }
     ui_.drawCameraPanel(camState_);
     ui_.drawControllerPanel(ctrlState_);
     ui_.drawBodyPanel(bodyState_);
@@ -475,6 +489,13 @@ void GlSceneRenderer::initUICommands() {
     cmds.setInvertY          = [&](bool v)  { viewportCtrl_.setInvertY(v); };
     cmds.setRmbToLook        = [&](bool v)  { viewportCtrl_.setRmbToLook(v); };
 
+    // Loop latency panel
+    cmds.resetLatencyStats = [this]() {
+        if (!latency_) return;
+        latency_->reset();
+        latencyStats_.clear(); // refresh on the next frame
+    };
+
 
 
     ui_.setCommands(cmds);
@@ -604,3 +625,63 @@ void GlSceneRenderer::buildUIState(const WorldSnapshot& snapshot) {
         }
     }
 }
+
+void GlSceneRenderer::refreshChannelStats() {
+    constexpr double kRefreshSec = 0.5;
+
+    const double now = std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    const double dt = now - channelStatsT_;
+    if (!channelStats_.empty() && dt < kRefreshSec) return;
+
+    std::vector<UIChannelStats> next;
+    for (const auto& e : statsBus_->stats()) {
+        UIChannelStats row;
+        row.name          = e.name;
+        row.kind          = msg::toString(e.kind);
+        row.published     = e.stats.published;
+        row.consumed      = e.stats.consumed;
+        row.dropped       = e.stats.dropped;
+        row.depth         = e.stats.depth;
+        row.peakDepth     = e.stats.peakDepth;
+        row.meanLatencyUs = static_cast<float>(e.stats.meanLatencyUs);
+        row.maxLatencyUs  = static_cast<float>(e.stats.maxLatencyUs);
+
+        // Rates from the previous refresh (same sorted order, but match by name to be safe)
+        auto prev = std::find_if(channelStats_.begin(), channelStats_.end(),
+                                 [&](const UIChannelStats& p) { return p.name == row.name; });
+        if (prev != channelStats_.end() && dt > 0.0) {
+            row.publishRate = static_cast<float>((row.published - prev->published) / dt);
+            row.consumeRate = static_cast<float>((row.consumed - prev->consumed) / dt);
+        }
+        next.push_back(std::move(row));
+    }
+
+    channelStats_ = std::move(next);
+    channelStatsT_ = now;
+}
+
+void GlSceneRenderer::refreshLatencyStats() {
+    constexpr double kRefreshSec = 0.25;
+
+    const double now = std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    if (!latencyStats_.empty() && now - latencyStatsT_ < kRefreshSec) return;
+
+    latencyStats_.clear();
+    for (std::size_t i = 0; i < kLoopStageCount; ++i) {
+        const LoopStage stage = static_cast<LoopStage>(i);
+        const metrics::HdrHistogram::Summary s = latency_->summary(stage);
+
+        UILatencyStats row;
+        row.stage  = toString(stage);
+        row.count  = s.count;
+        row.meanUs = static_cast<float>(s.mean / 1e3);
+        row.p50Us  = static_cast<float>(s.p50 / 1e3);
+        row.p99Us  = static_cast<float>(s.p99 / 1e3);
+        row.p999Us = static_cast<float>(s.p999 / 1e3);
+        row.maxUs  = static_cast<float>(s.max / 1e3);
+        latencyStats_.push_back(row);
+    }
+    latencyStatsT_ = now;
+}
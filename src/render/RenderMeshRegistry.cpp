@@ -1,6 +1,7 @@
 #include "render/RenderMeshRegistry.h"
 #include <vector>
 #include <glm/vec3.hpp>
+#include <glm/geometric.hpp>
 #include <cmath>
 #include <glm/gtc/quaternion.hpp>  // glm::quat, normalize(quat)
 #include <iostream>
@@ -9,6 +10,9 @@
 static MeshGPU makePlaneMesh();
 static MeshGPU makeSphereMesh();
 static MeshGPU makeCubeMesh();
+static void makeInterleavedPN(const std::vector<glm::vec3>& pos,
+                              const std::vector<glm::vec3>& nrm,
+                              std::vector<float>& outPN);
 
 RenderMeshHandle RenderMeshRegistry::getOrCreate(MeshKind kind) {
     auto it = kindToHandle_.find(kind);
@@ -48,6 +52,41 @@ RenderMeshHandle RenderMeshRegistry::createMesh(MeshKind kind) {
     return handle;
 }
 
+RenderMeshHandle RenderMeshRegistry::createTriMesh(const TriMesh& tri) {
+    // Flat shaded: three vertices per triangle with the face normal
+    std::vector<glm::vec3> P;
+    std::vector<glm::vec3> N;
+    std::vector<unsigned>  I;
+    P.reserve(tri.indices.size());
+    N.reserve(tri.indices.size());
+    I.reserve(tri.indices.size());
+
+    for (size_t t = 0; t + 2 < tri.indices.size(); t += 3) {
+        const glm::vec3 a(tri.vertices[tri.indices[t]]);
+        const glm::vec3 b(tri.vertices[tri.indices[t + 1]]);
+        const glm::vec3 c(tri.vertices[tri.indices[t + 2]]);
+        glm::vec3 n = glm::cross(b - a, c - a);
+        const float len = glm::length(n);
+        n = len > 0.f ? n / len : glm::vec3(0.f, 1.f, 0.f);
+
+        for (const glm::vec3& p : {a, b, c}) {
+            I.push_back(static_cast<unsigned>(P.size()));
+            P.push_back(p);
+            N.push_back(n);
+        }
+    }
+
+    std::vector<float> PN;
+    makeInterleavedPN(P, N, PN);
+
+    MeshGPU mesh;
+    mesh.upload(PN, I);
+
+    RenderMeshHandle handle = nextHandle_++;
+    meshes_.emplace(handle, std::move(mesh));
+    return handle;
+}
+
 // ------------------------------------------------------------
 // Helpers
 // ------------------------------------------------------------
@@ -135,6 +135,82 @@ void UI::drawDebugPanel(const UISceneStats& stats) {
     ImGui::End();
 }
 
+void UI::drawChannelPanel(const std::vector<UIChannelStats>& channels) {
+    ImGui::Begin("Channels");
+    if (channels.empty()) {
+        ImGui::TextUnformatted("No channel stats (MSG_CHANNEL_METRICS off?)");
+        ImGui::End();
+        return;
+    }
+
+    const ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+                                  ImGuiTableFlags_SizingFixedFit;
+    if (ImGui::BeginTable("channel_stats", 9, flags)) {
+        ImGui::TableSetupColumn("Channel");
+        ImGui::TableSetupColumn("Kind");
+        ImGui::TableSetupColumn("Pub/s");
+        ImGui::TableSetupColumn("Con/s");
+        ImGui::TableSetupColumn("Depth");
+        ImGui::TableSetupColumn("Peak");
+        ImGui::TableSetupColumn("Dropped");
+        ImGui::TableSetupColumn("Lat mean (us)");
+        ImGui::TableSetupColumn("Lat max (us)");
+        ImGui::TableHeadersRow();
+
+        for (const auto& c : channels) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(c.name.c_str());
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(c.kind);
+            ImGui::TableNextColumn(); ImGui::Text("%.0f", c.publishRate);
+            ImGui::TableNextColumn(); ImGui::Text("%.0f", c.consumeRate);
+            ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)c.depth);
+            ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)c.peakDepth);
+            ImGui::TableNextColumn();
+            if (c.dropped > 0) ImGui::TextColored(ImVec4(1.f, 0.4f, 0.4f, 1.f), "%llu", (unsigned long long)c.dropped);
+            else               ImGui::TextUnformatted("0");
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", c.meanLatencyUs);
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", c.maxLatencyUs);
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
+
+void UI::drawLatencyPanel(const std::vector<UILatencyStats>& stages) {
+    ImGui::Begin("Loop latency");
+    if (ImGui::Button("Reset")) {
+        if (cmds_.resetLatencyStats) cmds_.resetLatencyStats();
+    }
+    ImGui::SameLine();
+    ImGui::TextDisabled("matched device cycles, since start / last reset");
+
+    const ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+                                  ImGuiTableFlags_SizingFixedFit;
+    if (ImGui::BeginTable("loop_latency", 7, flags)) {
+        ImGui::TableSetupColumn("Stage");
+        ImGui::TableSetupColumn("Samples");
+        ImGui::TableSetupColumn("Mean (us)");
+        ImGui::TableSetupColumn("p50 (us)");
+        ImGui::TableSetupColumn("p99 (us)");
+        ImGui::TableSetupColumn("p99.9 (us)");
+        ImGui::TableSetupColumn("Max (us)");
+        ImGui::TableHeadersRow();
+
+        for (const auto& s : stages) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(s.stage);
+            ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)s.count);
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", s.meanUs);
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", s.p50Us);
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", s.p99Us);
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", s.p999Us);
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", s.maxUs);
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
+
 void UI::drawControllerPanel(const UIControllerState& s)
 {
     if (ImGui::Begin("Controller")) {
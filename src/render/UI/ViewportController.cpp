@@ -26,11 +26,11 @@ All direct HapticEngine access in this file MUST be removed before final submiss
 
 ViewportController::ViewportController(Window& window, Camera& camera,            
         msg::Channel<ToolStateMsg>& toolState,
-        msg::Channel<HapticSnapshotMsg>& hapticSnaps)
+        msg::BroadcastChannel<HapticSnapshotMsg>& hapticSnaps)
     : win_(&window),
       cam_(&camera),
         toolState_(toolState),
-        hapticSnaps_(hapticSnaps)
+        hapticSub_(hapticSnaps.subscribe())
       
 {
 }
@@ -45,10 +45,7 @@ void ViewportController::update(float /*dt*/, bool uiCapturing) {
     // Get framebuffer size
     win_->getFramebufferSize(width, height);
 
-    HapticSnapshotMsg hs;
-    while (hapticSnaps_.tryConsume(hs)) {
-        latestHaptics_ = std::move(hs);
-    }
+    hapticSub_.tryLatest(latestHaptics_);
 
     ToolStateMsg ts;
     while (toolState_.tryConsume(ts)) {
@@ -0,0 +1,178 @@
+#include "trace/Trace.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace trace {
+
+namespace detail {
+
+std::atomic<bool> g_enabled{false};
+
+namespace {
+
+// One per thread that ever recorded. Owned by the registry, so a thread's
+// events can still be exported after it exits.
+struct ThreadRing {
+    std::atomic<uint64_t> head{0};   // events ever written (single writer)
+    uint32_t              tid = 0;
+    std::string           name;
+    Event                 events[kTraceRingEvents];
+};
+
+struct Registry {
+    std::mutex                               mutex;
+    std::vector<std::unique_ptr<ThreadRing>> rings;
+    uint64_t                                 t0Ns = 0;  // last enable()
+};
+
+Registry& registry() {
+    static Registry r;
+    return r;
+}
+
+thread_local ThreadRing* t_ring = nullptr;
+thread_local const char* t_name = nullptr;   // set before the ring exists
+
+// Allocates, faults in and registers the ring: done by setThreadName at
+// thread start, so only unnamed threads pay for it on their first event
+ThreadRing& threadRing() {
+    if (!t_ring) {
+        auto ring = std::make_unique<ThreadRing>();
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        ring->tid = static_cast<uint32_t>(r.rings.size() + 1);
+        if (t_name) ring->name = t_name;
+        t_ring = ring.get();
+        r.rings.push_back(std::move(ring));
+    }
+    return *t_ring;
+}
+
+// Minimal JSON string escaping for names
+void writeJsonString(std::FILE* f, const char* s) {
+    std::fputc('"', f);
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') std::fputc('\\', f);
+        if (static_cast<unsigned char>(*s) >= 0x20) std::fputc(*s, f);
+    }
+    std::fputc('"', f);
+}
+
+} // namespace
+
+void record(const Event& e) {
+    ThreadRing& ring = threadRing();
+    const uint64_t h = ring.head.load(std::memory_order_relaxed);
+    ring.events[h & (kTraceRingEvents - 1)] = e;
+    ring.head.store(h + 1, std::memory_order_release);
+}
+
+} // namespace detail
+
+void enable() {
+    detail::Registry& r = detail::registry();
+    {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.t0Ns = detail::nowNs();
+    }
+    detail::g_enabled.store(true, std::memory_order_relaxed);
+}
+
+void disable() {
+    detail::g_enabled.store(false, std::memory_order_relaxed);
+}
+
+void setThreadName(const char* name) {
+    // Create the ring here rather than on the first event, which may be
+    // inside a real-time loop
+    detail::t_name = name;
+    if (!detail::t_ring) {
+        detail::threadRing();
+        return;
+    }
+    std::lock_guard<std::mutex> lock(detail::registry().mutex);
+    detail::t_ring->name = name;
+}
+
+bool writeChromeJson(const std::string& path) {
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) {
+        std::cerr << "Trace: cannot write " << path << "\n";
+        return false;
+    }
+    std::setvbuf(f, nullptr, _IOFBF, 1 << 20);
+
+    detail::Registry& r = detail::registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", f);
+    bool first = true;
+    auto sep = [&] {
+        if (!first) std::fputs(",\n", f);
+        first = false;
+    };
+
+    std::vector<Event> copy;
+    std::size_t total = 0;
+    for (const auto& ring : r.rings) {
+        if (!ring->name.empty()) {
+            sep();
+            std::fprintf(f, "{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":",
+                         ring->tid);
+            detail::writeJsonString(f, ring->name.c_str());
+            std::fputs("}}", f);
+        }
+
+        // Copy the live window, then drop whatever the writer lapped meanwhile
+        const uint64_t before = ring->head.load(std::memory_order_acquire);
+        const uint64_t begin = before > kTraceRingEvents ? before - kTraceRingEvents : 0;
+        copy.resize(static_cast<std::size_t>(before - begin));
+        for (uint64_t i = begin; i < before; ++i)
+            copy[static_cast<std::size_t>(i - begin)] = ring->events[i & (kTraceRingEvents - 1)];
+
+        const uint64_t after = ring->head.load(std::memory_order_acquire);
+        const uint64_t safe = after + 1 > kTraceRingEvents ? after + 1 - kTraceRingEvents : 0;
+
+        for (uint64_t i = std::max(begin, safe); i < before; ++i) {
+            const Event& e = copy[static_cast<std::size_t>(i - begin)];
+            if (e.startNs < r.t0Ns)
+                continue; // recorded before the last enable()
+
+            const double tsUs = static_cast<double>(e.startNs - r.t0Ns) * 1e-3;
+            sep();
+            switch (e.type) {
+                case EventType::Span:
+                    std::fprintf(f, "{\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"name\":",
+                                 ring->tid, tsUs, static_cast<double>(e.durNs) * 1e-3);
+                    detail::writeJsonString(f, e.name);
+                    std::fputc('}', f);
+                    break;
+                case EventType::Counter:
+                    std::fprintf(f, "{\"ph\":\"C\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"name\":", ring->tid, tsUs);
+                    detail::writeJsonString(f, e.name);
+                    std::fprintf(f, ",\"args\":{\"value\":%.9g}}", e.value);
+                    break;
+                case EventType::Instant:
+                    std::fprintf(f, "{\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"name\":",
+                                 ring->tid, tsUs);
+                    detail::writeJsonString(f, e.name);
+                    std::fputc('}', f);
+                    break;
+            }
+            ++total;
+        }
+    }
+    std::fputs("\n]}\n", f);
+
+    const bool ok = std::fclose(f) == 0;
+    if (ok)
+        std::cout << "Trace: " << total << " events from " << r.rings.size() << " threads -> " << path << "\n";
+    return ok;
+}
+
+} // namespace trace
@@ -4,7 +4,7 @@
 
 WorldManager::WorldManager(const GeometryDatabase& geomDb,
                            GeometryFactory& geomFactory,
-                            msg::Channel<WorldCommand>& worldCmds
+                            msg::MpscChannel<WorldCommand>& worldCmds
                                )
     : geomDb_(geomDb),
       geomFactory_(geomFactory),
@@ -33,12 +33,8 @@ void WorldManager::apply(const WorldCommand& cmd) {
 
 void WorldManager::step(double dt) {
     //Maybe move commands to be in phsyics step
-    std::vector<WorldCommand> cmds;
-    worldCmds_.drain(cmds);
-    //std::cout << "WorldManager: Processing " << cmds.size() << " commands in step.\n";
-
-    for (const auto& cmd : cmds)
-        apply(cmd);
+    // Apply every pending command in place (one lock-free batch, no vector)
+    worldCmds_.consumeAll([this](const WorldCommand& cmd) { apply(cmd); });
 
     simTime_ += dt;
 }